@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_ATTRIBUTEHANDLE_H
+#define BK_ATTRIBUTEHANDLE_H
+
+#include <limits>
+
+namespace bk
+{
+  //! typed, stable reference to an attribute vector of a DataObject (slot of its AttributeMap)
+  /*!
+   * - resolve once, e.g. via point_attribute_handle_of_type<T>(hash), and use it for all further
+   *   accesses (no hash lookup)
+   * - valid until the attribute is removed; copies of the data object share the handles
+   * - T is the value type of the attribute (e.g. Vec3d for normals)
+   */
+  template<typename T> class AttributeHandle
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = AttributeHandle<T>;
+    public:
+      using value_type = T;
+      using handle_type = unsigned int;
+
+      static constexpr handle_type InvalidHandle = std::numeric_limits<handle_type>::max();
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      handle_type _slot;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      constexpr AttributeHandle() noexcept
+          : AttributeHandle(InvalidHandle)
+      { /* do nothing */ }
+
+      constexpr AttributeHandle(const self_type&) noexcept = default;
+      constexpr AttributeHandle(self_type&&) noexcept = default;
+
+      explicit constexpr AttributeHandle(handle_type slot) noexcept
+          : _slot(slot)
+      { /* do nothing */ }
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~AttributeHandle() = default;
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET SLOT
+      [[nodiscard]] constexpr handle_type slot() const noexcept
+      { return _slot; }
+      /// @}
+
+      /// @{ -------------------------------------------------- IS VALID
+      [[nodiscard]] constexpr bool is_valid() const noexcept
+      { return _slot != InvalidHandle; }
+
+      [[nodiscard]] explicit constexpr operator bool() const noexcept
+      { return is_valid(); }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] constexpr self_type& operator=(const self_type&) noexcept = default;
+      [[maybe_unused]] constexpr self_type& operator=(self_type&&) noexcept = default;
+      /// @}
+  }; // class AttributeHandle
+} // namespace bk
+
+#endif //BK_ATTRIBUTEHANDLE_H
@@ -21,21 +21,38 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
-
 #pragma once
 
 #ifndef BK_ATTRIBUTEMAP_H_
 #define BK_ATTRIBUTEMAP_H_
 
 #include <cassert>
+#include <memory>
 #include <string>
+#include <limits>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <bk/StringUtils>
 
 namespace bk
 {
+  //! hash map of attributes with copy-on-write semantics
+  /*!
+   * - each attribute is stored in a reference-counted buffer; copying the map only copies the references
+   * - non-const access to an attribute that is shared with another map copies it first (detach)
+   * - const access never copies
+   * - non-const begin()/end() detach all attributes, since the buffers are writable through the iterators
+   * - a reference stays valid as long as the attribute is not removed or replaced; once the map has been
+   *   copied, call attribute() or detach() again before writing through it
+   * - detaching is not synchronized: do the first non-const access of a shared attribute before
+   *   writing it from multiple threads
+   * - each attribute occupies a slot; its index is a stable handle (see AttributeHandle) that stays
+   *   valid until the attribute is removed and is shared by copies of the map
+   * - removed attributes leave an empty slot (buffer == nullptr) that is skipped by lookups
+   */
   template<typename TData> class AttributeMap
   {
       //====================================================================================================
@@ -45,15 +62,21 @@ namespace bk
     public:
       using key_type = unsigned long long;
       using data_type = TData;
-      using map_type = std::unordered_map<key_type, data_type>;
-      using iterator = typename map_type::iterator;
-      using const_iterator = typename map_type::const_iterator;
+      using buffer_type = std::shared_ptr<data_type>;
+      using handle_type = unsigned int;
+      using slot_type = std::pair<key_type, buffer_type>;
+      using container_type = std::vector<slot_type>;
+      using iterator = typename container_type::iterator;
+      using const_iterator = typename container_type::const_iterator;
+
+      static constexpr handle_type InvalidHandle = std::numeric_limits<handle_type>::max();
 
     private:
       //====================================================================================================
       //===== MEMBERS
       //====================================================================================================
-      map_type _attrib;
+      container_type _slots;
+      std::unordered_map<key_type, handle_type> _handles;
 
       //====================================================================================================
       //===== CONSTRUCTORS & DESTRUCTOR
@@ -84,16 +107,47 @@ namespace bk
       [[nodiscard]] const data_type& attribute(std::string_view attribute_name) const
       { return attribute(hash(attribute_name)); }
 
+      //! detaches the attribute if it is shared
       [[nodiscard]] data_type& attribute(const key_type& attribute_hash)
       {
           assert(has_attribute(attribute_hash) && "attribute does not exist");
-          return _attrib.find(attribute_hash)->second;
+          return attribute_by_handle(handle(attribute_hash));
       }
 
       [[nodiscard]] const data_type& attribute(const key_type& attribute_hash) const
       {
           assert(has_attribute(attribute_hash) && "attribute does not exist");
-          return _attrib.find(attribute_hash)->second;
+          return attribute_by_handle(handle(attribute_hash));
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET HANDLE
+      //! stable slot index of the attribute; InvalidHandle if it does not exist
+      [[nodiscard]] handle_type handle(std::string_view attribute_name) const
+      { return handle(hash(attribute_name)); }
+
+      [[nodiscard]] handle_type handle(const key_type& attribute_hash) const
+      {
+          auto it = _handles.find(attribute_hash);
+          return it != _handles.end() ? it->second : InvalidHandle;
+      }
+
+      [[nodiscard]] bool is_valid_handle(handle_type h) const
+      { return h < _slots.size() && _slots[h].second != nullptr; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET ATTRIBUTE BY HANDLE
+      //! no hash lookup; detaches the attribute if it is shared
+      [[nodiscard]] data_type& attribute_by_handle(handle_type h)
+      {
+          assert(is_valid_handle(h) && "invalid attribute handle");
+          return *_detached(_slots[h].second);
+      }
+
+      [[nodiscard]] const data_type& attribute_by_handle(handle_type h) const
+      {
+          assert(is_valid_handle(h) && "invalid attribute handle");
+          return *_slots[h].second;
       }
       /// @}
 
@@ -106,28 +160,36 @@ namespace bk
       /// @}
 
       /// @{ -------------------------------------------------- GET ITERATORS
+      //! iterators point to (hash, buffer) slots; skip empty slots (buffer == nullptr)
+      //! non-const iterators detach all attributes first
       [[nodiscard]] iterator begin()
-      { return _attrib.begin(); }
+      {
+          detach();
+          return _slots.begin();
+      }
 
       [[nodiscard]] const_iterator begin() const
-      { return _attrib.begin(); }
+      { return _slots.begin(); }
 
       [[nodiscard]] const_iterator cbegin() const
-      { return _attrib.cbegin(); }
+      { return _slots.cbegin(); }
 
       [[nodiscard]] iterator end()
-      { return _attrib.end(); }
+      {
+          detach();
+          return _slots.end();
+      }
 
       [[nodiscard]] const_iterator end() const
-      { return _attrib.end(); }
+      { return _slots.end(); }
 
       [[nodiscard]] const_iterator cend() const
-      { return _attrib.cend(); }
+      { return _slots.cend(); }
       /// @}
 
       /// @{ -------------------------------------------------- NUM ATTRIBUTES
       [[nodiscard]] unsigned int num_attributes() const
-      { return _attrib.size(); }
+      { return static_cast<unsigned int>(_handles.size()); }
       /// @}
 
       /// @{ -------------------------------------------------- HAS ATTRIBUTE(S)
@@ -138,7 +200,27 @@ namespace bk
       { return has_attribute(hash(attribute_name)); }
 
       [[nodiscard]] bool has_attribute(const key_type& attribute_hash) const
-      { return _attrib.find(attribute_hash) != end(); }
+      { return _handles.find(attribute_hash) != _handles.end(); }
+      /// @}
+
+      /// @{ -------------------------------------------------- IS SHARED
+      //! the attribute buffer is shared with another map (copy)
+      [[nodiscard]] bool is_shared(const key_type& attribute_hash) const
+      {
+          const handle_type h = handle(attribute_hash);
+          return h != InvalidHandle && _slots[h].second.use_count() > 1;
+      }
+
+      [[nodiscard]] bool is_shared() const
+      {
+          for (const auto& [h, buf]: _slots)
+          {
+              if (buf.use_count() > 1)
+              { return true; }
+          }
+
+          return false;
+      }
       /// @}
 
       //====================================================================================================
@@ -146,7 +228,10 @@ namespace bk
       //====================================================================================================
       /// @{ -------------------------------------------------- CLEAR
       virtual void clear()
-      { _attrib.clear(); }
+      {
+          _slots.clear();
+          _handles.clear();
+      }
       /// @}
 
       /// @{ -------------------------------------------------- ADD ATTRIBUTE
@@ -160,43 +245,104 @@ namespace bk
       { return add_attribute(hash(attribute_name), std::move(value)); }
 
       [[maybe_unused]] data_type& add_attribute(const key_type& attribute_hash)
-      { return _attrib.try_emplace(attribute_hash, data_type()).first->second; }
-
-      [[maybe_unused]] data_type& add_attribute(const key_type& attribute_hash, const data_type& value)
       {
-          if (auto it = _attrib.find(attribute_hash); it != _attrib.end())
-          { it->second = value; return it->second;}
-          else
-          {return _attrib.emplace(attribute_hash, value).first->second;}
+          if (const handle_type h = handle(attribute_hash); h != InvalidHandle)
+          { return attribute_by_handle(h); }
+
+          return *(_slot(attribute_hash) = std::make_shared<data_type>());
       }
 
+      //! an existing (possibly shared) buffer is replaced, not overwritten; the handle is kept
+      [[maybe_unused]] data_type& add_attribute(const key_type& attribute_hash, const data_type& value)
+      { return *(_slot(attribute_hash) = std::make_shared<data_type>(value)); }
+
       [[maybe_unused]] data_type& add_attribute(const key_type& attribute_hash, data_type&& value)
-      {
-          if (auto it = _attrib.find(attribute_hash); it != _attrib.end())
-          { it->second = std::move(value); return it->second;}
-          else
-          {return _attrib.emplace(attribute_hash, std::move(value)).first->second;}
-      }
+      { return *(_slot(attribute_hash) = std::make_shared<data_type>(std::move(value))); }
       /// @}
 
       /// @{ -------------------------------------------------- REMOVE ATTRIBUTE
+      //! the slot stays empty, so that the handles of the other attributes remain valid
       [[maybe_unused]] unsigned long remove_attribute(std::string_view attribute_name)
-      { return _attrib.erase(hash(attribute_name)); }
+      { return remove_attribute(hash(attribute_name)); }
 
       [[maybe_unused]] unsigned long remove_attribute(const key_type& attribute_hash)
-      { return _attrib.erase(attribute_hash); }
+      {
+          auto it = _handles.find(attribute_hash);
+
+          if (it == _handles.end())
+          { return 0; }
+
+          _slots[it->second].second.reset();
+          _handles.erase(it);
+
+          return 1;
+      }
 
       [[maybe_unused]] iterator remove_attribute(const_iterator pos)
-      { return _attrib.erase(pos); }
+      { return remove_attributes(pos, std::next(pos)); }
 
       [[maybe_unused]] iterator remove_attributes(const_iterator first, const_iterator last)
-      { return _attrib.erase(first, last); }
+      {
+          const auto firstId = std::distance(_slots.cbegin(), first);
+          const auto lastId = std::distance(_slots.cbegin(), last);
+
+          for (auto i = firstId; i < lastId; ++i)
+          {
+              if (_slots[i].second != nullptr)
+              { remove_attribute(_slots[i].first); }
+          }
+
+          return _slots.begin() + lastId;
+      }
       /// @}
 
       /// @{ -------------------------------------------------- OPERATOR =
       [[maybe_unused]] self_type& operator=(const self_type&) = default;
       [[maybe_unused]] self_type& operator=(self_type&&) noexcept = default;
       /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- DETACH
+    private:
+      //! buffer of the attribute; a new slot is appended if it does not exist
+      [[nodiscard]] buffer_type& _slot(const key_type& attribute_hash)
+      {
+          auto [it, inserted] = _handles.try_emplace(attribute_hash, static_cast<handle_type>(_slots.size()));
+
+          if (inserted)
+          { _slots.emplace_back(attribute_hash, nullptr); }
+
+          return _slots[it->second].second;
+      }
+
+      [[maybe_unused]] static buffer_type& _detached(buffer_type& buf)
+      {
+          if (buf.use_count() > 1)
+          { buf = std::make_shared<data_type>(*buf); }
+
+          return buf;
+      }
+
+    public:
+      //! copies the attribute if it is shared, so that this map is its only owner
+      void detach(const key_type& attribute_hash)
+      {
+          if (const handle_type h = handle(attribute_hash); h != InvalidHandle)
+          { _detached(_slots[h].second); }
+      }
+
+      //! copies all shared attributes
+      void detach()
+      {
+          for (auto& [h, buf]: _slots)
+          {
+              if (buf != nullptr)
+              { _detached(buf); }
+          }
+      }
+      /// @}
   }; // class AttributeMap
 } // namespace bk
 
@@ -90,6 +90,9 @@ namespace bk::attribute_info
 
   BK_DEFINE_ATTRIBUTE_HASH(id, int)
 
+  BK_DEFINE_ATTRIBUTE_HASH(rescale_slope, double)
+  BK_DEFINE_ATTRIBUTE_HASH(rescale_intercept, double)
+
   BK_DEFINE_ATTRIBUTE_HASH(wall_shear_stress, MatXd)
   BK_DEFINE_ATTRIBUTE_HASH(wall_shear_stress_vector, MatXd)
   BK_DEFINE_ATTRIBUTE_HASH(wall_shear_stress_mean, double)
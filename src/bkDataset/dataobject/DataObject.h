@@ -30,8 +30,10 @@
 #include <algorithm>
 #include <any>
 #include <string_view>
+#include <tuple>
 #include <utility>
 
+#include <bkDataset/attributes/AttributeHandle.h>
 #include <bkDataset/attributes/AttributeMap.h>
 #include <bkDataset/attributes/attribute_info.h>
 #include <bkDataset/dataobject/GridGeometryFunctions.h>
@@ -198,6 +200,32 @@ namespace bk
       }
       /// @}
 
+      /// @{ -------------------------------------------------- HAS SHARED ATTRIBUTES
+      //! attribute buffers are shared between copies until they are written (copy-on-write, see AttributeMap)
+      [[nodiscard]] bool has_shared_attributes() const
+      { return _point_attributes.is_shared() || _cell_attributes.is_shared() || _object_attributes.is_shared(); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET ATTRIBUTE SPANS
+      //! several attributes as contiguous views for tight loops, e.g.
+      //! auto [normals, colors] = mesh.point_attribute_spans(normalHandle, colorHandle);
+      template<typename... T>
+      [[nodiscard]] std::tuple<Span<T>...> point_attribute_spans(AttributeHandle<T>... h)
+      { return std::tuple<Span<T>...>(this->point_attribute_span(h)...); }
+
+      template<typename... T>
+      [[nodiscard]] std::tuple<Span<const T>...> point_attribute_spans(AttributeHandle<T>... h) const
+      { return std::tuple<Span<const T>...>(this->point_attribute_span(h)...); }
+
+      template<typename... T>
+      [[nodiscard]] std::tuple<Span<T>...> cell_attribute_spans(AttributeHandle<T>... h)
+      { return std::tuple<Span<T>...>(this->cell_attribute_span(h)...); }
+
+      template<typename... T>
+      [[nodiscard]] std::tuple<Span<const T>...> cell_attribute_spans(AttributeHandle<T>... h) const
+      { return std::tuple<Span<const T>...>(this->cell_attribute_span(h)...); }
+      /// @}
+
       //====================================================================================================
       //===== SETTER
       //====================================================================================================
@@ -206,6 +234,16 @@ namespace bk
       [[maybe_unused]] self_type& operator=(self_type&&) noexcept = default;
       /// @}
 
+      /// @{ -------------------------------------------------- DETACH
+      //! copies all attribute buffers that are shared with other copies of this object
+      void detach()
+      {
+          _point_attributes.detach();
+          _cell_attributes.detach();
+          _object_attributes.detach();
+      }
+      /// @}
+
       /// @{ -------------------------------------------------- ADD OBJECT ATTRIBUTE
       template<typename T>
       [[maybe_unused]] T& add_object_attribute_of_type(unsigned long long attribute_hash)
@@ -29,11 +29,15 @@
 
 #include <algorithm>
 #include <any>
+#include <cassert>
 #include <string_view>
 #include <vector>
 
+#include <bk/NDContainer>
+
 #include <bkDataset/dataobject/GeometryFunctions.h>
 #include <bkDataset/dataobject/filter/SmoothPointValuesFilter.h>
+#include <bkDataset/attributes/AttributeHandle.h>
 #include <bkDataset/attributes/attribute_info.h>
 
 namespace bk::details
@@ -112,6 +116,58 @@ namespace bk::details
       }
       /// @}
 
+      /// @{ -------------------------------------------------- GET POINT ATTRIBUTE HANDLE
+      //! resolve once and use for all further accesses (no hash lookup); invalid if the attribute does not exist
+      template<typename T>
+      [[nodiscard]] AttributeHandle<T> point_attribute_handle_of_type(unsigned long long attribute_hash) const
+      {
+          const auto h = deriv()->point_attribute_map().handle(attribute_hash);
+          assert((h == AttributeHandle<T>::InvalidHandle || std::any_cast<std::vector<T>>(&deriv()->point_attribute_map().attribute_by_handle(h)) != nullptr) && "attribute type mismatch");
+          return AttributeHandle<T>(h);
+      }
+
+      template<typename T>
+      [[nodiscard]] AttributeHandle<T> point_attribute_handle_of_type(std::string_view attribute_name) const
+      {
+          const unsigned long long h = deriv()->point_attribute_map().hash(attribute_name);
+          return point_attribute_handle_of_type<T>(h);
+      }
+
+      template<unsigned long long TAttributeHash>
+      [[nodiscard]] AttributeHandle<attribute_info::type_of_t<TAttributeHash>> point_attribute_handle() const
+      {
+          using T = attribute_info::type_of_t<TAttributeHash>;
+          return point_attribute_handle_of_type<T>(TAttributeHash);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET POINT ATTRIBUTE VECTOR FROM HANDLE
+      template<typename T>
+      [[nodiscard]] std::vector<T>& point_attribute_vector(AttributeHandle<T> h)
+      { return *std::any_cast<std::vector<T>>(&deriv()->point_attribute_map().attribute_by_handle(h.slot())); }
+
+      template<typename T>
+      [[nodiscard]] const std::vector<T>& point_attribute_vector(AttributeHandle<T> h) const
+      { return *std::any_cast<std::vector<T>>(&deriv()->point_attribute_map().attribute_by_handle(h.slot())); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET POINT ATTRIBUTE SPAN
+      //! contiguous view on all values of the attribute for tight loops
+      template<typename T>
+      [[nodiscard]] Span<T> point_attribute_span(AttributeHandle<T> h)
+      {
+          std::vector<T>& v = point_attribute_vector(h);
+          return Span<T>(v.data(), static_cast<unsigned int>(v.size()));
+      }
+
+      template<typename T>
+      [[nodiscard]] Span<const T> point_attribute_span(AttributeHandle<T> h) const
+      {
+          const std::vector<T>& v = point_attribute_vector(h);
+          return Span<const T>(v.data(), static_cast<unsigned int>(v.size()));
+      }
+      /// @}
+
       /// @{ -------------------------------------------------- GET POINT ATTRIBUTE VALUE
       template<typename T>
       [[nodiscard]] T& point_attribute_value_of_type(unsigned long long attribute_hash, unsigned int pointId)
@@ -28,10 +28,12 @@
 #define BK_GRIDTOPOLOGYFUNCTIONS_H
 
 #include <any>
+#include <cassert>
 #include <string_view>
 
 #include <bk/NDContainer>
 #include <bkDataset/dataobject/TopologyFunctions.h>
+#include <bkDataset/attributes/AttributeHandle.h>
 #include <bkDataset/attributes/attribute_info.h>
 
 namespace bk::details
@@ -120,6 +122,58 @@ namespace bk::details
       }
       /// @}
 
+      /// @{ -------------------------------------------------- GET CELL ATTRIBUTE HANDLE
+      //! resolve once and use for all further accesses (no hash lookup); invalid if the attribute does not exist
+      template<typename T>
+      [[nodiscard]] AttributeHandle<T> cell_attribute_handle_of_type(unsigned long long attribute_hash) const
+      {
+          const auto h = deriv()->cell_attribute_map().handle(attribute_hash);
+          assert((h == AttributeHandle<T>::InvalidHandle || std::any_cast<NDVector<T>>(&deriv()->cell_attribute_map().attribute_by_handle(h)) != nullptr) && "attribute type mismatch");
+          return AttributeHandle<T>(h);
+      }
+
+      template<typename T>
+      [[nodiscard]] AttributeHandle<T> cell_attribute_handle_of_type(std::string_view attribute_name) const
+      {
+          const unsigned long long h = deriv()->cell_attribute_map().hash(attribute_name);
+          return cell_attribute_handle_of_type<T>(h);
+      }
+
+      template<unsigned long long TAttributeHash>
+      [[nodiscard]] AttributeHandle<attribute_info::type_of_t<TAttributeHash>> cell_attribute_handle() const
+      {
+          using T = attribute_info::type_of_t<TAttributeHash>;
+          return cell_attribute_handle_of_type<T>(TAttributeHash);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET CELL ATTRIBUTE VECTOR FROM HANDLE
+      template<typename T>
+      [[nodiscard]] NDVector<T>& cell_attribute_vector(AttributeHandle<T> h)
+      { return *std::any_cast<NDVector<T>>(&deriv()->cell_attribute_map().attribute_by_handle(h.slot())); }
+
+      template<typename T>
+      [[nodiscard]] const NDVector<T>& cell_attribute_vector(AttributeHandle<T> h) const
+      { return *std::any_cast<NDVector<T>>(&deriv()->cell_attribute_map().attribute_by_handle(h.slot())); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET CELL ATTRIBUTE SPAN
+      //! contiguous view on all values of the attribute for tight loops
+      template<typename T>
+      [[nodiscard]] Span<T> cell_attribute_span(AttributeHandle<T> h)
+      {
+          NDVector<T>& v = cell_attribute_vector(h);
+          return Span<T>(v.data().data(), v.num_values());
+      }
+
+      template<typename T>
+      [[nodiscard]] Span<const T> cell_attribute_span(AttributeHandle<T> h) const
+      {
+          const NDVector<T>& v = cell_attribute_vector(h);
+          return Span<const T>(v.data().data(), v.num_values());
+      }
+      /// @}
+
       /// @{ -------------------------------------------------- GET CELL ATTRIBUTE VALUE
       template<typename T, typename... TIds>
       [[nodiscard]] T& cell_attribute_value_of_type(unsigned long long attribute_hash, TIds&& ... ids)
@@ -0,0 +1,389 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/BinaryImage.h>
+
+#include <algorithm>
+#include <bitset>
+#include <functional>
+#include <numeric>
+
+namespace bk
+{
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  BinaryImage::BinaryImage()
+      : _size(1, 0),
+        _num_rows(0),
+        _num_words_per_row(0)
+  { /* do nothing */ }
+
+  BinaryImage::BinaryImage(const self_type& other) = default;
+  BinaryImage::BinaryImage(self_type&& other) noexcept = default;
+
+  BinaryImage::BinaryImage(const std::vector<unsigned int>& size)
+      : BinaryImage()
+  { set_size(size); }
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  BinaryImage::~BinaryImage() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET SIZE
+  unsigned int BinaryImage::num_dimensions() const
+  { return static_cast<unsigned int>(_size.size()); }
+
+  const std::vector<unsigned int>& BinaryImage::size() const
+  { return _size; }
+
+  unsigned int BinaryImage::size(unsigned int dimId) const
+  { return _size[dimId]; }
+
+  unsigned int BinaryImage::num_values() const
+  { return _num_rows * _size.back(); }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET WORDS
+  unsigned int BinaryImage::num_rows() const
+  { return _num_rows; }
+
+  unsigned int BinaryImage::num_words_per_row() const
+  { return _num_words_per_row; }
+
+  unsigned int BinaryImage::num_words() const
+  { return static_cast<unsigned int>(_words.size()); }
+
+  auto BinaryImage::data() -> word_type*
+  { return _words.data(); }
+
+  auto BinaryImage::data() const -> const word_type*
+  { return _words.data(); }
+
+  std::size_t BinaryImage::num_bytes() const
+  { return _words.size() * sizeof(word_type); }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET COUNT
+  unsigned long long BinaryImage::count() const
+  {
+      const int n = static_cast<int>(_words.size());
+      unsigned long long c = 0;
+
+      #pragma omp parallel for reduction(+:c)
+      for (int i = 0; i < n; ++i)
+      { c += std::bitset<NumBitsPerWord>(_words[i]).count(); }
+
+      return c;
+  }
+
+  bool BinaryImage::any() const
+  { return std::any_of(_words.begin(), _words.end(), [](word_type w) { return w != 0; }); }
+  /// @}
+
+  /// @{ -------------------------------------------------- IS SAME SIZE
+  bool BinaryImage::has_same_size(const self_type& other) const
+  { return _size == other._size; }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto BinaryImage::operator=(const self_type& other) -> self_type& = default;
+  auto BinaryImage::operator=(self_type&& other) noexcept -> self_type& = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- SET SIZE
+  void BinaryImage::set_size(const std::vector<unsigned int>& size)
+  {
+      assert(!size.empty() && "binary image needs at least one dimension");
+
+      _size = size;
+      _num_rows = std::accumulate(_size.begin(), _size.end() - 1, 1U, std::multiplies<unsigned int>());
+      _num_words_per_row = (_size.back() + NumBitsPerWord - 1) / NumBitsPerWord;
+      _words.assign(static_cast<std::size_t>(_num_rows) * _num_words_per_row, 0);
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET VALUE
+  void BinaryImage::set_constant(bool b)
+  {
+      std::fill(_words.begin(), _words.end(), b ? ~word_type(0) : word_type(0));
+
+      if (b)
+      { _clear_padding(); }
+  }
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- HELPER
+  auto BinaryImage::_last_word_mask() const -> word_type
+  {
+      const unsigned int numUsedBits = _size.back() % NumBitsPerWord;
+      return numUsedBits == 0 ? ~word_type(0) : (word_type(1) << numUsedBits) - 1;
+  }
+
+  void BinaryImage::_clear_padding()
+  {
+      if (_num_words_per_row == 0)
+      { return; }
+
+      const word_type mask = _last_word_mask();
+
+      for (unsigned int r = 0; r < _num_rows; ++r)
+      { _words[static_cast<std::size_t>(r) * _num_words_per_row + _num_words_per_row - 1] &= mask; }
+  }
+
+  void BinaryImage::_dilate_rows(unsigned int radius)
+  {
+      const int numRows = static_cast<int>(_num_rows);
+      const int nw = static_cast<int>(_num_words_per_row);
+      const word_type lastMask = _last_word_mask();
+      std::vector<word_type> tmp(_words.size());
+
+      // x | x shifted by +-s; the step sizes 1, 2, 4, ... (sum = radius) keep the covered range contiguous
+      for (unsigned int covered = 0, step = 1; covered < radius; covered += step, step *= 2)
+      {
+          step = std::min(step, radius - covered);
+
+          const int q = static_cast<int>(step / NumBitsPerWord);
+          const unsigned int b = step % NumBitsPerWord;
+
+          #pragma omp parallel for
+          for (int r = 0; r < numRows; ++r)
+          {
+              const word_type* in = _words.data() + static_cast<std::size_t>(r) * nw;
+              word_type* out = tmp.data() + static_cast<std::size_t>(r) * nw;
+
+              const auto word = [&](int i) -> word_type
+              { return i >= 0 && i < nw ? in[i] : 0; };
+
+              for (int w = 0; w < nw; ++w)
+              {
+                  // voxel x receives x-step (shift to higher x) and x+step (shift to lower x)
+                  word_type up = word(w - q) << b;
+                  word_type down = word(w + q) >> b;
+
+                  if (b != 0)
+                  {
+                      up |= word(w - q - 1) >> (NumBitsPerWord - b);
+                      down |= word(w + q + 1) << (NumBitsPerWord - b);
+                  }
+
+                  out[w] = in[w] | up | down;
+              }
+
+              out[nw - 1] &= lastMask;
+          }
+
+          _words.swap(tmp);
+      }
+  }
+
+  void BinaryImage::_dilate_along(unsigned int dimId, unsigned int radius)
+  {
+      assert(dimId + 1 < num_dimensions());
+
+      const int numRows = static_cast<int>(_num_rows);
+      const int nw = static_cast<int>(_num_words_per_row);
+      const int n = static_cast<int>(_size[dimId]);
+      const int rowStride = static_cast<int>(std::accumulate(_size.begin() + dimId + 1, _size.end() - 1, 1U, std::multiplies<unsigned int>()));
+      std::vector<word_type> tmp(_words.size());
+
+      for (unsigned int covered = 0, step = 1; covered < radius; covered += step, step *= 2)
+      {
+          step = std::min(step, radius - covered);
+          const int s = static_cast<int>(step);
+
+          #pragma omp parallel for
+          for (int r = 0; r < numRows; ++r)
+          {
+              const int c = (r / rowStride) % n;
+              const word_type* in = _words.data() + static_cast<std::size_t>(r) * nw;
+              const word_type* lower = c - s >= 0 ? in - static_cast<std::ptrdiff_t>(s) * rowStride * nw : nullptr;
+              const word_type* upper = c + s < n ? in + static_cast<std::ptrdiff_t>(s) * rowStride * nw : nullptr;
+              word_type* out = tmp.data() + static_cast<std::size_t>(r) * nw;
+
+              for (int w = 0; w < nw; ++w)
+              { out[w] = in[w] | (lower ? lower[w] : 0) | (upper ? upper[w] : 0); }
+          }
+
+          _words.swap(tmp);
+      }
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- LOGICAL OPERATORS
+  auto BinaryImage::operator&=(const self_type& other) -> self_type&
+  {
+      assert(has_same_size(other));
+      const int n = static_cast<int>(_words.size());
+
+      #pragma omp parallel for simd
+      for (int i = 0; i < n; ++i)
+      { _words[i] &= other._words[i]; }
+
+      return *this;
+  }
+
+  auto BinaryImage::operator|=(const self_type& other) -> self_type&
+  {
+      assert(has_same_size(other));
+      const int n = static_cast<int>(_words.size());
+
+      #pragma omp parallel for simd
+      for (int i = 0; i < n; ++i)
+      { _words[i] |= other._words[i]; }
+
+      return *this;
+  }
+
+  auto BinaryImage::operator^=(const self_type& other) -> self_type&
+  {
+      assert(has_same_size(other));
+      const int n = static_cast<int>(_words.size());
+
+      #pragma omp parallel for simd
+      for (int i = 0; i < n; ++i)
+      { _words[i] ^= other._words[i]; }
+
+      return *this;
+  }
+
+  auto BinaryImage::subtract(const self_type& other) -> self_type&
+  {
+      assert(has_same_size(other));
+      const int n = static_cast<int>(_words.size());
+
+      #pragma omp parallel for simd
+      for (int i = 0; i < n; ++i)
+      { _words[i] &= ~other._words[i]; }
+
+      return *this;
+  }
+
+  auto BinaryImage::invert() -> self_type&
+  {
+      const int n = static_cast<int>(_words.size());
+
+      #pragma omp parallel for simd
+      for (int i = 0; i < n; ++i)
+      { _words[i] = ~_words[i]; }
+
+      _clear_padding();
+
+      return *this;
+  }
+
+  auto BinaryImage::operator&(const self_type& other) const -> self_type
+  {
+      self_type res = *this;
+      res &= other;
+      return res;
+  }
+
+  auto BinaryImage::operator|(const self_type& other) const -> self_type
+  {
+      self_type res = *this;
+      res |= other;
+      return res;
+  }
+
+  auto BinaryImage::operator^(const self_type& other) const -> self_type
+  {
+      self_type res = *this;
+      res ^= other;
+      return res;
+  }
+
+  auto BinaryImage::operator~() const -> self_type
+  {
+      self_type res = *this;
+      res.invert();
+      return res;
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- MORPHOLOGY
+  void BinaryImage::dilate(const std::vector<unsigned int>& radius)
+  {
+      assert(radius.size() == num_dimensions());
+
+      for (unsigned int i = 0; i + 1 < num_dimensions(); ++i)
+      {
+          if (radius[i] != 0)
+          { _dilate_along(i, radius[i]); }
+      }
+
+      if (radius.back() != 0)
+      { _dilate_rows(radius.back()); }
+  }
+
+  void BinaryImage::erode(const std::vector<unsigned int>& radius)
+  {
+      // duality: voxels outside count as foreground for the erosion and as background for the dilation of the complement
+      invert();
+      dilate(radius);
+      invert();
+  }
+
+  auto BinaryImage::dilated(const std::vector<unsigned int>& radius) const -> self_type
+  {
+      self_type res = *this;
+      res.dilate(radius);
+      return res;
+  }
+
+  auto BinaryImage::eroded(const std::vector<unsigned int>& radius) const -> self_type
+  {
+      self_type res = *this;
+      res.erode(radius);
+      return res;
+  }
+
+  auto BinaryImage::opened(const std::vector<unsigned int>& radius) const -> self_type
+  {
+      self_type res = *this;
+      res.erode(radius);
+      res.dilate(radius);
+      return res;
+  }
+
+  auto BinaryImage::closed(const std::vector<unsigned int>& radius) const -> self_type
+  {
+      self_type res = *this;
+      res.dilate(radius);
+      res.erode(radius);
+      return res;
+  }
+  /// @}
+} // namespace bk
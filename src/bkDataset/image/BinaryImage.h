@@ -0,0 +1,259 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_BINARYIMAGE_H
+#define BKDATASET_BINARYIMAGE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! bit-packed binary image (e.g. segmentation masks) with word-parallel operations
+  /*!
+   * - one bit per voxel in 64 bit words
+   * - the last dimension (stride 1 in the image's list order) is stored as rows;
+   *   each row starts at a new word and the padding bits are always 0
+   * - erosion/dilation use box structuring elements; shifts within a row and whole-word
+   *   AND/OR between rows process 64 voxels at once
+   * - voxels outside the image are ignored (equivalent to ImageBoundaryMode::Clamp)
+   */
+  class BKDATASET_EXPORT BinaryImage
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = BinaryImage;
+
+    public:
+      using word_type = std::uint64_t;
+      static constexpr unsigned int NumBitsPerWord = 64;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      std::vector<unsigned int> _size;
+      unsigned int _num_rows;
+      unsigned int _num_words_per_row;
+      std::vector<word_type> _words;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      BinaryImage();
+      BinaryImage(const self_type& other);
+      BinaryImage(self_type&& other) noexcept;
+      explicit BinaryImage(const std::vector<unsigned int>& size);
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~BinaryImage();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET SIZE
+      [[nodiscard]] unsigned int num_dimensions() const;
+      [[nodiscard]] const std::vector<unsigned int>& size() const;
+      [[nodiscard]] unsigned int size(unsigned int dimId) const;
+      [[nodiscard]] unsigned int num_values() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET WORDS
+      [[nodiscard]] unsigned int num_rows() const;
+      [[nodiscard]] unsigned int num_words_per_row() const;
+      [[nodiscard]] unsigned int num_words() const;
+      [[nodiscard]] word_type* data();
+      [[nodiscard]] const word_type* data() const;
+      //! number of bytes of the bit storage
+      [[nodiscard]] std::size_t num_bytes() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET VALUE
+      //! listId in the list order of the corresponding Image
+      [[nodiscard]] bool operator[](unsigned int listId) const
+      {
+          const unsigned int n = _size.back();
+          const unsigned int x = listId % n;
+          return (_words[(listId / n) * _num_words_per_row + x / NumBitsPerWord] >> (x % NumBitsPerWord)) & word_type(1);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET COUNT
+      //! number of set voxels (popcount)
+      [[nodiscard]] unsigned long long count() const;
+      [[nodiscard]] bool any() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- IS SAME SIZE
+      [[nodiscard]] bool has_same_size(const self_type& other) const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET SIZE
+      //! all voxels are reset to 0
+      void set_size(const std::vector<unsigned int>& size);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET VALUE
+      void set(unsigned int listId, bool b)
+      {
+          const unsigned int n = _size.back();
+          const unsigned int x = listId % n;
+          word_type& w = _words[(listId / n) * _num_words_per_row + x / NumBitsPerWord];
+          const word_type bit = word_type(1) << (x % NumBitsPerWord);
+          w = b ? (w | bit) : (w & ~bit);
+      }
+
+      void set_constant(bool b);
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER
+      [[nodiscard]] word_type _last_word_mask() const;
+      void _clear_padding();
+      void _dilate_rows(unsigned int radius);
+      void _dilate_along(unsigned int dimId, unsigned int radius);
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- LOGICAL OPERATORS
+      [[maybe_unused]] auto operator&=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator|=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator^=(const self_type& other) -> self_type&;
+      //! set minus (this AND NOT other)
+      [[maybe_unused]] auto subtract(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto invert() -> self_type&;
+
+      [[nodiscard]] self_type operator&(const self_type& other) const;
+      [[nodiscard]] self_type operator|(const self_type& other) const;
+      [[nodiscard]] self_type operator^(const self_type& other) const;
+      [[nodiscard]] self_type operator~() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- MORPHOLOGY
+      //! box structuring element with size 2*radius[i]+1 in dimension i
+      [[nodiscard]] self_type dilated(const std::vector<unsigned int>& radius) const;
+      [[nodiscard]] self_type eroded(const std::vector<unsigned int>& radius) const;
+      [[nodiscard]] self_type opened(const std::vector<unsigned int>& radius) const;
+      [[nodiscard]] self_type closed(const std::vector<unsigned int>& radius) const;
+
+      //! in-place versions
+      void dilate(const std::vector<unsigned int>& radius);
+      void erode(const std::vector<unsigned int>& radius);
+      /// @}
+
+      /// @{ -------------------------------------------------- CONVERSION
+      //! voxels are set where pred(value) is true
+      template<typename TImage, typename TPredicate>
+      [[nodiscard]] static self_type from_image(const TImage& img, TPredicate pred)
+      {
+          std::vector<unsigned int> size(img.num_dimensions());
+          for (unsigned int i = 0; i < size.size(); ++i)
+          { size[i] = img.size(i); }
+
+          self_type res(size);
+
+          const unsigned int n = size.back();
+          const int numRows = static_cast<int>(res._num_rows);
+
+          #pragma omp parallel for
+          for (int r = 0; r < numRows; ++r)
+          {
+              word_type* row = res._words.data() + static_cast<std::size_t>(r) * res._num_words_per_row;
+              const unsigned int off = static_cast<unsigned int>(r) * n;
+
+              for (unsigned int x0 = 0; x0 < n; x0 += NumBitsPerWord)
+              {
+                  const unsigned int xEnd = std::min(n, x0 + NumBitsPerWord);
+                  word_type w = 0;
+
+                  for (unsigned int x = x0; x < xEnd; ++x)
+                  { w |= static_cast<word_type>(pred(img[off + x]) ? 1 : 0) << (x - x0); }
+
+                  row[x0 / NumBitsPerWord] = w;
+              }
+          }
+
+          return res;
+      }
+
+      //! voxels are set where the value is != 0
+      template<typename TImage>
+      [[nodiscard]] static self_type from_image(const TImage& img)
+      {
+          using value_type = typename TImage::value_type;
+          return from_image(img, [](const value_type& x) { return x != value_type(0); });
+      }
+
+      //! writes foreground/background values; the image is resized if necessary (geometry is kept otherwise)
+      template<typename TImage>
+      void to_image(TImage& img, typename TImage::value_type foreground = 1, typename TImage::value_type background = 0) const
+      {
+          bool sameSize = img.num_dimensions() == num_dimensions();
+          for (unsigned int i = 0; sameSize && i < num_dimensions(); ++i)
+          { sameSize = img.size(i) == _size[i]; }
+
+          if (!sameSize)
+          { img.set_size(_size); }
+
+          const unsigned int n = _size.back();
+          const int numRows = static_cast<int>(_num_rows);
+          auto* dst = img.span().data();
+
+          #pragma omp parallel for
+          for (int r = 0; r < numRows; ++r)
+          {
+              const word_type* row = _words.data() + static_cast<std::size_t>(r) * _num_words_per_row;
+              const std::size_t off = static_cast<std::size_t>(r) * n;
+
+              for (unsigned int x = 0; x < n; ++x)
+              { dst[off + x] = ((row[x / NumBitsPerWord] >> (x % NumBitsPerWord)) & word_type(1)) ? foreground : background; }
+          }
+      }
+      /// @}
+  }; // class BinaryImage
+} // namespace bk
+
+#endif //BKDATASET_BINARYIMAGE_H
@@ -0,0 +1,809 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_BRICKEDIMAGE_H
+#define BKDATASET_BRICKEDIMAGE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <bk/NDContainer>
+#include <bk/ThreadPool>
+#include <bkTypeTraits/has_index_operator.h>
+
+namespace bk
+{
+  //! out-of-core image storage; values are stored in fixed-size bricks in a file
+  /*!
+   * - only a bounded number of bricks (max_num_cached_bricks()) is resident; the least recently
+   *   used brick is evicted (and written back if it was modified) when another brick is required
+   * - for_each_brick() streams through all bricks and prefetches the next brick asynchronously
+   * - references returned by operator() are valid until another brick is loaded
+   * - not thread-safe; parallelize within a brick (see for_each_brick())
+   * - border bricks are stored with full brick size; the values outside of the image are unused
+   *
+   * typical usage for a 4D (3D+t) dataset:
+   *
+   *     BrickedImage<float, 4> img;
+   *     img.create("flow.bkbricks", {nx, ny, nz, nt}, {32, 32, 32, 1}, 64);
+   *
+   *     img.for_each_brick([](auto& brick)
+   *     {
+   *         for (unsigned int i = 0; i < brick.num_values(); ++i)
+   *         { brick[i] = [...]; }
+   *     });
+   */
+  template<typename TValue, int TDims = -1> class BrickedImage
+  {
+      //====================================================================================================
+      //===== ASSERTIONS
+      //====================================================================================================
+      static_assert(TDims == -1 || TDims > 0);
+      static_assert(std::is_trivially_copyable_v<TValue> && !std::is_same_v<TValue, bool>, "BrickedImage requires trivially copyable value types");
+
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = BrickedImage<TValue, TDims>;
+    public:
+      using value_type = TValue;
+
+      //! view of a resident brick; index operators use brick-local list ids (last dimension has stride 1)
+      template<typename TBrickValue> class BrickView
+      {
+          friend class BrickedImage<TValue, TDims>;
+
+          const std::vector<unsigned int>* _origin;
+          const std::vector<unsigned int>* _size;
+          const std::vector<unsigned int>* _brick_size;
+          unsigned int _id;
+          TBrickValue* _values;
+
+        public:
+          BrickView(unsigned int id, const std::vector<unsigned int>& origin, const std::vector<unsigned int>& size, const std::vector<unsigned int>& brick_size, TBrickValue* values)
+              : _origin(&origin),
+                _size(&size),
+                _brick_size(&brick_size),
+                _id(id),
+                _values(values)
+          { /* do nothing */ }
+
+          //! brick list id
+          [[nodiscard]] unsigned int id() const
+          { return _id; }
+
+          //! grid id of the first brick voxel in the image
+          [[nodiscard]] const std::vector<unsigned int>& origin() const
+          { return *_origin; }
+
+          //! number of brick voxels inside the image per dimension (<= brick_size())
+          [[nodiscard]] const std::vector<unsigned int>& size() const
+          { return *_size; }
+
+          [[nodiscard]] const std::vector<unsigned int>& brick_size() const
+          { return *_brick_size; }
+
+          //! number of stored values (including unused values of border bricks)
+          [[nodiscard]] unsigned int num_values() const
+          {
+              unsigned int n = 1;
+
+              for (unsigned int s: *_brick_size)
+              { n *= s; }
+
+              return n;
+          }
+
+          //! true if the (brick-local) list id is inside of the image
+          [[nodiscard]] bool is_inside(unsigned int localListId) const
+          {
+              const unsigned int N = static_cast<unsigned int>(_brick_size->size());
+
+              for (int d = static_cast<int>(N) - 1; d >= 0; --d)
+              {
+                  if (localListId % (*_brick_size)[d] >= (*_size)[d])
+                  { return false; }
+
+                  localListId /= (*_brick_size)[d];
+              }
+
+              return true;
+          }
+
+          [[nodiscard]] TBrickValue* data() const
+          { return _values; }
+
+          [[nodiscard]] TBrickValue& operator[](unsigned int localListId) const
+          { return _values[localListId]; }
+      }; // class BrickView
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      struct Brick
+      {
+          unsigned int id;
+          std::vector<value_type> values;
+          bool modified;
+      };
+
+      std::string _filepath;
+      mutable std::fstream _file;
+      std::uint64_t _data_offset;
+      std::vector<unsigned int> _size;
+      std::vector<unsigned int> _brick_size;
+      std::vector<unsigned int> _num_bricks;
+      unsigned int _num_values_per_brick;
+      unsigned int _max_num_cached_bricks;
+      mutable std::list<Brick> _cache; // front = most recently used
+      mutable std::unordered_map<unsigned int, typename std::list<Brick>::iterator> _cache_lookup;
+      mutable std::future<std::vector<value_type>> _prefetch;
+      mutable unsigned int _prefetch_brick_id;
+
+      static constexpr unsigned int NoBrick = std::numeric_limits<unsigned int>::max();
+      static constexpr char Magic[8] = {'B', 'K', 'B', 'R', 'I', 'C', 'K', 'S'};
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      BrickedImage()
+          : _filepath(""),
+            _data_offset(0),
+            _num_values_per_brick(0),
+            _max_num_cached_bricks(16),
+            _prefetch_brick_id(NoBrick)
+      { /* do nothing */ }
+
+      BrickedImage(const self_type&) = delete;
+      BrickedImage(self_type&&) = delete;
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~BrickedImage()
+      { close(); }
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- IS OPEN
+      [[nodiscard]] bool is_open() const
+      { return _file.is_open(); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET FILEPATH
+      [[nodiscard]] const std::string& filepath() const
+      { return _filepath; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SIZE
+      [[nodiscard]] unsigned int num_dimensions() const
+      { return static_cast<unsigned int>(_size.size()); }
+
+      [[nodiscard]] const std::vector<unsigned int>& size() const
+      { return _size; }
+
+      [[nodiscard]] unsigned int size(unsigned int dimId) const
+      { return _size[dimId]; }
+
+      //! 64 bit; out-of-core images may exceed 2^32 values
+      [[nodiscard]] std::uint64_t num_values() const
+      { return _size.empty() ? 0 : std::accumulate(_size.begin(), _size.end(), std::uint64_t(1), std::multiplies<std::uint64_t>()); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET BRICK SIZE
+      [[nodiscard]] const std::vector<unsigned int>& brick_size() const
+      { return _brick_size; }
+
+      [[nodiscard]] unsigned int brick_size(unsigned int dimId) const
+      { return _brick_size[dimId]; }
+
+      [[nodiscard]] unsigned int num_values_per_brick() const
+      { return _num_values_per_brick; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET NUM BRICKS
+      [[nodiscard]] const std::vector<unsigned int>& num_bricks_per_dimension() const
+      { return _num_bricks; }
+
+      [[nodiscard]] unsigned int num_bricks() const
+      { return _num_bricks.empty() ? 0 : std::accumulate(_num_bricks.begin(), _num_bricks.end(), 1U, std::multiplies<unsigned int>()); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET CACHE SIZE
+      [[nodiscard]] unsigned int max_num_cached_bricks() const
+      { return _max_num_cached_bricks; }
+
+      [[nodiscard]] unsigned int num_cached_bricks() const
+      { return static_cast<unsigned int>(_cache.size()); }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPERS: BRICK LOOKUP
+    private:
+      template<typename TIndexAccessible>
+      void _brick_and_local_id(const TIndexAccessible& gid, unsigned int& brickId, unsigned int& localId) const
+      {
+          brickId = 0;
+          localId = 0;
+
+          for (unsigned int d = 0; d < num_dimensions(); ++d)
+          {
+              const unsigned int g = static_cast<unsigned int>(gid[d]);
+              assert(g < _size[d] && "grid id out of bounds");
+
+              brickId = brickId * _num_bricks[d] + g / _brick_size[d];
+              localId = localId * _brick_size[d] + g % _brick_size[d];
+          }
+      }
+
+      //! same as above for an image list id (last dimension has stride 1)
+      void _brick_and_local_id_of_list_id(std::uint64_t listId, unsigned int& brickId, unsigned int& localId) const
+      {
+          assert(listId < num_values() && "list id out of bounds");
+
+          brickId = 0;
+          localId = 0;
+
+          unsigned int brickStride = 1;
+          unsigned int localStride = 1;
+
+          for (int d = static_cast<int>(num_dimensions()) - 1; d >= 0; --d)
+          {
+              const unsigned int g = static_cast<unsigned int>(listId % _size[d]);
+              listId /= _size[d];
+
+              brickId += (g / _brick_size[d]) * brickStride;
+              localId += (g % _brick_size[d]) * localStride;
+
+              brickStride *= _num_bricks[d];
+              localStride *= _brick_size[d];
+          }
+      }
+
+      [[nodiscard]] std::uint64_t _file_offset_of_brick(unsigned int brickId) const
+      { return _data_offset + static_cast<std::uint64_t>(brickId) * _num_values_per_brick * sizeof(value_type); }
+
+      void _write_brick(const Brick& b) const
+      {
+          _file.seekp(static_cast<std::streamoff>(_file_offset_of_brick(b.id)), std::ios_base::beg);
+          _file.write(reinterpret_cast<const char*>(b.values.data()), static_cast<std::streamsize>(b.values.size() * sizeof(value_type)));
+      }
+
+      [[nodiscard]] std::vector<value_type> _read_brick(unsigned int brickId) const
+      {
+          std::vector<value_type> values(_num_values_per_brick);
+          _file.seekg(static_cast<std::streamoff>(_file_offset_of_brick(brickId)), std::ios_base::beg);
+          _file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(value_type)));
+          return values;
+      }
+
+      void _evict_bricks(unsigned int maxNumBricks) const
+      {
+          while (_cache.size() > maxNumBricks)
+          {
+              const Brick& b = _cache.back();
+
+              if (b.modified)
+              { _write_brick(b); }
+
+              _cache_lookup.erase(b.id);
+              _cache.pop_back();
+          }
+
+          // make written bricks visible to prefetching streams
+          _file.flush();
+      }
+
+      void _wait_for_prefetch() const
+      {
+          if (_prefetch_brick_id == NoBrick)
+          { return; }
+
+          const unsigned int brickId = _prefetch_brick_id;
+          _prefetch_brick_id = NoBrick;
+
+          std::vector<value_type> values = _prefetch.get();
+
+          if (_cache_lookup.find(brickId) == _cache_lookup.end())
+          {
+              _evict_bricks(std::max(_max_num_cached_bricks, 1U) - 1);
+              _cache.push_front(Brick{brickId, std::move(values), false});
+              _cache_lookup[brickId] = _cache.begin();
+          }
+      }
+
+      //! returns the brick (most recently used); loads it if necessary
+      Brick& _brick(unsigned int brickId) const
+      {
+          if (auto it = _cache_lookup.find(brickId); it != _cache_lookup.end())
+          {
+              _cache.splice(_cache.begin(), _cache, it->second);
+              return _cache.front();
+          }
+
+          if (_prefetch_brick_id == brickId)
+          {
+              _wait_for_prefetch();
+              return _cache.front();
+          }
+
+          _evict_bricks(std::max(_max_num_cached_bricks, 1U) - 1);
+          _cache.push_front(Brick{brickId, _read_brick(brickId), false});
+          _cache_lookup[brickId] = _cache.begin();
+
+          return _cache.front();
+      }
+
+      void _brick_extent(unsigned int brickId, std::vector<unsigned int>& origin, std::vector<unsigned int>& extent) const
+      {
+          for (int d = static_cast<int>(num_dimensions()) - 1; d >= 0; --d)
+          {
+              const unsigned int b = brickId % _num_bricks[d];
+              brickId /= _num_bricks[d];
+
+              origin[d] = b * _brick_size[d];
+              extent[d] = std::min(_brick_size[d], _size[d] - origin[d]);
+          }
+      }
+    public:
+      /// @}
+
+      /// @{ -------------------------------------------------- GET VALUE
+      template<typename... TIds, std::enable_if_t<std::conjunction_v<std::is_integral<TIds>...>>* = nullptr>
+      [[nodiscard]] value_type& operator()(TIds... ids)
+      {
+          static_assert(TDims == -1 || sizeof...(TIds) == TDims, "invalid number of arguments");
+          return operator()(std::array<unsigned int, sizeof...(TIds)>{{static_cast<unsigned int>(ids)...}});
+      }
+
+      template<typename... TIds, std::enable_if_t<std::conjunction_v<std::is_integral<TIds>...>>* = nullptr>
+      [[nodiscard]] value_type operator()(TIds... ids) const
+      {
+          static_assert(TDims == -1 || sizeof...(TIds) == TDims, "invalid number of arguments");
+          return operator()(std::array<unsigned int, sizeof...(TIds)>{{static_cast<unsigned int>(ids)...}});
+      }
+
+      template<typename TIndexAccessible, std::enable_if_t<bk::has_index_operator_v<TIndexAccessible>>* = nullptr>
+      [[nodiscard]] value_type& operator()(const TIndexAccessible& gid)
+      {
+          unsigned int brickId = 0;
+          unsigned int localId = 0;
+          _brick_and_local_id(gid, brickId, localId);
+
+          Brick& b = _brick(brickId);
+          b.modified = true;
+
+          return b.values[localId];
+      }
+
+      template<typename TIndexAccessible, std::enable_if_t<bk::has_index_operator_v<TIndexAccessible>>* = nullptr>
+      [[nodiscard]] value_type operator()(const TIndexAccessible& gid) const
+      {
+          unsigned int brickId = 0;
+          unsigned int localId = 0;
+          _brick_and_local_id(gid, brickId, localId);
+
+          return _brick(brickId).values[localId];
+      }
+
+      //! access via image list id (last dimension has stride 1)
+      [[nodiscard]] value_type& operator[](std::uint64_t listId)
+      {
+          unsigned int brickId = 0;
+          unsigned int localId = 0;
+          _brick_and_local_id_of_list_id(listId, brickId, localId);
+
+          Brick& b = _brick(brickId);
+          b.modified = true;
+
+          return b.values[localId];
+      }
+
+      [[nodiscard]] value_type operator[](std::uint64_t listId) const
+      {
+          unsigned int brickId = 0;
+          unsigned int localId = 0;
+          _brick_and_local_id_of_list_id(listId, brickId, localId);
+
+          return _brick(brickId).values[localId];
+      }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type&) -> self_type& = delete;
+      [[maybe_unused]] auto operator=(self_type&&) -> self_type& = delete;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET CACHE SIZE
+      void set_max_num_cached_bricks(unsigned int n)
+      {
+          _max_num_cached_bricks = std::max(n, 1U);
+          _evict_bricks(_max_num_cached_bricks);
+      }
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- CREATE
+      //! creates a new brick file (existing files are overwritten); all values are zero
+      template<typename TSize, typename TBrickSize>
+      [[maybe_unused]] bool create(std::string_view filepath, const TSize& size, const TBrickSize& brickSize, unsigned int maxNumCachedBricks = 16)
+      {
+          close();
+
+          _size.assign(std::begin(size), std::end(size));
+          _brick_size.assign(std::begin(brickSize), std::end(brickSize));
+
+          if (_size.empty() || _size.size() != _brick_size.size() || (TDims != -1 && _size.size() != static_cast<unsigned int>(TDims)))
+          { return false; }
+
+          _init_brick_layout(maxNumCachedBricks);
+
+          /*
+           * header
+           */
+          {
+              std::ofstream file(filepath.data(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+              if (!file.is_open() || !file.good())
+              { return false; }
+
+              file.write(Magic, 8);
+
+              const std::uint32_t numDimensions = num_dimensions();
+              file.write(reinterpret_cast<const char*>(&numDimensions), sizeof(std::uint32_t));
+
+              for (const std::vector<unsigned int>* v: {&_size, &_brick_size})
+              {
+                  for (unsigned int x: *v)
+                  {
+                      const std::uint32_t uitemp = x;
+                      file.write(reinterpret_cast<const char*>(&uitemp), sizeof(std::uint32_t));
+                  }
+              }
+
+              const std::uint32_t valueSize = sizeof(value_type);
+              file.write(reinterpret_cast<const char*>(&valueSize), sizeof(std::uint32_t));
+
+              _data_offset = _header_size();
+
+              // allocate file (sparse on most file systems)
+              const std::uint64_t numBytes = _file_offset_of_brick(num_bricks());
+              file.seekp(static_cast<std::streamoff>(numBytes - 1), std::ios_base::beg);
+              file.put('\0');
+
+              if (!file.good())
+              { return false; }
+          }
+
+          _filepath = filepath;
+          _file.open(_filepath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+
+          return _file.is_open();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- OPEN
+      [[maybe_unused]] bool open(std::string_view filepath, unsigned int maxNumCachedBricks = 16)
+      {
+          close();
+
+          _file.open(filepath.data(), std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+
+          if (!_file.is_open() || !_file.good())
+          { return false; }
+
+          char magic[8];
+          _file.read(magic, 8);
+
+          std::uint32_t numDimensions = 0;
+          _file.read(reinterpret_cast<char*>(&numDimensions), sizeof(std::uint32_t));
+
+          if (!_file.good() || std::memcmp(magic, Magic, 8) != 0 || numDimensions == 0 || (TDims != -1 && numDimensions != static_cast<std::uint32_t>(TDims)))
+          {
+              _file.close();
+              return false;
+          }
+
+          _size.resize(numDimensions);
+          _brick_size.resize(numDimensions);
+
+          for (std::vector<unsigned int>* v: {&_size, &_brick_size})
+          {
+              for (unsigned int& x: *v)
+              {
+                  std::uint32_t uitemp = 0;
+                  _file.read(reinterpret_cast<char*>(&uitemp), sizeof(std::uint32_t));
+                  x = uitemp;
+              }
+          }
+
+          std::uint32_t valueSize = 0;
+          _file.read(reinterpret_cast<char*>(&valueSize), sizeof(std::uint32_t));
+
+          if (!_file.good() || valueSize != sizeof(value_type))
+          {
+              _file.close();
+              return false;
+          }
+
+          _init_brick_layout(maxNumCachedBricks);
+          _data_offset = _header_size();
+          _filepath = filepath;
+
+          return true;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPERS: LAYOUT
+    private:
+      void _init_brick_layout(unsigned int maxNumCachedBricks)
+      {
+          _num_bricks.resize(num_dimensions());
+          _num_values_per_brick = 1;
+
+          for (unsigned int d = 0; d < num_dimensions(); ++d)
+          {
+              _brick_size[d] = std::clamp(_brick_size[d], 1U, std::max(_size[d], 1U));
+              _num_bricks[d] = (_size[d] + _brick_size[d] - 1) / _brick_size[d];
+              _num_values_per_brick *= _brick_size[d];
+          }
+
+          _max_num_cached_bricks = std::max(maxNumCachedBricks, 1U);
+      }
+
+      [[nodiscard]] std::uint64_t _header_size() const
+      {
+          // magic, num dimensions, size, brick size, value size; aligned to 4096 bytes
+          const std::uint64_t n = 8 + sizeof(std::uint32_t) * (2 + 2 * num_dimensions());
+          return (n + 4095) / 4096 * 4096;
+      }
+    public:
+      /// @}
+
+      /// @{ -------------------------------------------------- FLUSH
+      //! writes all modified bricks to the file
+      void flush()
+      {
+          if (!is_open())
+          { return; }
+
+          for (Brick& b: _cache)
+          {
+              if (b.modified)
+              {
+                  _write_brick(b);
+                  b.modified = false;
+              }
+          }
+
+          _file.flush();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- CLOSE
+      void close()
+      {
+          if (_prefetch_brick_id != NoBrick)
+          {
+              _prefetch.wait();
+              _prefetch_brick_id = NoBrick;
+          }
+
+          flush();
+
+          _cache.clear();
+          _cache_lookup.clear();
+
+          if (_file.is_open())
+          { _file.close(); }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- PREFETCH
+      //! asynchronously reads the brick into the cache (via bk_threadpool)
+      void prefetch(unsigned int brickId) const
+      {
+          if (brickId >= num_bricks() || _prefetch_brick_id == brickId || _cache_lookup.find(brickId) != _cache_lookup.end())
+          { return; }
+
+          _wait_for_prefetch();
+
+          _prefetch_brick_id = brickId;
+          _prefetch = bk_threadpool.enqueue([](std::string filepath, std::uint64_t offset, unsigned int n)
+                                            {
+                                                // separate stream; the brick is not resident, so it is not written concurrently
+                                                std::vector<value_type> values(n);
+                                                std::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
+                                                file.seekg(static_cast<std::streamoff>(offset), std::ios_base::beg);
+                                                file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(n * sizeof(value_type)));
+                                                return values;
+                                            }, _filepath, _file_offset_of_brick(brickId), _num_values_per_brick);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- FOR EACH BRICK
+      //! calls f(BrickView) for each brick in file order while the next brick is prefetched
+      /*!
+       * All visited bricks are marked as modified and written back on eviction. Use
+       * for_each_brick_read_only() (or the const overload) if f does not write.
+       */
+      template<typename TFunction>
+      void for_each_brick(TFunction&& f)
+      {
+          std::vector<unsigned int> origin(num_dimensions());
+          std::vector<unsigned int> extent(num_dimensions());
+
+          for (unsigned int brickId = 0; brickId < num_bricks(); ++brickId)
+          {
+              // the prefetched brick is moved to the cache before the next one is requested
+              prefetch(brickId + 1);
+
+              Brick& b = _brick(brickId);
+              b.modified = true;
+
+              _brick_extent(brickId, origin, extent);
+              BrickView<value_type> view(brickId, origin, extent, _brick_size, b.values.data());
+              f(view);
+          }
+      }
+
+      template<typename TFunction>
+      void for_each_brick(TFunction&& f) const
+      {
+          std::vector<unsigned int> origin(num_dimensions());
+          std::vector<unsigned int> extent(num_dimensions());
+
+          for (unsigned int brickId = 0; brickId < num_bricks(); ++brickId)
+          {
+              prefetch(brickId + 1);
+
+              const Brick& b = _brick(brickId);
+
+              _brick_extent(brickId, origin, extent);
+              const BrickView<const value_type> view(brickId, origin, extent, _brick_size, b.values.data());
+              f(view);
+          }
+      }
+
+      //! const access on non-const images; bricks are not marked as modified
+      template<typename TFunction>
+      void for_each_brick_read_only(TFunction&& f) const
+      { for_each_brick(std::forward<TFunction>(f)); }
+      /// @}
+
+      /// @{ -------------------------------------------------- MIN / MAX VALUE
+      //! streams through all bricks
+      [[nodiscard]] std::pair<value_type, value_type> minmax_value() const
+      {
+          assert(num_values() != 0 && "call create() or open() first");
+
+          std::pair<value_type, value_type> res(operator[](0), operator[](0));
+
+          for_each_brick([&](const auto& brick)
+                         {
+                             for (unsigned int i = 0; i < brick.num_values(); ++i)
+                             {
+                                 if (brick.is_inside(i))
+                                 {
+                                     res.first = std::min(res.first, brick[i]);
+                                     res.second = std::max(res.second, brick[i]);
+                                 }
+                             }
+                         });
+
+          return res;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- CONVERSION FROM/TO IMAGE
+      //! copies the values of an image of the same size brick-wise
+      template<typename TImage>
+      [[maybe_unused]] bool assign_from_image(const TImage& img)
+      {
+          if (img.num_values() != num_values())
+          { return false; }
+
+          std::vector<unsigned int> gid(num_dimensions());
+
+          for_each_brick([&](auto& brick)
+                         {
+                             for (unsigned int i = 0; i < brick.num_values(); ++i)
+                             {
+                                 if (_brick_local_to_image_grid_id(brick, i, gid))
+                                 { brick[i] = img(gid); }
+                             }
+                         });
+
+          return true;
+      }
+
+      //! copies all values into an image (which must fit into memory); img is not changed if this image is empty
+      template<typename TImage>
+      void copy_to_image(TImage& img) const
+      {
+          if (_size.empty())
+          { return; }
+
+          img.set_size(_size);
+
+          std::vector<unsigned int> gid(num_dimensions());
+
+          for_each_brick([&](const auto& brick)
+                         {
+                             for (unsigned int i = 0; i < brick.num_values(); ++i)
+                             {
+                                 if (_brick_local_to_image_grid_id(brick, i, gid))
+                                 { img(gid) = brick[i]; }
+                             }
+                         });
+      }
+
+    private:
+      template<typename TBrickView>
+      [[nodiscard]] bool _brick_local_to_image_grid_id(const TBrickView& brick, unsigned int localListId, std::vector<unsigned int>& gid) const
+      {
+          for (int d = static_cast<int>(num_dimensions()) - 1; d >= 0; --d)
+          {
+              const unsigned int l = localListId % _brick_size[d];
+              localListId /= _brick_size[d];
+
+              if (l >= brick.size()[d])
+              { return false; }
+
+              gid[d] = brick.origin()[d] + l;
+          }
+
+          return true;
+      }
+    public:
+      /// @}
+  }; // class BrickedImage
+} // namespace bk
+
+#endif //BKDATASET_BRICKEDIMAGE_H
@@ -0,0 +1,43 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_EIMAGECONNECTIVITY_H
+#define BKDATASET_EIMAGECONNECTIVITY_H
+
+#include <cstdint>
+
+namespace bk
+{
+  //! which grid neighbors are considered adjacent
+  enum class ImageConnectivity : std::uint8_t
+  {
+      Face = 1, // neighbors differ in 1 coordinate: 4 (2D), 6 (3D)
+      Edge = 2, // neighbors differ in up to 2 coordinates: 8 (2D), 18 (3D)
+      Full = 0 // neighbors differ in up to all coordinates: 8 (2D), 26 (3D)
+  };
+} // namespace bk
+
+#endif //BKDATASET_EIMAGECONNECTIVITY_H
@@ -28,14 +28,21 @@
 #define BK_IMAGE_H
 
 #include <algorithm>
+#include <any>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <limits>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <bk/Matrix>
 #include <bkMath/functions/list_grid_id_conversion.h>
@@ -53,9 +60,16 @@
 #include <bkDataset/transformation/WorldMatrixTransformation.h>
 #include <bkDataset/transformation/NoTransformation.h>
 #include <bkDataset/transformation/DicomTransformation.h>
+#include <bkDataset/image/EImageBoundaryMode.h>
+#include <bkDataset/image/ImageCache.h>
+#include <bkDataset/image/ImageExpression.h>
+#include <bkDataset/image/ImageNeighborhood.h>
+#include <bkDataset/image/ImageReduction.h>
+#include <bkDataset/image/RawImageFile.h>
 #include <bkDataset/image/filter/ConvolutionImageFilter.h>
 #include <bkDataset/image/interpolation/NearestNeighborImageInterpolation.h>
 #include <bkDataset/image/interpolation/LinearImageInterpolation.h>
+#include <bkDataset/image/interpolation/CubicBSplineImageInterpolation.h>
 
 #ifdef BK_LIB_PNG_AVAILABLE
 
@@ -86,6 +100,10 @@ namespace bk
       [[nodiscard]] static constexpr unsigned int NumDimensionsAtCompileTime()
       { return static_cast<unsigned int>(std::max(TDims, 0)); }
 
+      //! upper bound for run-time dimensionality in allocation-free index vectors (see grid_id_type)
+      [[nodiscard]] static constexpr unsigned int MaxNumDynamicDimensions()
+      { return 8; }
+
       [[nodiscard]] static constexpr const char* DefaultAttributeName()
       { return "default_image_value"; }
 
@@ -93,17 +111,75 @@ namespace bk
       { return bk::string_utils::hash(DefaultAttributeName()); }
       /// @}
 
+      //! grid coordinates without heap allocation: std::array or, for run-time dimensionality, InlineVector
+      template<typename T = unsigned int> using grid_id_type = std::conditional_t<(TDims > 0), std::array<T, NumDimensionsAtCompileTime()>, InlineVector<T, MaxNumDynamicDimensions()>>;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      //! cached pointer to the default value attribute inside the point attribute map
+      /*!
+       * - avoids the hash map lookup + any_cast on each voxel access
+       * - refreshed by set_size(), copy, move and swap
+       * - copies share the value buffer (copy-on-write, see AttributeMap); all non-const access detaches it
+       * - const access never copies
+       */
+      NDVector<value_type>* _values;
+      //! this image is the only owner of _values, so that writing via operator[] / operator() needs no further check
+      /*!
+       * - set by the first non-const element access (and detach()); cleared when values are assigned or resized
+       * - a copy of an owning image detaches its values immediately, so the source is never modified by the copy
+       */
+      bool _values_owned;
+      //! lazily computed data derived from the values (e.g. interpolation coefficients)
+      /*!
+       * - cleared by all bulk modifications (set_size(), assignment, math operators, set_constant(), load, ...)
+       *   and by the non-const entry points data(), span() and begin()/end()
+       * - writing single values via operator[] / operator() does not clear it; call invalidate_cache() afterwards
+       */
+      mutable ImageCache _cache;
+
       //====================================================================================================
       //===== CONSTRUCTORS & DESTRUCTOR
       //====================================================================================================
+    public:
       /// @{ -------------------------------------------------- CONSTRUCTORS
-      Image() = default;
-      Image(const self_type&) = default;
-      Image(self_type&&) noexcept = default;
+      Image()
+          : base_type(),
+            _values(nullptr),
+            _values_owned(false)
+      { /* do nothing */ }
+
+      Image(const self_type& other)
+          : base_type(other),
+            _values(nullptr),
+            _values_owned(false)
+      { _copy_values_from(other); }
+
+      Image(self_type&& other) noexcept
+          : base_type(std::move(other)),
+            _values(nullptr),
+            _values_owned(other._values_owned)
+      {
+          _update_value_cache();
+          other._update_value_cache();
+          other._values_owned = false;
+      }
 
       template<typename TValue_, int TDims_, typename TTransformation_>
       Image(const Image<TValue_, TDims_, TTransformation_>& other)
+          : base_type(),
+            _values(nullptr),
+            _values_owned(false)
       { *this = other; }
+
+      template<typename TExpr, std::enable_if_t<is_image_expression_v<TExpr>>* = nullptr>
+      Image(const TExpr& e)
+          : base_type(),
+            _values(nullptr),
+            _values_owned(false)
+      { *this = e; }
       /// @}
 
       /// @{ -------------------------------------------------- DESTRUCTOR
@@ -115,11 +191,67 @@ namespace bk
       //====================================================================================================
     private:
       /// @{ -------------------------------------------------- HELPER: GET VALUE ND VECTOR
+      //! detaches shared values
       [[nodiscard]] NDVector<value_type>& _value_vector()
-      { return this->template point_attribute_vector_of_type<value_type>(DefaultAttributeHash()); }
+      {
+          if (!_values_owned)
+          { _detach_values(); }
+
+          return *_values;
+      }
 
       [[nodiscard]] const NDVector<value_type>& _value_vector() const
-      { return this->template point_attribute_vector_of_type<value_type>(DefaultAttributeHash()); }
+      { return *_values; }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: UPDATE VALUE CACHE
+      //! does not detach shared values; writes go through _value_vector(), which detaches first
+      void _update_value_cache()
+      {
+          const auto& map = std::as_const(*this).point_attribute_map();
+          _values = map.has_attribute(DefaultAttributeHash()) ? const_cast<NDVector<value_type>*>(std::any_cast<NDVector<value_type>>(&map.attribute(DefaultAttributeHash()))) : nullptr;
+          _cache.clear();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: DETACH VALUES
+      //! not synchronized; see _own_values()
+      void _detach_values()
+      {
+          if (_values != nullptr && this->point_attribute_map().is_shared(DefaultAttributeHash()))
+          { _values = std::any_cast<NDVector<value_type>>(&this->point_attribute_map().attribute(DefaultAttributeHash())); }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: OWN VALUES
+      //! first non-const element access; may happen concurrently (e.g. inside a parallel loop)
+      void _own_values()
+      {
+          #pragma omp critical (image_own_values)
+          {
+              if (!_values_owned)
+              {
+                  _detach_values();
+                  std::atomic_thread_fence(std::memory_order_release);
+                  _values_owned = true;
+              }
+          }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: COPY VALUES
+      //! shares the values of other unless other owns them (its writes would be visible in this copy)
+      void _copy_values_from(const self_type& other)
+      {
+          _update_value_cache();
+          _values_owned = false;
+
+          if (other._values_owned)
+          {
+              _detach_values();
+              _values_owned = true;
+          }
+      }
       /// @}
 
       /// @{ -------------------------------------------------- HELPER: VALID NUMBER OF ARGUMENTS
@@ -131,18 +263,107 @@ namespace bk
       }
       /// @}
 
+      /// @{ -------------------------------------------------- HELPER: HAS FAST REDUCTION
+      //! vectorized kernels are used for arithmetic value types and the default comparator
+      template<typename TCompareLess>
+      [[nodiscard]] static constexpr bool _has_fast_reduction()
+      { return details::is_reducible_v<value_type> && (std::is_same_v<TCompareLess, std::less<value_type>> || std::is_same_v<TCompareLess, std::less<>>); }
+      /// @}
+
       /// @{ -------------------------------------------------- HELPER: HAS DEFAULT VALUE ATTRIBUTE
       [[nodiscard]] bool _has_default_value_attribute() const
-      { return this->point_attribute_map().has_attribute(DefaultAttributeHash()); }
+      { return _values != nullptr; }
       /// @}
     public:
 
       /// @{ -------------------------------------------------- GET DATA VECTOR
+      //! the values are stored in the point attribute map (DefaultAttributeHash())
+      /*!
+       * Do not replace/remove/access this attribute via point_attribute_map() directly,
+       * since this would invalidate the cached reference (or detach it without notice).
+       * Use set_size() instead.
+       */
       [[nodiscard]] NDVector<value_type>& data()
-      { return this->template point_attribute_vector_of_type<value_type>(DefaultAttributeHash()); }
+      {
+          assert(_has_default_value_attribute() && "call set_size() first");
+          _cache.clear();
+          return _value_vector();
+      }
 
       [[nodiscard]] const NDVector<value_type>& data() const
-      { return this->template point_attribute_vector_of_type<value_type>(DefaultAttributeHash()); }
+      {
+          assert(_has_default_value_attribute() && "call set_size() first");
+          return _value_vector();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET VALUE SPAN
+      //! contiguous view on all values (list id order) for tight loops
+      /*!
+       * The span is invalidated by set_size() with a different size.
+       */
+      [[nodiscard]] Span<value_type> span()
+      {
+          assert(_has_default_value_attribute() && "call set_size() first");
+          _cache.clear();
+          return Span<value_type>(_value_vector().data().data(), _value_vector().num_values());
+      }
+
+      [[nodiscard]] Span<const value_type> span() const
+      {
+          assert(_has_default_value_attribute() && "call set_size() first");
+          return Span<const value_type>(_value_vector().data().data(), _value_vector().num_values());
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET CACHED DATA
+      //! data derived from the values; create(const Image&) -> T is called once until the next modification
+      /*!
+       * Thread-safe. Used e.g. by CubicBSplineImageInterpolation for its coefficient image.
+       */
+      template<typename T, typename TFunction>
+      [[nodiscard]] std::shared_ptr<const T> cached(unsigned long long key, TFunction&& create) const
+      { return _cache.template get_or_create<T>(key, [&]() { return create(*this); }); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET RESCALE
+      //! stored values v represent v * rescale_slope() + rescale_intercept() (e.g. DICOM rescale slope/intercept)
+      /*!
+       * The rescale is object meta data. Compact value types (std::int16_t, std::uint16_t, Half)
+       * keep the stored values; rescaled_value() / rescaled() convert on read.
+       */
+      [[nodiscard]] bool has_rescale() const
+      { return this->object_attribute_map().has_attribute(attribute_info::rescale_slope()); }
+
+      [[nodiscard]] double rescale_slope() const
+      { return has_rescale() ? this->template object_attribute_value<attribute_info::rescale_slope()>() : 1.0; }
+
+      [[nodiscard]] double rescale_intercept() const
+      { return has_rescale() ? this->template object_attribute_value<attribute_info::rescale_intercept()>() : 0.0; }
+
+      [[nodiscard]] double rescaled_value(unsigned int listId) const
+      { return rescale_slope() * static_cast<double>(operator[](listId)) + rescale_intercept(); }
+
+      //! copy with rescaled values (and without rescale meta data)
+      template<typename T = double>
+      [[nodiscard]] Image<T, TDims, TTransformation> rescaled() const
+      {
+          Image<T, TDims, TTransformation> res;
+          res.set_size(size());
+          res.geometry().transformation() = this->geometry().transformation();
+
+          const double slope = rescale_slope();
+          const double intercept = rescale_intercept();
+          const value_type* src = _value_vector().data().data();
+          T* dst = res.span().data();
+          const int n = static_cast<int>(num_values());
+
+          #pragma omp parallel for simd
+          for (int i = 0; i < n; ++i)
+          { dst[i] = static_cast<T>(slope * static_cast<double>(src[i]) + intercept); }
+
+          return res;
+      }
       /// @}
 
       /// @{ -------------------------------------------------- IS VALID GRID POS
@@ -165,13 +386,36 @@ namespace bk
       /// @}
 
       /// @{ -------------------------------------------------- GET SIZE
-      [[nodiscard]] auto size() const
+      [[nodiscard]] const auto& size() const
       { return this->geometry().size(); }
 
       [[nodiscard]] unsigned int size(unsigned int dimId) const
       { return this->geometry().size(dimId); }
       /// @}
 
+      /// @{ -------------------------------------------------- GET GRID ID
+      //! zero-initialized index vector with num_dimensions() elements
+      template<typename T = unsigned int>
+      [[nodiscard]] grid_id_type<T> make_grid_id() const
+      {
+          if constexpr (TDims > 0)
+          { return grid_id_type<T>(); }
+          else
+          {
+              assert(num_dimensions() <= MaxNumDynamicDimensions() && "too many dimensions");
+              return grid_id_type<T>(num_dimensions(), T(0));
+          }
+      }
+
+      //! grid coordinates of the list id; does not allocate
+      [[nodiscard]] grid_id_type<> grid_id(unsigned int listId) const
+      {
+          grid_id_type<> gid = make_grid_id();
+          bk::list_to_grid_id_into(size(), num_dimensions(), listId, gid);
+          return gid;
+      }
+      /// @}
+
       /// @{ -------------------------------------------------- GET NUM VALUES
       [[nodiscard]] unsigned int num_values() const
       { // the total number of pixels
@@ -183,7 +427,11 @@ namespace bk
       [[nodiscard]] value_type& operator[](unsigned int id)
       {
           assert(_has_default_value_attribute() && "call set_size() first");
-          return _value_vector()[id];
+
+          if (!_values_owned)
+          { _own_values(); }
+
+          return (*_values)[id];
       }
 
       [[nodiscard]] const value_type& operator[](unsigned int id) const
@@ -200,7 +448,10 @@ namespace bk
           static_assert(_valid_num_arguments(ids...));
           assert(_has_default_value_attribute() && "call set_size() first");
 
-          return this->template point_attribute_value_of_type<value_type>(DefaultAttributeHash(), ids...);
+          if (!_values_owned)
+          { _own_values(); }
+
+          return (*_values)(ids...);
       }
 
       template<typename... TIds>
@@ -209,7 +460,7 @@ namespace bk
           static_assert(_valid_num_arguments(ids...));
           assert(_has_default_value_attribute() && "call set_size() first");
 
-          return this->template point_attribute_value_of_type<value_type>(DefaultAttributeHash(), ids...);
+          return _value_vector()(ids...);
       }
       /// @}
 
@@ -217,6 +468,7 @@ namespace bk
       [[nodiscard]] auto begin()
       {
           assert(_has_default_value_attribute() && "call set_size() first");
+          _cache.clear();
           return _value_vector().begin();
       }
 
@@ -235,6 +487,7 @@ namespace bk
       [[nodiscard]] auto end()
       {
           assert(_has_default_value_attribute() && "call set_size() first");
+          _cache.clear();
           return _value_vector().end();
       }
 
@@ -253,6 +506,7 @@ namespace bk
       [[nodiscard]] auto rbegin()
       {
           assert(_has_default_value_attribute() && "call set_size() first");
+          _cache.clear();
           return _value_vector().rbegin();
       }
 
@@ -271,6 +525,7 @@ namespace bk
       [[nodiscard]] auto rend()
       {
           assert(_has_default_value_attribute() && "call set_size() first");
+          _cache.clear();
           return _value_vector().rend();
       }
 
@@ -304,7 +559,9 @@ namespace bk
       {
           assert(_has_default_value_attribute() && "call set_size() first");
 
-          if (num_values() == 0)
+          if constexpr (_has_fast_reduction<TCompareLess>())
+          { return details::reduce_min(_value_vector().data().data(), num_values()); }
+          else if (num_values() == 0)
           { return value_type(); }
           else
           {
@@ -323,7 +580,7 @@ namespace bk
           assert(_has_default_value_attribute() && "call set_size() first");
 
           if (num_values() == 0)
-          { return value_type(); }
+          { return std::pair<value_type, unsigned int>(value_type(), 0); }
           else
           {
               value_type x = (*this)[0];
@@ -331,7 +588,7 @@ namespace bk
 
               for (unsigned int i = 1; i < num_values(); ++i)
               {
-                  if ((*this)[i] < x)
+                  if (comp((*this)[i], x))
                   {
                       x = (*this)[i];
                       listId = i;
@@ -387,7 +644,9 @@ namespace bk
       {
           assert(_has_default_value_attribute() && "call set_size() first");
 
-          if (num_values() == 0)
+          if constexpr (_has_fast_reduction<TCompareLess>())
+          { return details::reduce_max(_value_vector().data().data(), num_values()); }
+          else if (num_values() == 0)
           { return value_type(); }
           else
           {
@@ -406,7 +665,7 @@ namespace bk
           assert(_has_default_value_attribute() && "call set_size() first");
 
           if (num_values() == 0)
-          { return value_type(); }
+          { return std::pair<value_type, unsigned int>(value_type(), 0); }
           else
           {
               value_type x = (*this)[0];
@@ -414,7 +673,7 @@ namespace bk
 
               for (unsigned int i = 1; i < num_values(); ++i)
               {
-                  if ((*this)[i] < x)
+                  if (comp(x, (*this)[i]))
                   {
                       x = (*this)[i];
                       listId = i;
@@ -462,94 +721,144 @@ namespace bk
       [[nodiscard]] auto minmax_element_iterator(TCompareLess comp = TCompareLess())
       {
           assert(_has_default_value_attribute() && "call set_size() first");
-          return {min_element_iterator(comp), max_element_iterator(comp)};
+          return std::minmax_element(begin(), end(), comp);
       }
 
+      //! single pass over the data
       template<typename TCompareLess = std::less<value_type>>
       [[nodiscard]] std::pair<value_type, value_type> minmax_value(TCompareLess comp = TCompareLess()) const
       {
           assert(_has_default_value_attribute() && "call set_size() first");
-          return {min_value(comp), max_value(comp)};
+
+          if constexpr (_has_fast_reduction<TCompareLess>())
+          { return details::reduce_minmax(_value_vector().data().data(), num_values()); }
+          else if (num_values() == 0)
+          { return {value_type(), value_type()}; }
+          else
+          {
+              value_type xmin = (*this)[0];
+              value_type xmax = xmin;
+
+              for (unsigned int i = 1; i < num_values(); ++i)
+              {
+                  const value_type& x = (*this)[i];
+
+                  if (comp(x, xmin))
+                  { xmin = x; }
+                  else if (comp(xmax, x))
+                  { xmax = x; }
+              }
+
+              return {xmin, xmax};
+          }
       }
       /// @}
 
-      /// @{ -------------------------------------------------- HELPER: GET NEIGHBORHOOD VALUES
-    private:
-      template<typename TIndexAccessible, typename TIndexAccessible2, typename TIndexAccessible3>
-      void _values_of_neighborhood(unsigned int dimId, const TIndexAccessible& gid, TIndexAccessible2& off, TIndexAccessible3& neighborhood_size, std::vector<value_type>& values) const
+      /// @{ -------------------------------------------------- GET SUM
+      //! arithmetic types are accumulated in double
+      [[nodiscard]] auto sum_value() const
       {
-          const int halfsize = neighborhood_size[dimId] >> 1; // integer division
+          assert(_has_default_value_attribute() && "call set_size() first");
 
-          if (dimId < num_dimensions() - 1)
-          {
-              for (int i = -halfsize; i <= halfsize; ++i)
-              {
-                  off[dimId] = i;
-                  _values_of_neighborhood(dimId + 1, gid, off, neighborhood_size, values);
-              } // for i
-          }
+          if constexpr (details::is_reducible_v<value_type>)
+          { return details::reduce_sum(_value_vector().data().data(), num_values()); }
           else
           {
-              for (int i = -halfsize; i <= halfsize; ++i)
-              {
-                  off[dimId] = i;
+              value_type s = num_values() != 0 ? (*this)[0] : value_type();
 
-                  auto gidoff = MatrixFactory::create<int, NumDimensionsAtCompileTime(), 1>(num_dimensions(), 1);
-                  bool valid = true;
+              for (unsigned int i = 1; i < num_values(); ++i)
+              { s += (*this)[i]; }
 
-                  for (unsigned int d = 0; d < num_dimensions(); ++d)
-                  {
-                      gidoff[d] = gid[d] + off[d];
+              return s;
+          }
+      }
+      /// @}
 
-                      if (static_cast<int>(gidoff[d]) < 0 || static_cast<int>(gidoff[d]) >= static_cast<int>(size(dimId)))
-                      {
-                          valid = false;
-                          break;
-                      }
-                  }
+      /// @{ -------------------------------------------------- GET MEAN
+      [[nodiscard]] auto mean_value() const
+      {
+          assert(_has_default_value_attribute() && "call set_size() first");
 
-                  if (valid)
-                  { values.push_back(operator()(gidoff)); }
-              } // for i
-          }
+          if constexpr (details::is_reducible_v<value_type>)
+          { return details::reduce_mean_variance(_value_vector().data().data(), num_values()).first; }
+          else
+          { return num_values() != 0 ? value_type(sum_value() / static_cast<double>(num_values())) : value_type(); }
       }
+      /// @}
 
-    public:
+      /// @{ -------------------------------------------------- GET VARIANCE
+      //! population variance (divided by the number of values)
+      [[nodiscard]] auto variance_value() const
+      {
+          static_assert(details::is_reducible_v<value_type>, "variance is only available for arithmetic value types");
+          assert(_has_default_value_attribute() && "call set_size() first");
+
+          return details::reduce_mean_variance(_value_vector().data().data(), num_values()).second;
+      }
+
+      //! single pass; returns {mean, variance}
+      [[nodiscard]] auto mean_and_variance_value() const
+      {
+          static_assert(details::is_reducible_v<value_type>, "variance is only available for arithmetic value types");
+          assert(_has_default_value_attribute() && "call set_size() first");
+
+          return details::reduce_mean_variance(_value_vector().data().data(), num_values());
+      }
       /// @}
 
       /// @{ -------------------------------------------------- GET NEIGHBORHOOD VALUES
+      //! values of all neighbors inside the image (neighbors outside of the image are omitted)
+      /*!
+       * Use ImageNeighborhood directly when iterating over many positions to avoid per-call allocations.
+       */
       template<typename TIndexAccessible, typename TIndexAccessible2, std::enable_if_t<bk::has_index_operator_v<TIndexAccessible> && bk::has_index_operator_v<TIndexAccessible2>>* = nullptr>
       [[nodiscard]] std::vector<value_type> values_of_neighborhood(const TIndexAccessible& gid, const TIndexAccessible2& neighborhood_size) const
+      { return values_of_neighborhood(bk::grid_to_list_id(size(), gid, num_dimensions()), neighborhood_size); }
+
+      template<typename TIndexAccessible, std::enable_if_t<bk::has_index_operator_v<TIndexAccessible>>* = nullptr>
+      [[nodiscard]] std::vector<value_type> values_of_neighborhood(unsigned int listId, const TIndexAccessible& neighborhood_size) const
       {
-          auto gidoff = MatrixFactory::create<int, NumDimensionsAtCompileTime(), 1>(num_dimensions(), 1);
+          ImageNeighborhood nb(size(), neighborhood_size, ImageBoundaryMode::Skip);
+          nb.set_position(listId);
 
-          std::vector<value_type> neighbor_values;
-          const unsigned int numValuesInNeighborhood = std::accumulate(neighborhood_size.begin(), neighborhood_size.end(), 1, [](unsigned int x, unsigned int y)
-          { return x * y; });
-
-          if (numValuesInNeighborhood > 0)
-          {
-              neighbor_values.reserve(numValuesInNeighborhood);
-              _values_of_neighborhood(0, gid, gidoff, neighborhood_size, neighbor_values);
-          }
+          std::vector<value_type> neighbor_values(nb.num_values());
+          neighbor_values.resize(nb.gather(*this, neighbor_values.data()));
 
           return neighbor_values;
       }
 
-      template<typename TIndexAccessible, std::enable_if_t<bk::has_index_operator_v<TIndexAccessible>>* = nullptr>
-      [[nodiscard]] std::vector<value_type> values_of_neighborhood(unsigned int listId, const TIndexAccessible& neighborhood_size) const
-      { return values_of_neighborhood(bk::list_to_grid_id(size(), listId), neighborhood_size); }
-
       [[nodiscard]] std::vector<value_type> values_of_neighborhood(unsigned int listId, unsigned int neighborhood_size) const
-      { return values_of_neighborhood(bk::list_to_grid_id(size(), listId), MatrixFactory::Constant<unsigned int, TDims, 1>(neighborhood_size, num_dimensions(), 1)); }
+      { return values_of_neighborhood(listId, MatrixFactory::Constant<unsigned int, TDims, 1>(neighborhood_size, num_dimensions(), 1)); }
       /// @}
 
       //====================================================================================================
       //===== SETTER
       //====================================================================================================
       /// @{ -------------------------------------------------- OPERATOR =
-      [[maybe_unused]] self_type& operator=(const self_type&) = default;
-      [[maybe_unused]] self_type& operator=(self_type&&) noexcept = default;
+      [[maybe_unused]] self_type& operator=(const self_type& other)
+      {
+          if (this != &other)
+          {
+              base_type::operator=(other);
+              _copy_values_from(other);
+          }
+
+          return *this;
+      }
+
+      [[maybe_unused]] self_type& operator=(self_type&& other) noexcept
+      {
+          if (this != &other)
+          {
+              base_type::operator=(std::move(other));
+              _update_value_cache();
+              _values_owned = other._values_owned;
+              other._update_value_cache();
+              other._values_owned = false;
+          }
+
+          return *this;
+      }
 
       template<typename TValue_, int TDims_, typename TTransformation_>
       [[maybe_unused]] self_type& operator=(const Image<TValue_, TDims_, TTransformation_>& other)
@@ -558,6 +867,31 @@ namespace bk
 
           set_size(other.size());
           std::copy(other.cbegin(), other.cend(), begin());
+          _cache.clear();
+
+          if (other.has_rescale())
+          { set_rescale(other.rescale_slope(), other.rescale_intercept()); }
+          else
+          { remove_rescale(); }
+
+          return *this;
+      }
+
+      //! evaluates the expression in a single parallel pass without temporaries
+      template<typename TExpr, std::enable_if_t<is_image_expression_v<TExpr>>* = nullptr>
+      [[maybe_unused]] self_type& operator=(const TExpr& e)
+      {
+          static_assert(TDims == TExpr::NumDimensionsAtCompileTime() || TDims == -1 || TExpr::NumDimensionsAtCompileTime() == -1, "dimension mismatch");
+
+          e.init_result(*this);
+          _cache.clear();
+
+          value_type* dst = _value_vector().data().data();
+          const int n = static_cast<int>(num_values());
+
+          #pragma omp parallel for simd
+          for (int i = 0; i < n; ++i)
+          { dst[i] = static_cast<value_type>(e[i]); }
 
           return *this;
       }
@@ -606,7 +940,9 @@ namespace bk
           {
               this->geometry().set_size(ids...);
               this->topology().set_size(ids...);
-              this->template add_point_attribute_vector_of_type<value_type>(DefaultAttributeHash());
+              _values = &this->template add_point_attribute_vector_of_type<value_type>(DefaultAttributeHash());
+              _values_owned = false;
+              _cache.clear();
           }
       }
       /// @}
@@ -614,7 +950,40 @@ namespace bk
       /// @{ -------------------------------------------------- SET CONSTANT
       //! sets each element to a given value
       void set_constant(const value_type& x)
-      { _value_vector().fill(x); }
+      {
+          _value_vector().fill(x);
+          _cache.clear();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- DETACH
+      //! copies all buffers that are shared with copies of this image (see DataObject::detach())
+      void detach()
+      {
+          base_type::detach();
+          _update_value_cache();
+          _values_owned = _values != nullptr;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- INVALIDATE CACHE
+      //! must be called after modifying single values if cached data (see cached()) is used
+      void invalidate_cache()
+      { _cache.clear(); }
+      /// @}
+
+      /// @{ -------------------------------------------------- SET RESCALE
+      void set_rescale(double slope, double intercept)
+      {
+          this->template add_object_attribute<attribute_info::rescale_slope()>() = slope;
+          this->template add_object_attribute<attribute_info::rescale_intercept()>() = intercept;
+      }
+
+      void remove_rescale()
+      {
+          this->remove_object_attribute(attribute_info::rescale_slope());
+          this->remove_object_attribute(attribute_info::rescale_intercept());
+      }
       /// @}
 
       //====================================================================================================
@@ -644,7 +1013,7 @@ namespace bk
 
       /// @{ -------------------------------------------------- SWAP
       template<typename TValue_, int TDims_, typename TTransformation_>
-      void swap(const Image<TValue_, TDims_, TTransformation_>& other)
+      void swap(Image<TValue_, TDims_, TTransformation_>& other)
       {
           static_assert(NumDimensionsAtCompileTime() == TDims_ || NumDimensionsAtCompileTime() == -1 || TDims_ == -1, "dimension mismatch");
 
@@ -653,6 +1022,13 @@ namespace bk
           other = std::move(temp);
       }
 
+      void swap(self_type& other)
+      {
+          self_type temp(std::move(*this));
+          *this = std::move(other);
+          other = std::move(temp);
+      }
+
       void swap(self_type&& other)
       { *this = std::move(other); }
       /// @}
@@ -687,6 +1063,11 @@ namespace bk
       template<typename T, typename TInterpolator = LinearImageInterpolation>
       [[nodiscard]] auto interpolate_at_grid_pos(std::initializer_list<T> grid_pos, TInterpolator interp = TInterpolator()) const
       { return interp(*this, std::vector<T>(grid_pos.begin(), grid_pos.end())); }
+
+      //! batch version: out[i] = interpolation at grid_pos[i] (parallelized)
+      template<typename TPos, typename TOut, typename TInterpolator = LinearImageInterpolation>
+      void interpolate_at_grid_pos(Span<TPos> grid_pos, Span<TOut> out, TInterpolator interp = TInterpolator()) const
+      { interp(*this, grid_pos, out); }
       /// @}
 
       /// @{ -------------------------------------------------- INTERPOLATE WORLD POS
@@ -827,7 +1208,7 @@ namespace bk
                   off[dimId] = i;
                   kernel_gid[dimId] = i + halfsize;
 
-                  auto gidoff = MatrixFactory::create<int, NumDimensionsAtCompileTime(), 1>(num_dimensions(), 1);
+                  auto gidoff = make_grid_id<int>();
 
                   for (unsigned int d = 0; d < num_dimensions(); ++d)
                   { gidoff[d] = gid[d] + off[d]; }
@@ -847,8 +1228,8 @@ namespace bk
       template<typename TKernel, typename TIndexAccessible>
       [[nodiscard]] auto apply_convolution_kernel(const TKernel& kernel, const TIndexAccessible& gid) const
       {
-          auto gidoff = MatrixFactory::create<int, NumDimensionsAtCompileTime(), 1>(num_dimensions(), 1);
-          auto kernel_gid = MatrixFactory::create<int, NumDimensionsAtCompileTime(), 1>(num_dimensions(), 1);
+          auto gidoff = make_grid_id<int>();
+          auto kernel_gid = make_grid_id<int>();
           auto res = allocate_value<double>();
 
           _apply_convolution_kernel(0, kernel, gid, gidoff, kernel_gid, res);
@@ -889,16 +1270,29 @@ namespace bk
           static_assert(TDims == TDims_ || TDims == -1 || TDims_ == -1, "dimension mismatch");
           assert(size() == other.size() && "size mismatch");
 
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) += other[i]; }
+          _cache.clear();
+          details::transform_inplace(_value_vector().data().data(), other.span().data(), num_values(), std::plus<>());
       }
 
       void operator+=(const value_type& x)
       {
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) += x; }
+          _cache.clear();
+          details::transform_inplace_scalar(_value_vector().data().data(), x, num_values(), std::plus<>());
+      }
+
+      template<typename TExpr, std::enable_if_t<is_image_expression_v<TExpr>>* = nullptr>
+      void operator+=(const TExpr& e)
+      {
+          static_assert(TDims == TExpr::NumDimensionsAtCompileTime() || TDims == -1 || TExpr::NumDimensionsAtCompileTime() == -1, "dimension mismatch");
+          assert(num_values() == e.num_values() && "size mismatch");
+
+          _cache.clear();
+          value_type* dst = _value_vector().data().data();
+          const int n = static_cast<int>(num_values());
+
+          #pragma omp parallel for simd
+          for (int i = 0; i < n; ++i)
+          { dst[i] += e[i]; }
       }
       /// @}
 
@@ -909,16 +1303,29 @@ namespace bk
           static_assert(TDims == TDims_ || TDims == -1 || TDims_ == -1, "dimension mismatch");
           assert(size() == other.size() && "size mismatch");
 
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) -= other[i]; }
+          _cache.clear();
+          details::transform_inplace(_value_vector().data().data(), other.span().data(), num_values(), std::minus<>());
       }
 
       void operator-=(const value_type& x)
       {
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) -= x; }
+          _cache.clear();
+          details::transform_inplace_scalar(_value_vector().data().data(), x, num_values(), std::minus<>());
+      }
+
+      template<typename TExpr, std::enable_if_t<is_image_expression_v<TExpr>>* = nullptr>
+      void operator-=(const TExpr& e)
+      {
+          static_assert(TDims == TExpr::NumDimensionsAtCompileTime() || TDims == -1 || TExpr::NumDimensionsAtCompileTime() == -1, "dimension mismatch");
+          assert(num_values() == e.num_values() && "size mismatch");
+
+          _cache.clear();
+          value_type* dst = _value_vector().data().data();
+          const int n = static_cast<int>(num_values());
+
+          #pragma omp parallel for simd
+          for (int i = 0; i < n; ++i)
+          { dst[i] -= e[i]; }
       }
       /// @}
 
@@ -929,16 +1336,29 @@ namespace bk
           static_assert(TDims == TDims_ || TDims == -1 || TDims_ == -1, "dimension mismatch");
           assert(size() == other.size() && "size mismatch");
 
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) *= other[i]; }
+          _cache.clear();
+          details::transform_inplace(_value_vector().data().data(), other.span().data(), num_values(), std::multiplies<>());
       }
 
       void operator*=(const value_type& x)
       {
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) *= x; }
+          _cache.clear();
+          details::transform_inplace_scalar(_value_vector().data().data(), x, num_values(), std::multiplies<>());
+      }
+
+      template<typename TExpr, std::enable_if_t<is_image_expression_v<TExpr>>* = nullptr>
+      void operator*=(const TExpr& e)
+      {
+          static_assert(TDims == TExpr::NumDimensionsAtCompileTime() || TDims == -1 || TExpr::NumDimensionsAtCompileTime() == -1, "dimension mismatch");
+          assert(num_values() == e.num_values() && "size mismatch");
+
+          _cache.clear();
+          value_type* dst = _value_vector().data().data();
+          const int n = static_cast<int>(num_values());
+
+          #pragma omp parallel for simd
+          for (int i = 0; i < n; ++i)
+          { dst[i] *= e[i]; }
       }
       /// @}
 
@@ -949,22 +1369,133 @@ namespace bk
           static_assert(TDims == TDims_ || TDims == -1 || TDims_ == -1, "dimension mismatch");
           assert(size() == other.size() && "size mismatch");
 
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) /= other[i]; }
+          _cache.clear();
+          details::transform_inplace(_value_vector().data().data(), other.span().data(), num_values(), std::divides<>());
       }
 
       void operator/=(const value_type& x)
       {
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < num_values(); ++i)
-          { operator[](i) /= x; }
+          _cache.clear();
+          details::transform_inplace_scalar(_value_vector().data().data(), x, num_values(), std::divides<>());
+      }
+
+      template<typename TExpr, std::enable_if_t<is_image_expression_v<TExpr>>* = nullptr>
+      void operator/=(const TExpr& e)
+      {
+          static_assert(TDims == TExpr::NumDimensionsAtCompileTime() || TDims == -1 || TExpr::NumDimensionsAtCompileTime() == -1, "dimension mismatch");
+          assert(num_values() == e.num_values() && "size mismatch");
+
+          _cache.clear();
+          value_type* dst = _value_vector().data().data();
+          const int n = static_cast<int>(num_values());
+
+          #pragma omp parallel for simd
+          for (int i = 0; i < n; ++i)
+          { dst[i] /= e[i]; }
       }
       /// @}
 
       //====================================================================================================
       //===== I/O
       //====================================================================================================
+      /// @{ -------------------------------------------------- SAVE RAW
+      //! saves size, transformation, values and all other point attributes of type NDVector<value_type> (see RawImageFile)
+      [[maybe_unused]] bool save_raw(std::string_view filepath) const
+      {
+          static_assert(RawImageFile::is_storable<value_type>(), "save_raw requires a trivially copyable value type or a static matrix thereof");
+
+          if (!_has_default_value_attribute())
+          { return false; }
+
+          /*
+           * check filename
+           */
+          std::string fname(filepath);
+          const std::string suffix = RawImageFile::Suffix();
+
+          if (fname.empty())
+          { fname = "image" + suffix; }
+          else if (!bk::string_utils::ends_with(fname, suffix))
+          { fname.append(suffix); }
+
+          /*
+           * collect attributes
+           */
+          std::vector<RawImageFile::Attribute> attributes;
+
+          for (const auto&[hash, attrib]: this->point_attribute_map())
+          {
+              if (const NDVector<value_type>* v = std::any_cast<NDVector<value_type>>(attrib.get()); v != nullptr && v->num_values() == num_values())
+              { attributes.push_back({hash, 0, num_values() * sizeof(value_type), reinterpret_cast<const char*>(v->data().data())}); }
+          }
+
+          std::vector<unsigned int> s(num_dimensions());
+
+          for (unsigned int dimId = 0; dimId < num_dimensions(); ++dimId)
+          { s[dimId] = size(dimId); }
+
+          return RawImageFile::save<value_type>(fname, s, this->geometry().transformation(), attributes);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- LOAD RAW
+      //! loads a file written by save_raw()
+      /*!
+       * The file is memory-mapped, but each attribute array is copied once into the image, i.e.,
+       * this is not a zero-copy load. For read-only access without copying, keep a RawImageFile
+       * open and use RawImageFile::values<T>(), which views the mapped memory directly.
+       */
+      [[maybe_unused]] bool load_raw(std::string_view filepath)
+      {
+          RawImageFile file;
+
+          if (!file.open(filepath) || !file.template value_type_matches<value_type>())
+          { return false; }
+
+          if (TDims != -1 && file.num_dimensions() != num_dimensions())
+          { return false; }
+
+          if (!file.has_attribute(DefaultAttributeHash()))
+          { return false; }
+
+          set_size(file.size());
+          _cache.clear();
+
+          for (const RawImageFile::Attribute& a: file.attributes())
+          {
+              if constexpr (bk::is_static_matrix_v<value_type>)
+              {
+                  // stored as contiguous elements
+                  const auto src = file.template component_values<value_type>(a.hash);
+
+                  if (src.empty())
+                  { continue; }
+
+                  NDVector<value_type>& dst = a.hash == DefaultAttributeHash() ? _value_vector() : this->template add_point_attribute_vector_of_type<value_type>(a.hash);
+                  const unsigned int numElements = value_type::RowsAtCompileTime() * value_type::ColsAtCompileTime();
+
+                  for (unsigned int i = 0; i < num_values(); ++i)
+                  {
+                      for (unsigned int k = 0; k < numElements; ++k)
+                      { dst[i][k] = src[i * numElements + k]; }
+                  }
+              }
+              else
+              {
+                  const Span<const value_type> src = file.template values<value_type>(a.hash);
+
+                  if (src.empty())
+                  { continue; }
+
+                  NDVector<value_type>& dst = a.hash == DefaultAttributeHash() ? _value_vector() : this->template add_point_attribute_vector_of_type<value_type>(a.hash);
+                  std::copy(src.begin(), src.end(), dst.data().begin());
+              }
+          }
+
+          return file.load_transformation(this->geometry().transformation());
+      }
+      /// @}
+
       #ifdef BK_LIB_PNG_AVAILABLE
       /// @{ -------------------------------------------------- HELPERS: SAVE PNG
     private:
@@ -1178,6 +1709,8 @@ namespace bk
       /// @{ -------------------------------------------------- LOAD PNG
       [[maybe_unused]] bool load_png(std::string_view filepath)
       {
+          _cache.clear();
+
           if (filepath.empty())
           {
               std::cerr << "load_png: empty file path" << std::endl;
@@ -1338,247 +1871,6 @@ namespace bk
   template<typename TValue, int TDims> using RegularImage = Image<TValue, TDims, ScaleTransformation<TDims>>;
   template<typename TValue, int TDims> using WorldImage = Image<TValue, TDims, WorldMatrixTransformation<TDims>>;
   template<typename TValue, int TDims> using DicomImage = Image<TValue, TDims, DicomTransformation>;
-
-  //====================================================================================================
-  //===== OPERATORS
-  //====================================================================================================
-  /// @{ -------------------------------------------------- OPERATOR +
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator+(const Image<TValue0, TDims0, TTransformation>& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      Image<common_value_type, std::max(TDims0, TDims1), TTransformation> res = a;
-      res += b;
-
-      return res;
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator+(Image<TValue0, TDims0, TTransformation>&& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue0, common_value_type>)
-      {
-          a += b;
-          return a;
-      }
-      else
-      { return a + b; }
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator+(const Image<TValue0, TDims0, TTransformation>& a, Image<TValue1, TDims1, TTransformation>&& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue1, common_value_type>)
-      {
-          b += a;
-          return b;
-      }
-      else
-      { return a + b; }
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator+(Image<TValue0, TDims0, TTransformation>&& a, Image<TValue1, TDims1, TTransformation>&& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue0, common_value_type>)
-      { return std::move(a) + b; }
-      else if constexpr (std::is_same_v<TValue1, common_value_type>)
-      { return std::move(b) + a; }
-      else
-      { return a + b; }
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator+(const Image<TValue, TDims, TTransformation>& img, const T& x)
-  {
-      Image<TValue, TDims, TTransformation> res = img;
-      res += x;
-      return res;
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator+(Image<TValue, TDims, TTransformation>&& img, const T& x)
-  {
-      img += x;
-      return std::move(img);
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator+(const T& x, const Image<TValue, TDims, TTransformation>& img)
-  { return img + x; }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator+(const T& x, Image<TValue, TDims, TTransformation>&& img)
-  { return std::move(img) + x; }
-  /// @}
-
-  /// @{ -------------------------------------------------- OPERATOR -
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator-(const Image<TValue0, TDims0, TTransformation>& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      Image<common_value_type, std::max(TDims0, TDims1), TTransformation> res = a;
-      res -= b;
-
-      return res;
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator-(Image<TValue0, TDims0, TTransformation>&& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue0, common_value_type>)
-      {
-          a -= b;
-          return a;
-      }
-      else
-      { return a - b; }
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator-(const Image<TValue, TDims, TTransformation>& img, const T& x)
-  {
-      Image<TValue, TDims, TTransformation> res = img;
-      res -= x;
-      return res;
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator-(Image<TValue, TDims, TTransformation>&& img, const T& x)
-  {
-      img -= x;
-      return std::move(img);
-  }
-  /// @}
-
-  /// @{ -------------------------------------------------- OPERATOR *
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator*(const Image<TValue0, TDims0, TTransformation>& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      Image<common_value_type, std::max(TDims0, TDims1), TTransformation> res = a;
-      res *= b;
-
-      return res;
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator*(Image<TValue0, TDims0, TTransformation>&& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue0, common_value_type>)
-      {
-          a *= b;
-          return a;
-      }
-      else
-      { return a * b; }
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator*(const Image<TValue0, TDims0, TTransformation>& a, Image<TValue1, TDims1, TTransformation>&& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue1, common_value_type>)
-      {
-          b *= a;
-          return b;
-      }
-      else
-      { return a * b; }
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator*(Image<TValue0, TDims0, TTransformation>&& a, Image<TValue1, TDims1, TTransformation>&& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue0, common_value_type>)
-      { return std::move(a) * b; }
-      else if constexpr (std::is_same_v<TValue1, common_value_type>)
-      { return std::move(b) * a; }
-      else
-      { return a * b; }
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator*(const Image<TValue, TDims, TTransformation>& img, const T& x)
-  {
-      Image<TValue, TDims, TTransformation> res = img;
-      res *= x;
-      return res;
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator*(Image<TValue, TDims, TTransformation>&& img, const T& x)
-  {
-      img *= x;
-      return std::move(img);
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator*(const T& x, const Image<TValue, TDims, TTransformation>& img)
-  { return img * x; }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator*(const T& x, Image<TValue, TDims, TTransformation>&& img)
-  { return std::move(img) * x; }
-  /// @}
-
-  /// @{ -------------------------------------------------- OPERATOR /
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator/(const Image<TValue0, TDims0, TTransformation>& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      Image<common_value_type, std::max(TDims0, TDims1), TTransformation> res = a;
-      res /= b;
-
-      return res;
-  }
-
-  template<typename TValue0, typename TValue1, int TDims0, int TDims1, typename TTransformation>
-  [[nodiscard]] auto operator/(Image<TValue0, TDims0, TTransformation>&& a, const Image<TValue1, TDims1, TTransformation>& b)
-  {
-      using common_value_type = std::common_type_t<TValue0, TValue1>;
-
-      if constexpr (std::is_same_v<TValue0, common_value_type>)
-      {
-          a /= b;
-          return a;
-      }
-      else
-      { return a / b; }
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator/(const Image<TValue, TDims, TTransformation>& img, const T& x)
-  {
-      Image<TValue, TDims, TTransformation> res = img;
-      res /= x;
-      return res;
-  }
-
-  template<typename TValue, int TDims, typename TTransformation, typename T>
-  [[nodiscard]] Image<TValue, TDims, TTransformation> operator/(Image<TValue, TDims, TTransformation>&& img, const T& x)
-  {
-      img /= x;
-      return std::move(img);
-  }
-  /// @}
 } // namespace bk
 
 #endif // BK_IMAGE_H  
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_IMAGECACHE_H
+#define BKDATASET_IMAGECACHE_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace bk
+{
+  //! thread-safe storage of data derived from an image (e.g. interpolation coefficients)
+  /*!
+   * - entries are created lazily on first request and shared via std::shared_ptr<const T>,
+   *   so a returned entry stays valid even if the cache is cleared afterwards
+   * - copies/moves of the owning image start with an empty cache
+   */
+  class ImageCache
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = ImageCache;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      mutable std::mutex _mutex;
+      std::unordered_map<unsigned long long, std::shared_ptr<const void>> _entries;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CONSTRUCTORS
+      ImageCache() = default;
+
+      ImageCache(const self_type&)
+          : ImageCache()
+      { /* do nothing */ }
+
+      ImageCache(self_type&&) noexcept
+          : ImageCache()
+      { /* do nothing */ }
+      /// @}
+
+      /// @{ -------------------------------------------------- DESTRUCTOR
+      ~ImageCache() = default;
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- IS EMPTY
+      [[nodiscard]] bool empty() const
+      {
+          std::lock_guard<std::mutex> lock(_mutex);
+          return _entries.empty();
+      }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] self_type& operator=(const self_type&)
+      {
+          clear();
+          return *this;
+      }
+
+      [[maybe_unused]] self_type& operator=(self_type&&) noexcept
+      {
+          clear();
+          return *this;
+      }
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET OR CREATE
+      //! returns the entry of the given key; calls create() (returning T) if it does not exist yet
+      /*!
+       * create() is called while the cache is locked, i.e. concurrent requests of
+       * the same entry compute it only once.
+       */
+      template<typename T, typename TFunction>
+      [[nodiscard]] std::shared_ptr<const T> get_or_create(unsigned long long key, TFunction&& create)
+      {
+          std::lock_guard<std::mutex> lock(_mutex);
+
+          if (auto it = _entries.find(key); it != _entries.end())
+          { return std::static_pointer_cast<const T>(it->second); }
+
+          std::shared_ptr<const T> entry = std::make_shared<const T>(create());
+          _entries.emplace(key, entry);
+
+          return entry;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- CLEAR
+      void clear() noexcept
+      {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _entries.clear();
+      }
+
+      void remove(unsigned long long key)
+      {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _entries.erase(key);
+      }
+      /// @}
+  }; // class ImageCache
+} // namespace bk
+
+#endif //BKDATASET_IMAGECACHE_H
@@ -0,0 +1,472 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_IMAGEEXPRESSION_H
+#define BKDATASET_IMAGEEXPRESSION_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include <bk/Matrix>
+
+namespace bk
+{
+  // -------------------- forward declaration
+  template<typename TValue, int TDims, typename TTransformation> class Image;
+  // -------------------- forward declaration END
+
+  //====================================================================================================
+  //===== TRAITS
+  //====================================================================================================
+  namespace details
+  {
+    struct ImageExpressionTag
+    { /* do nothing */ };
+
+    template<typename T> struct is_image : std::false_type
+    { /* do nothing */ };
+
+    template<typename TValue, int TDims, typename TTransformation> struct is_image<Image<TValue, TDims, TTransformation>> : std::true_type
+    {
+        static constexpr int num_dimensions = TDims;
+        using transformation_type = TTransformation;
+    };
+  } // namespace details
+
+  template<typename T> constexpr bool is_image_v = details::is_image<std::decay_t<T>>::value;
+  template<typename T> constexpr bool is_image_expression_v = std::is_base_of_v<details::ImageExpressionTag, std::decay_t<T>>;
+  template<typename T> constexpr bool is_image_or_image_expression_v = is_image_v<T> || is_image_expression_v<T>;
+
+  namespace details
+  {
+    //====================================================================================================
+    //===== OPERANDS
+    //====================================================================================================
+    //! image operand; lvalues are referenced, rvalues are moved into the expression
+    template<typename TImage, bool TOwning> class ImageExpressionTerminal : public ImageExpressionTag
+    {
+        using image_type = std::decay_t<TImage>;
+        std::conditional_t<TOwning, image_type, const image_type&> _img;
+
+      public:
+        using value_type = typename image_type::value_type;
+        using transformation_type = typename is_image<image_type>::transformation_type;
+        static constexpr bool IsScalar = false;
+
+        [[nodiscard]] static constexpr int NumDimensionsAtCompileTime()
+        { return is_image<image_type>::num_dimensions; }
+
+        template<typename T>
+        explicit ImageExpressionTerminal(T&& img)
+            : _img(std::forward<T>(img))
+        { /* do nothing */ }
+
+        [[nodiscard]] unsigned int num_values() const
+        { return _img.num_values(); }
+
+        [[nodiscard]] const value_type& operator[](unsigned int i) const
+        { return _img[i]; }
+
+        //! size (and transformation if the types match) of the result image; keeps the values if the size matches so that the result may alias an operand
+        template<typename TResultImage>
+        void init_result(TResultImage& res) const
+        {
+            bool hasCorrectSizeAlready = res.num_dimensions() == _img.num_dimensions();
+
+            for (unsigned int i = 0; hasCorrectSizeAlready && i < _img.num_dimensions(); ++i)
+            { hasCorrectSizeAlready = res.size(i) == _img.size(i); }
+
+            if (!hasCorrectSizeAlready)
+            { res.set_size(_img.size()); }
+
+            if constexpr (std::is_same_v<typename is_image<TResultImage>::transformation_type, transformation_type>)
+            {
+                if (static_cast<const void*>(&res) != static_cast<const void*>(&_img))
+                { res.geometry().transformation() = _img.geometry().transformation(); }
+            }
+        }
+    }; // class ImageExpressionTerminal
+
+    //! scalar operand
+    template<typename T> class ImageExpressionScalar
+    {
+        T _x;
+
+      public:
+        using value_type = T;
+        static constexpr bool IsScalar = true;
+
+        explicit ImageExpressionScalar(const T& x)
+            : _x(x)
+        { /* do nothing */ }
+
+        [[nodiscard]] const T& operator[](unsigned int /*i*/) const
+        { return _x; }
+    }; // class ImageExpressionScalar
+
+    //! wraps images into terminals; expressions are passed through
+    template<typename T>
+    [[nodiscard]] auto make_image_expression_operand(T&& x)
+    {
+        if constexpr (is_image_expression_v<T>)
+        { return std::decay_t<T>(std::forward<T>(x)); }
+        else
+        { return ImageExpressionTerminal<std::decay_t<T>, !std::is_lvalue_reference_v<T>>(std::forward<T>(x)); }
+    }
+
+    template<typename T> using image_expression_operand_t = decltype(make_image_expression_operand(std::declval<T>()));
+
+    //! scalars are converted to arithmetic value types (same as operator+=(value_type)); e.g. matrices keep the scalar type
+    template<typename TValue, typename TScalar> using image_expression_scalar_t = std::conditional_t<std::is_arithmetic_v<TValue>, TValue, std::decay_t<TScalar>>;
+
+    //====================================================================================================
+    //===== BINARY EXPRESSION
+    //====================================================================================================
+    template<typename TOp, typename TLhs, typename TRhs> class ImageExpressionBinary : public ImageExpressionTag
+    {
+        static_assert(!(TLhs::IsScalar && TRhs::IsScalar));
+
+        TLhs _lhs;
+        TRhs _rhs;
+
+        using image_operand_type = std::conditional_t<TLhs::IsScalar, TRhs, TLhs>;
+
+      public:
+        // image (op) image: common type; image (op) scalar: type of the image (same as operator+= etc.)
+        using value_type = std::conditional_t<TLhs::IsScalar || TRhs::IsScalar, typename image_operand_type::value_type, std::common_type_t<typename TLhs::value_type, typename TRhs::value_type>>;
+        using transformation_type = typename image_operand_type::transformation_type;
+        static constexpr bool IsScalar = false;
+
+        [[nodiscard]] static constexpr int NumDimensionsAtCompileTime()
+        {
+            if constexpr (TLhs::IsScalar)
+            { return TRhs::NumDimensionsAtCompileTime(); }
+            else if constexpr (TRhs::IsScalar)
+            { return TLhs::NumDimensionsAtCompileTime(); }
+            else
+            { return std::max(TLhs::NumDimensionsAtCompileTime(), TRhs::NumDimensionsAtCompileTime()); }
+        }
+
+        ImageExpressionBinary(TLhs&& lhs, TRhs&& rhs)
+            : _lhs(std::move(lhs)),
+              _rhs(std::move(rhs))
+        {
+            if constexpr (!TLhs::IsScalar && !TRhs::IsScalar)
+            { assert(_lhs.num_values() == _rhs.num_values() && "size mismatch"); }
+        }
+
+        [[nodiscard]] unsigned int num_values() const
+        {
+            if constexpr (TLhs::IsScalar)
+            { return _rhs.num_values(); }
+            else
+            { return _lhs.num_values(); }
+        }
+
+        [[nodiscard]] value_type operator[](unsigned int i) const
+        { return static_cast<value_type>(TOp::apply(_lhs[i], _rhs[i])); }
+
+        template<typename TResultImage>
+        void init_result(TResultImage& res) const
+        {
+            if constexpr (TLhs::IsScalar)
+            { _rhs.init_result(res); }
+            else
+            { _lhs.init_result(res); }
+        }
+    }; // class ImageExpressionBinary
+
+    //====================================================================================================
+    //===== UNARY EXPRESSION
+    //====================================================================================================
+    template<typename TOp, typename TArg> class ImageExpressionUnary : public ImageExpressionTag
+    {
+        TArg _arg;
+        TOp _op;
+
+      public:
+        using value_type = typename TArg::value_type;
+        using transformation_type = typename TArg::transformation_type;
+        static constexpr bool IsScalar = false;
+
+        [[nodiscard]] static constexpr int NumDimensionsAtCompileTime()
+        { return TArg::NumDimensionsAtCompileTime(); }
+
+        ImageExpressionUnary(TArg&& arg, TOp op = TOp())
+            : _arg(std::move(arg)),
+              _op(std::move(op))
+        { /* do nothing */ }
+
+        [[nodiscard]] unsigned int num_values() const
+        { return _arg.num_values(); }
+
+        [[nodiscard]] value_type operator[](unsigned int i) const
+        { return static_cast<value_type>(_op(_arg[i])); }
+
+        template<typename TResultImage>
+        void init_result(TResultImage& res) const
+        { _arg.init_result(res); }
+    }; // class ImageExpressionUnary
+
+    //====================================================================================================
+    //===== OPERATIONS
+    //====================================================================================================
+    struct ImageOpAdd
+    {
+        template<typename T0, typename T1>
+        [[nodiscard]] static constexpr auto apply(const T0& a, const T1& b)
+        { return a + b; }
+    };
+
+    struct ImageOpSubtract
+    {
+        template<typename T0, typename T1>
+        [[nodiscard]] static constexpr auto apply(const T0& a, const T1& b)
+        { return a - b; }
+    };
+
+    struct ImageOpMultiply
+    {
+        template<typename T0, typename T1>
+        [[nodiscard]] static constexpr auto apply(const T0& a, const T1& b)
+        { return a * b; }
+    };
+
+    struct ImageOpDivide
+    {
+        template<typename T0, typename T1>
+        [[nodiscard]] static constexpr auto apply(const T0& a, const T1& b)
+        { return a / b; }
+    };
+
+    struct ImageOpAbs
+    {
+        template<typename T>
+        [[nodiscard]] auto operator()(const T& x) const
+        {
+            if constexpr (bk::is_matrix_v<T>)
+            { return x.abs_cwise(); }
+            else if constexpr (std::is_unsigned_v<T>)
+            { return x; }
+            else
+            { return std::abs(x); }
+        }
+    };
+
+    struct ImageOpSqrt
+    {
+        template<typename T>
+        [[nodiscard]] auto operator()(const T& x) const
+        {
+            if constexpr (bk::is_matrix_v<T>)
+            { return x.sqrt_cwise(); }
+            else
+            { return std::sqrt(x); }
+        }
+    };
+
+    template<typename TBound> struct ImageOpClamp
+    {
+        TBound lo;
+        TBound hi;
+
+        template<typename T>
+        [[nodiscard]] auto operator()(const T& x) const
+        { return std::clamp(x, static_cast<T>(lo), static_cast<T>(hi)); }
+    };
+
+    //====================================================================================================
+    //===== HELPERS
+    //====================================================================================================
+    template<typename TOp, typename TLhs, typename TRhs>
+    [[nodiscard]] auto make_image_expression_binary(TLhs&& lhs, TRhs&& rhs)
+    {
+        if constexpr (!is_image_or_image_expression_v<TLhs>)
+        {
+            using rhs_type = image_expression_operand_t<TRhs>;
+            using scalar_type = image_expression_scalar_t<typename rhs_type::value_type, TLhs>;
+
+            return ImageExpressionBinary<TOp, ImageExpressionScalar<scalar_type>, rhs_type>(ImageExpressionScalar<scalar_type>(static_cast<scalar_type>(lhs)), make_image_expression_operand(std::forward<TRhs>(rhs)));
+        }
+        else if constexpr (!is_image_or_image_expression_v<TRhs>)
+        {
+            using lhs_type = image_expression_operand_t<TLhs>;
+            using scalar_type = image_expression_scalar_t<typename lhs_type::value_type, TRhs>;
+
+            return ImageExpressionBinary<TOp, lhs_type, ImageExpressionScalar<scalar_type>>(make_image_expression_operand(std::forward<TLhs>(lhs)), ImageExpressionScalar<scalar_type>(static_cast<scalar_type>(rhs)));
+        }
+        else
+        {
+            using lhs_type = image_expression_operand_t<TLhs>;
+            using rhs_type = image_expression_operand_t<TRhs>;
+
+            static_assert(lhs_type::NumDimensionsAtCompileTime() == rhs_type::NumDimensionsAtCompileTime() || lhs_type::NumDimensionsAtCompileTime() == -1 || rhs_type::NumDimensionsAtCompileTime() == -1, "dimension mismatch");
+
+            return ImageExpressionBinary<TOp, lhs_type, rhs_type>(make_image_expression_operand(std::forward<TLhs>(lhs)), make_image_expression_operand(std::forward<TRhs>(rhs)));
+        }
+    }
+
+    template<typename TLhs, typename TRhs> constexpr bool is_image_expression_binary_operands_v = is_image_or_image_expression_v<TLhs> || is_image_or_image_expression_v<TRhs>;
+
+    template<typename TExpr> using image_expression_result_t = Image<typename TExpr::value_type, TExpr::NumDimensionsAtCompileTime(), typename TExpr::transformation_type>;
+
+    //! evaluates an image (op) image/scalar expression right away; an rvalue image of the result type is reused as storage
+    template<typename TOp, typename TLhs, typename TRhs>
+    [[nodiscard]] auto evaluate_image_binary(TLhs&& lhs, TRhs&& rhs)
+    {
+        using expression_type = decltype(make_image_expression_binary<TOp>(std::declval<const std::decay_t<TLhs>&>(), std::declval<const std::decay_t<TRhs>&>()));
+        using result_type = image_expression_result_t<expression_type>;
+
+        if constexpr (std::is_same_v<std::decay_t<TLhs>, result_type> && !std::is_lvalue_reference_v<TLhs>)
+        {
+            lhs = make_image_expression_binary<TOp>(std::as_const(lhs), std::forward<TRhs>(rhs));
+            return std::move(lhs);
+        }
+        else if constexpr (std::is_same_v<std::decay_t<TRhs>, result_type> && !std::is_lvalue_reference_v<TRhs>)
+        {
+            rhs = make_image_expression_binary<TOp>(std::forward<TLhs>(lhs), std::as_const(rhs));
+            return std::move(rhs);
+        }
+        else
+        { return result_type(make_image_expression_binary<TOp>(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs))); }
+    }
+
+    //! lazy if one of the operands is an expression; images only are evaluated right away
+    template<typename TOp, typename TLhs, typename TRhs>
+    [[nodiscard]] auto image_binary(TLhs&& lhs, TRhs&& rhs)
+    {
+        if constexpr (is_image_expression_v<TLhs> || is_image_expression_v<TRhs>)
+        { return make_image_expression_binary<TOp>(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs)); }
+        else
+        { return evaluate_image_binary<TOp>(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs)); }
+    }
+
+    //! lazy if the argument is an expression; images are evaluated right away (rvalue images are reused as storage)
+    template<typename TOp, typename T>
+    [[nodiscard]] auto image_unary(T&& x, TOp op = TOp())
+    {
+        if constexpr (is_image_expression_v<T>)
+        { return ImageExpressionUnary<TOp, image_expression_operand_t<T>>(make_image_expression_operand(std::forward<T>(x)), std::move(op)); }
+        else if constexpr (!std::is_lvalue_reference_v<T>)
+        {
+            x = ImageExpressionUnary<TOp, image_expression_operand_t<const std::decay_t<T>&>>(make_image_expression_operand(std::as_const(x)), std::move(op));
+            return std::move(x);
+        }
+        else
+        {
+            using expression_type = ImageExpressionUnary<TOp, image_expression_operand_t<T>>;
+            return image_expression_result_t<expression_type>(expression_type(make_image_expression_operand(std::forward<T>(x)), std::move(op)));
+        }
+    }
+  } // namespace details
+
+  //====================================================================================================
+  //===== EVALUATION
+  //====================================================================================================
+  /// @{ -------------------------------------------------- EVAL
+  //! evaluates an expression into a new image (value type / transformation as deduced by the expression)
+  template<typename TExpr, std::enable_if_t<is_image_expression_v<TExpr>>* = nullptr>
+  [[nodiscard]] auto eval(const TExpr& e)
+  { return details::image_expression_result_t<TExpr>(e); }
+  /// @}
+
+  /// @{ -------------------------------------------------- LAZY
+  /*!
+   * opt-in to lazy evaluation: operators on the returned expression do not compute anything
+   * until the result is assigned to an Image (or passed to eval()), e.g.
+   *
+   *     Image<double, 3> c = lazy(a) * w + lazy(b) * (1 - w); // single pass, no temporaries
+   *
+   * - lvalue images are referenced, i.e., they must outlive the expression (beware of auto)
+   * - rvalue images are moved into the expression
+   */
+  template<typename T, std::enable_if_t<is_image_or_image_expression_v<T>>* = nullptr>
+  [[nodiscard]] auto lazy(T&& x)
+  { return details::make_image_expression_operand(std::forward<T>(x)); }
+  /// @}
+
+  //====================================================================================================
+  //===== OPERATORS
+  //====================================================================================================
+  /*
+   * - operators on images (and scalars) return images as before; an rvalue image operand of the result
+   *   type is reused as storage
+   * - operators with an expression operand (see lazy()) build lazy expressions that are evaluated in
+   *   a single parallel pass when they are assigned to an Image (or passed to eval())
+   * - image (op) image has the common value type; image (op) scalar has the value type of the image
+   */
+  /// @{ -------------------------------------------------- OPERATOR +
+  template<typename TLhs, typename TRhs, std::enable_if_t<details::is_image_expression_binary_operands_v<TLhs, TRhs>>* = nullptr>
+  [[nodiscard]] auto operator+(TLhs&& lhs, TRhs&& rhs)
+  { return details::image_binary<details::ImageOpAdd>(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs)); }
+  /// @}
+
+  /// @{ -------------------------------------------------- OPERATOR -
+  template<typename TLhs, typename TRhs, std::enable_if_t<details::is_image_expression_binary_operands_v<TLhs, TRhs>>* = nullptr>
+  [[nodiscard]] auto operator-(TLhs&& lhs, TRhs&& rhs)
+  { return details::image_binary<details::ImageOpSubtract>(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs)); }
+  /// @}
+
+  /// @{ -------------------------------------------------- OPERATOR *
+  template<typename TLhs, typename TRhs, std::enable_if_t<details::is_image_expression_binary_operands_v<TLhs, TRhs>>* = nullptr>
+  [[nodiscard]] auto operator*(TLhs&& lhs, TRhs&& rhs)
+  { return details::image_binary<details::ImageOpMultiply>(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs)); }
+  /// @}
+
+  /// @{ -------------------------------------------------- OPERATOR /
+  template<typename TLhs, typename TRhs, std::enable_if_t<details::is_image_expression_binary_operands_v<TLhs, TRhs>>* = nullptr>
+  [[nodiscard]] auto operator/(TLhs&& lhs, TRhs&& rhs)
+  { return details::image_binary<details::ImageOpDivide>(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs)); }
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  // same as operators: images are evaluated right away, expressions stay lazy
+
+  /// @{ -------------------------------------------------- ABS
+  template<typename T, std::enable_if_t<is_image_or_image_expression_v<T>>* = nullptr>
+  [[nodiscard]] auto abs(T&& x)
+  { return details::image_unary<details::ImageOpAbs>(std::forward<T>(x)); }
+  /// @}
+
+  /// @{ -------------------------------------------------- SQRT
+  template<typename T, std::enable_if_t<is_image_or_image_expression_v<T>>* = nullptr>
+  [[nodiscard]] auto sqrt(T&& x)
+  { return details::image_unary<details::ImageOpSqrt>(std::forward<T>(x)); }
+  /// @}
+
+  /// @{ -------------------------------------------------- CLAMP
+  template<typename T, typename TBound, std::enable_if_t<is_image_or_image_expression_v<T>>* = nullptr>
+  [[nodiscard]] auto clamp(T&& x, const TBound& lo, const TBound& hi)
+  { return details::image_unary(std::forward<T>(x), details::ImageOpClamp<TBound>{lo, hi}); }
+  /// @}
+} // namespace bk
+
+#endif //BKDATASET_IMAGEEXPRESSION_H
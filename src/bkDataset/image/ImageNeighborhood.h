@@ -0,0 +1,414 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_IMAGENEIGHBORHOOD_H
+#define BKDATASET_IMAGENEIGHBORHOOD_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+#include <bkDataset/image/EImageBoundaryMode.h>
+
+namespace bk
+{
+  //! precomputed neighborhood (kernel) shape that is slid across an image
+  /*!
+   * - the linear offsets of all kernel elements are computed once in the constructor
+   * - the neighborhood stores its current position (list id + grid id) and is advanced with next();
+   *   there are no heap allocations after construction
+   * - interior positions (kernel completely inside the image) use the precomputed linear offsets,
+   *   positions near the border resolve each neighbor according to the ImageBoundaryMode
+   * - kernel elements are enumerated in list id order of the kernel (last dimension has stride 1),
+   *   i.e. element k corresponds to kernel[k]
+   * - missing kernel dimensions are treated as size 1
+   * - not thread-safe; create one instance per thread
+   *
+   * typical usage (parallel over image lines):
+   *
+   *     #pragma omp parallel
+   *     {
+   *         ImageNeighborhood nb(img.size(), kernel_size);
+   *         std::vector<value_type> values(nb.num_values());
+   *
+   *         #pragma omp for
+   *         for (unsigned int lineId = 0; lineId < nb.num_lines(); ++lineId)
+   *         {
+   *             for (nb.set_line(lineId); nb.is_in_line(); nb.next())
+   *             { const unsigned int n = nb.gather(img, values.data()); [...] }
+   *         }
+   *     }
+   */
+  class ImageNeighborhood
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = ImageNeighborhood;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      unsigned int _num_dimensions;
+      unsigned int _num_values;
+      ImageBoundaryMode _boundary_mode;
+      std::vector<int> _image_size;
+      std::vector<int> _stride;
+      std::vector<int> _offset_min; // per dimension; <= 0
+      std::vector<int> _offset_max; // per dimension; >= 0
+      std::vector<int> _offsets; // linear offset per kernel element
+      std::vector<int> _grid_offsets; // num_dimensions() grid offsets per kernel element
+      std::vector<int> _gid;
+      unsigned int _list_id;
+      unsigned int _line_end;
+      bool _is_interior;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      template<typename TImageSize, typename TKernelSize>
+      ImageNeighborhood(const TImageSize& image_size, const TKernelSize& kernel_size, ImageBoundaryMode mode = ImageBoundaryMode::Clamp)
+          : _num_dimensions(static_cast<unsigned int>(std::distance(std::begin(image_size), std::end(image_size)))),
+            _num_values(1),
+            _boundary_mode(mode),
+            _image_size(std::begin(image_size), std::end(image_size)),
+            _stride(_num_dimensions, 1),
+            _offset_min(_num_dimensions, 0),
+            _offset_max(_num_dimensions, 0),
+            _gid(_num_dimensions, 0),
+            _list_id(0),
+            _line_end(0),
+            _is_interior(false)
+      {
+          assert(_num_dimensions != 0 && "image has no dimensions");
+
+          const unsigned int numKernelDims = static_cast<unsigned int>(std::distance(std::begin(kernel_size), std::end(kernel_size)));
+          std::vector<int> ksize(_num_dimensions, 1);
+
+          for (unsigned int d = 0; d < std::min(_num_dimensions, numKernelDims); ++d)
+          { ksize[d] = std::max(1, static_cast<int>(kernel_size[d])); }
+
+          for (int d = static_cast<int>(_num_dimensions) - 2; d >= 0; --d)
+          { _stride[d] = _stride[d + 1] * _image_size[d + 1]; }
+
+          for (unsigned int d = 0; d < _num_dimensions; ++d)
+          {
+              _offset_min[d] = -(ksize[d] >> 1); // integer division
+              _offset_max[d] = ksize[d] - 1 + _offset_min[d];
+              _num_values *= ksize[d];
+          }
+
+          _offsets.resize(_num_values);
+          _grid_offsets.resize(_num_values * _num_dimensions);
+
+          std::vector<int> off(_offset_min);
+
+          for (unsigned int k = 0; k < _num_values; ++k)
+          {
+              int lidoff = 0;
+
+              for (unsigned int d = 0; d < _num_dimensions; ++d)
+              {
+                  _grid_offsets[k * _num_dimensions + d] = off[d];
+                  lidoff += off[d] * _stride[d];
+              }
+
+              _offsets[k] = lidoff;
+
+              // increment kernel grid pos (last dimension first)
+              for (int d = static_cast<int>(_num_dimensions) - 1; d >= 0; --d)
+              {
+                  if (++off[d] <= _offset_max[d])
+                  { break; }
+
+                  off[d] = _offset_min[d];
+              }
+          } // for k
+
+          set_position(0);
+      }
+
+      ImageNeighborhood(const self_type&) = default;
+      ImageNeighborhood(self_type&&) noexcept = default;
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~ImageNeighborhood() = default;
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET NUM DIMENSIONS
+      [[nodiscard]] unsigned int num_dimensions() const
+      { return _num_dimensions; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET NUM VALUES
+      //! number of kernel elements
+      [[nodiscard]] unsigned int num_values() const
+      { return _num_values; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET NUM LINES
+      //! number of image lines along the last dimension (stride 1)
+      [[nodiscard]] unsigned int num_lines() const
+      {
+          unsigned int n = 1;
+
+          for (unsigned int d = 0; d + 1 < _num_dimensions; ++d)
+          { n *= static_cast<unsigned int>(_image_size[d]); }
+
+          return n;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET BOUNDARY MODE
+      [[nodiscard]] ImageBoundaryMode boundary_mode() const
+      { return _boundary_mode; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET OFFSETS
+      //! linear (list id) offsets of all kernel elements; only valid at interior positions
+      [[nodiscard]] const std::vector<int>& offsets() const
+      { return _offsets; }
+
+      //! grid offset of kernel element k in dimension dimId
+      [[nodiscard]] int grid_offset(unsigned int k, unsigned int dimId) const
+      { return _grid_offsets[k * _num_dimensions + dimId]; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET POSITION
+      [[nodiscard]] unsigned int list_id() const
+      { return _list_id; }
+
+      [[nodiscard]] const std::vector<int>& grid_id() const
+      { return _gid; }
+
+      [[nodiscard]] int grid_id(unsigned int dimId) const
+      { return _gid[dimId]; }
+      /// @}
+
+      /// @{ -------------------------------------------------- IS INTERIOR
+      //! true if the whole kernel is inside of the image at the current position
+      [[nodiscard]] bool is_interior() const
+      { return _is_interior; }
+      /// @}
+
+      /// @{ -------------------------------------------------- IS IN LINE
+      //! true until next() leaves the line that was set via set_position() / set_line()
+      [[nodiscard]] bool is_in_line() const
+      { return _list_id < _line_end; }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: RESOLVE NEIGHBOR
+    private:
+      [[nodiscard]] bool _resolve(unsigned int k, unsigned int& lid) const
+      {
+          const int* goff = &_grid_offsets[k * _num_dimensions];
+          int l = 0;
+
+          for (unsigned int d = 0; d < _num_dimensions; ++d)
+          {
+              int c = _gid[d] + goff[d];
+              const int n = _image_size[d];
+
+              if (c < 0 || c >= n)
+              {
+                  switch (_boundary_mode)
+                  {
+                      case ImageBoundaryMode::Clamp:
+                      {
+                          c = std::clamp(c, 0, n - 1);
+                          break;
+                      }
+                      case ImageBoundaryMode::Mirror:
+                      {
+                          if (n == 1)
+                          { c = 0; }
+                          else
+                          {
+                              const int period = 2 * (n - 1);
+                              c = std::abs(c) % period;
+
+                              if (c >= n)
+                              { c = period - c; }
+                          }
+
+                          break;
+                      }
+                      default: // Skip, Constant
+                      { return false; }
+                  }
+              }
+
+              l += c * _stride[d];
+          }
+
+          lid = static_cast<unsigned int>(l);
+          return true;
+      }
+
+      void _update_interior()
+      {
+          _is_interior = true;
+
+          for (unsigned int d = 0; d < _num_dimensions; ++d)
+          {
+              if (_gid[d] + _offset_min[d] < 0 || _gid[d] + _offset_max[d] >= _image_size[d])
+              {
+                  _is_interior = false;
+                  break;
+              }
+          }
+      }
+
+    public:
+      /// @}
+
+      /// @{ -------------------------------------------------- FOR EACH NEIGHBOR
+      //! calls f(k, lid) for each kernel element k that maps to a voxel (list id lid)
+      /*!
+       * Neighbors outside of the image are omitted in Skip/Constant mode.
+       */
+      template<typename TFunction>
+      void for_each(TFunction&& f) const
+      {
+          if (_is_interior)
+          {
+              for (unsigned int k = 0; k < _num_values; ++k)
+              { f(k, static_cast<unsigned int>(static_cast<int>(_list_id) + _offsets[k])); }
+          }
+          else
+          {
+              unsigned int lid = 0;
+
+              for (unsigned int k = 0; k < _num_values; ++k)
+              {
+                  if (_resolve(k, lid))
+                  { f(k, lid); }
+              }
+          }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GATHER
+      //! copies the neighborhood values to out (must hold num_values() elements)
+      /*!
+       * - data: anything with operator[](list id), e.g. an image, a Span, or a raw pointer
+       * - Skip mode: neighbors outside of the image are omitted (out is compacted)
+       * - Constant mode: neighbors outside of the image are set to constant
+       * @return number of written values
+       */
+      template<typename TData, typename TValue>
+      unsigned int gather(const TData& data, TValue* out, const TValue& constant = TValue()) const
+      {
+          if (_is_interior)
+          {
+              for (unsigned int k = 0; k < _num_values; ++k)
+              { out[k] = data[static_cast<unsigned int>(static_cast<int>(_list_id) + _offsets[k])]; }
+
+              return _num_values;
+          }
+
+          unsigned int n = 0;
+          unsigned int lid = 0;
+
+          for (unsigned int k = 0; k < _num_values; ++k)
+          {
+              if (_resolve(k, lid))
+              { out[n++] = data[lid]; }
+              else if (_boundary_mode == ImageBoundaryMode::Constant)
+              { out[n++] = constant; }
+          }
+
+          return n;
+      }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type&) -> self_type& = default;
+      [[maybe_unused]] auto operator=(self_type&&) noexcept -> self_type& = default;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET BOUNDARY MODE
+      void set_boundary_mode(ImageBoundaryMode mode)
+      { _boundary_mode = mode; }
+      /// @}
+
+      /// @{ -------------------------------------------------- SET POSITION
+      void set_position(unsigned int listId)
+      {
+          _list_id = listId;
+
+          unsigned int rem = listId;
+
+          for (unsigned int d = 0; d < _num_dimensions; ++d)
+          {
+              _gid[d] = static_cast<int>(rem / static_cast<unsigned int>(_stride[d]));
+              rem %= static_cast<unsigned int>(_stride[d]);
+          }
+
+          _line_end = listId - static_cast<unsigned int>(_gid[_num_dimensions - 1]) + static_cast<unsigned int>(_image_size[_num_dimensions - 1]);
+          _update_interior();
+      }
+
+      //! moves to the first voxel of the given line (see num_lines())
+      void set_line(unsigned int lineId)
+      { set_position(lineId * static_cast<unsigned int>(_image_size[_num_dimensions - 1])); }
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- NEXT
+      //! advance to the next list id
+      void next()
+      {
+          ++_list_id;
+
+          for (int d = static_cast<int>(_num_dimensions) - 1; d >= 0; --d)
+          {
+              if (++_gid[d] < _image_size[d] || d == 0)
+              { break; }
+
+              _gid[d] = 0;
+          }
+
+          _update_interior();
+      }
+      /// @}
+  }; // class ImageNeighborhood
+} // namespace bk
+
+#endif //BKDATASET_IMAGENEIGHBORHOOD_H
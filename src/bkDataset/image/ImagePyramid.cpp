@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/ImagePyramid.h>
+
+namespace bk
+{
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  ImagePyramid::ImagePyramid()
+      : ImagePyramid(3, 8)
+  { /* do nothing */ }
+
+  ImagePyramid::ImagePyramid(const self_type& other) = default;
+  ImagePyramid::ImagePyramid(self_type&& other) noexcept = default;
+
+  ImagePyramid::ImagePyramid(unsigned int numLevels, unsigned int minSize)
+      : _num_levels(numLevels),
+        _min_size(std::max(minSize, 1U))
+  { /* do nothing */ }
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  ImagePyramid::~ImagePyramid() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET NUM LEVELS
+  unsigned int ImagePyramid::num_levels() const
+  { return _num_levels; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET MIN SIZE
+  unsigned int ImagePyramid::min_size() const
+  { return _min_size; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET CACHE KEY
+  unsigned long long ImagePyramid::cache_key() const
+  { return string_utils::hash("ImagePyramid") ^ (static_cast<unsigned long long>(_num_levels) << 32) ^ _min_size; }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto ImagePyramid::operator=(const self_type& other) -> self_type& = default;
+  auto ImagePyramid::operator=(self_type&& other) noexcept -> self_type& = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- SET NUM LEVELS
+  void ImagePyramid::set_num_levels(unsigned int numLevels)
+  { _num_levels = numLevels; }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET MIN SIZE
+  void ImagePyramid::set_min_size(unsigned int minSize)
+  { _min_size = std::max(minSize, 1U); }
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- HELPER: DOWNSCALE TRANSFORMATION
+  void ImagePyramid::_downscale(DicomTransformation& t, const std::vector<unsigned int>& factor)
+  {
+      Mat5d w = t.world_matrix_with_time();
+
+      for (unsigned int dimId = 0; dimId < factor.size(); ++dimId)
+      {
+          // 2D+t images: the third grid dimension is time
+          const unsigned int colId = (dimId == 2 && t.dicom_image_type_is_2dt()) ? 3 : dimId;
+
+          for (unsigned int r = 0; r < 5; ++r)
+          { w(r, colId) *= factor[dimId]; }
+      }
+
+      t.set_world_matrix(w);
+  }
+  /// @}
+} // namespace bk
@@ -0,0 +1,362 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_IMAGEPYRAMID_H
+#define BKDATASET_IMAGEPYRAMID_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#ifdef BK_EMIT_PROGRESS
+
+    #include <bk/Progress>
+    #include <bk/Localization>
+
+#endif
+
+#include <bkDataset/image/filter/KernelFactory.h>
+#include <bkDataset/transformation/DicomTransformation.h>
+#include <bkDataset/transformation/ScaleTransformation.h>
+#include <bkDataset/transformation/WorldMatrixTransformation.h>
+#include <bkTools/string_utils/string_utils.h>
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! coarse level of an ImagePyramid
+  template<typename TImage> struct ImagePyramidLevel
+  {
+      //! downsampled image
+      TImage image;
+      //! per dimension: grid position in the source image = grid position in this level * factor
+      std::vector<unsigned int> factor;
+  };
+
+  //! multi-resolution representation of an image (Gaussian pyramid)
+  /*!
+   * - each level is obtained from the previous one by binomial smoothing (KernelFactory)
+   *   and subsampling by 2 in the reduced dimensions; both steps are done in one parallel pass
+   * - anisotropy-aware: a dimension is only reduced if its (world) spacing is less than twice
+   *   the finest spacing of the level, e.g. thin in-plane spacing is reduced first while the
+   *   slice direction is kept until the voxels are approximately isotropic
+   * - levels() stores the result in the image's cache (see Image::cached()); it is invalidated
+   *   when the image is modified and rebuilt lazily on the next request
+   * - the transformations of ScaleTransformation, WorldMatrixTransformation and DicomTransformation
+   *   images are adjusted so that the levels keep their world positions; for other transformations,
+   *   use the factor of the level
+   */
+  class BKDATASET_EXPORT ImagePyramid
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = ImagePyramid;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      unsigned int _num_levels;
+      unsigned int _min_size;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      ImagePyramid();
+      ImagePyramid(const self_type& other);
+      ImagePyramid(self_type&& other) noexcept;
+      ImagePyramid(unsigned int numLevels, unsigned int minSize = 8);
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~ImagePyramid();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET NUM LEVELS
+      //! maximum number of coarse levels (the source image is not included)
+      [[nodiscard]] unsigned int num_levels() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET MIN SIZE
+      //! a dimension is not reduced below this size
+      [[nodiscard]] unsigned int min_size() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET CACHE KEY
+      [[nodiscard]] unsigned long long cache_key() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET NUM LEVELS
+      void set_num_levels(unsigned int numLevels);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET MIN SIZE
+      void set_min_size(unsigned int minSize);
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER: SPACING
+      //! world distance between neighboring grid positions per dimension
+      template<typename TImage>
+      [[nodiscard]] static std::vector<double> _spacing(const TImage& img)
+      {
+          const unsigned int nDims = img.num_dimensions();
+          const auto& t = img.geometry().transformation();
+
+          std::vector<double> p(nDims, 0.0);
+          const auto w0 = t.to_world_coordinates(p);
+
+          std::vector<double> spacing(nDims, 0.0);
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              p[dimId] = 1;
+              const auto w1 = t.to_world_coordinates(p);
+              p[dimId] = 0;
+
+              double d = 0;
+              for (unsigned int i = 0; i < nDims; ++i)
+              { d += (w1[i] - w0[i]) * (w1[i] - w0[i]); }
+
+              spacing[dimId] = std::sqrt(d);
+          }
+
+          return spacing;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: DOWNSCALE TRANSFORMATION
+      //! grid position g of the level corresponds to grid position g * factor of the previous level
+      template<typename TTransformation>
+      static void _downscale([[maybe_unused]] TTransformation& t, [[maybe_unused]] const std::vector<unsigned int>& factor)
+      { /* not representable; use ImagePyramidLevel::factor */ }
+
+      template<int TDims>
+      static void _downscale(ScaleTransformation<TDims>& t, const std::vector<unsigned int>& factor)
+      {
+          std::vector<double> s(factor.size());
+          for (unsigned int dimId = 0; dimId < factor.size(); ++dimId)
+          { s[dimId] = t.scale(dimId) * factor[dimId]; }
+
+          t.set_scale(s);
+      }
+
+      template<int TDims>
+      static void _downscale(WorldMatrixTransformation<TDims>& t, const std::vector<unsigned int>& factor)
+      {
+          auto w = t.world_matrix();
+
+          for (unsigned int dimId = 0; dimId < factor.size(); ++dimId)
+          {
+              for (unsigned int r = 0; r < w.num_rows(); ++r)
+              { w(r, dimId) *= factor[dimId]; }
+          }
+
+          t.set_world_matrix(w);
+      }
+
+      static void _downscale(DicomTransformation& t, const std::vector<unsigned int>& factor);
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: REDUCE
+      //! smooths with a binomial kernel of size 3 in the reduced dimensions and subsamples by 2
+      template<typename TImage>
+      [[nodiscard]] static TImage _reduce(const TImage& img, const std::vector<bool>& reduce)
+      {
+          const unsigned int nDims = img.num_dimensions();
+
+          std::vector<unsigned int> srcSize(nDims);
+          std::vector<unsigned int> dstSize(nDims);
+          std::vector<unsigned int> kernelSize(nDims);
+          std::vector<unsigned int> factor(nDims);
+          std::vector<unsigned int> stride(nDims);
+
+          unsigned int s = 1;
+          for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
+          {
+              srcSize[dimId] = img.size(dimId);
+              dstSize[dimId] = reduce[dimId] ? (srcSize[dimId] + 1) / 2 : srcSize[dimId];
+              kernelSize[dimId] = reduce[dimId] ? 3 : 1;
+              factor[dimId] = reduce[dimId] ? 2 : 1;
+              stride[dimId] = s;
+              s *= srcSize[dimId];
+          }
+
+          const auto kernel = KernelFactory::make_binomial_of_sizes(kernelSize);
+          const unsigned int numKernelValues = kernel.num_values();
+
+          // per kernel element: offset of each dimension relative to the center
+          std::vector<int> kernelOffset(numKernelValues * nDims);
+          for (unsigned int k = 0; k < numKernelValues; ++k)
+          {
+              const auto kgid = bk::list_to_grid_id(kernelSize, k);
+
+              for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+              { kernelOffset[k * nDims + dimId] = static_cast<int>(kgid[dimId]) - static_cast<int>(kernelSize[dimId] / 2); }
+          }
+
+          TImage res;
+          res.set_size(dstSize);
+          res.geometry().transformation() = img.geometry().transformation();
+          _downscale(res.geometry().transformation(), factor);
+
+          const int numValues = static_cast<int>(res.num_values());
+
+          #pragma omp parallel
+          {
+              std::vector<int> center(nDims);
+
+              #pragma omp for
+              for (int lid = 0; lid < numValues; ++lid)
+              {
+                  unsigned int temp = static_cast<unsigned int>(lid);
+                  for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
+                  {
+                      center[dimId] = static_cast<int>((temp % dstSize[dimId]) * factor[dimId]);
+                      temp /= dstSize[dimId];
+                  }
+
+                  auto v = img.template allocate_value<double>();
+
+                  for (unsigned int k = 0; k < numKernelValues; ++k)
+                  {
+                      unsigned int srcLid = 0;
+
+                      for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+                      {
+                          const int x = std::clamp(center[dimId] + kernelOffset[k * nDims + dimId], 0, static_cast<int>(srcSize[dimId]) - 1);
+                          srcLid += static_cast<unsigned int>(x) * stride[dimId];
+                      }
+
+                      v += img[srcLid] * kernel[k];
+                  }
+
+                  res[lid] = v;
+              } // for lid
+          } // omp parallel
+
+          res.invalidate_cache();
+
+          return res;
+      }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- BUILD
+      //! computes the coarse levels of img (without caching); the first entry is the finest coarse level
+      template<typename TImage>
+      [[nodiscard]] std::vector<ImagePyramidLevel<TImage>> build(const TImage& img) const
+      {
+          const unsigned int nDims = img.num_dimensions();
+
+          std::vector<ImagePyramidLevel<TImage>> levels;
+          levels.reserve(_num_levels);
+
+          std::vector<unsigned int> factor(nDims, 1);
+          std::vector<double> spacing = _spacing(img);
+          std::vector<bool> reduce(nDims);
+
+          #ifdef BK_EMIT_PROGRESS
+          Progress& prog = bk_progress.emplace_task(_num_levels, ___("Building image pyramid"));
+          #endif
+
+          for (unsigned int levelId = 0; levelId < _num_levels; ++levelId)
+          {
+              const TImage& prev = levels.empty() ? img : levels.back().image;
+
+              // finest spacing among the dimensions that can still be reduced
+              double minSpacing = std::numeric_limits<double>::max();
+              for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+              {
+                  if ((prev.size(dimId) + 1) / 2 >= _min_size)
+                  { minSpacing = std::min(minSpacing, spacing[dimId]); }
+              }
+
+              bool anyReduced = false;
+              for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+              {
+                  reduce[dimId] = (prev.size(dimId) + 1) / 2 >= _min_size && spacing[dimId] < 2 * minSpacing;
+                  anyReduced |= reduce[dimId];
+              }
+
+              if (!anyReduced)
+              { break; }
+
+              ImagePyramidLevel<TImage> level;
+              level.image = _reduce(prev, reduce);
+
+              for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+              {
+                  if (reduce[dimId])
+                  {
+                      factor[dimId] *= 2;
+                      spacing[dimId] *= 2;
+                  }
+              }
+
+              level.factor = factor;
+              levels.push_back(std::move(level));
+
+              #ifdef BK_EMIT_PROGRESS
+              prog.increment(1);
+              #endif
+          } // for levelId
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.set_finished();
+          #endif
+
+          return levels;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- LEVELS
+      //! cached coarse levels of img; built on first request and after modifications of img
+      template<typename TImage>
+      [[nodiscard]] std::shared_ptr<const std::vector<ImagePyramidLevel<TImage>>> levels(const TImage& img) const
+      { return img.template cached<std::vector<ImagePyramidLevel<TImage>>>(cache_key(), [&](const TImage& i) { return build(i); }); }
+      /// @}
+  }; // class ImagePyramid
+} // namespace bk
+
+#endif //BKDATASET_IMAGEPYRAMID_H
@@ -0,0 +1,173 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_IMAGEREDUCTION_H
+#define BKDATASET_IMAGEREDUCTION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace bk::details
+{
+  /*
+   * Reduction kernels on contiguous arithmetic buffers.
+   *
+   * - the loops are plain (no attribute access, no comparator objects) and annotated with
+   *   "omp parallel for simd", so they are split across threads and vectorized with the
+   *   instruction set the library is compiled for (e.g. -march=native)
+   * - sums are accumulated in double (or long double for long double buffers) to avoid
+   *   overflow for integer images and precision loss for float images
+   */
+
+  //====================================================================================================
+  //===== DEFINITIONS
+  //====================================================================================================
+  template<typename T> constexpr bool is_reducible_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+  template<typename T> using reduction_accumulator_t = std::conditional_t<std::is_same_v<T, long double>, long double, double>;
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- MIN / MAX
+  template<typename T>
+  [[nodiscard]] T reduce_min(const T* data, std::int64_t n)
+  {
+      static_assert(is_reducible_v<T>);
+
+      T x = n != 0 ? data[0] : T();
+
+      #pragma omp parallel for simd reduction(min:x)
+      for (std::int64_t i = 1; i < n; ++i)
+      { x = std::min(x, data[i]); }
+
+      return x;
+  }
+
+  template<typename T>
+  [[nodiscard]] T reduce_max(const T* data, std::int64_t n)
+  {
+      static_assert(is_reducible_v<T>);
+
+      T x = n != 0 ? data[0] : T();
+
+      #pragma omp parallel for simd reduction(max:x)
+      for (std::int64_t i = 1; i < n; ++i)
+      { x = std::max(x, data[i]); }
+
+      return x;
+  }
+
+  //! single pass over the data
+  template<typename T>
+  [[nodiscard]] std::pair<T, T> reduce_minmax(const T* data, std::int64_t n)
+  {
+      static_assert(is_reducible_v<T>);
+
+      T xmin = n != 0 ? data[0] : T();
+      T xmax = xmin;
+
+      #pragma omp parallel for simd reduction(min:xmin) reduction(max:xmax)
+      for (std::int64_t i = 1; i < n; ++i)
+      {
+          xmin = std::min(xmin, data[i]);
+          xmax = std::max(xmax, data[i]);
+      }
+
+      return {xmin, xmax};
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- SUM
+  template<typename T>
+  [[nodiscard]] reduction_accumulator_t<T> reduce_sum(const T* data, std::int64_t n)
+  {
+      static_assert(is_reducible_v<T>);
+
+      reduction_accumulator_t<T> s = 0;
+
+      #pragma omp parallel for simd reduction(+:s)
+      for (std::int64_t i = 0; i < n; ++i)
+      { s += static_cast<reduction_accumulator_t<T>>(data[i]); }
+
+      return s;
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- MEAN / VARIANCE
+  //! single pass; values are shifted by the first value to avoid cancellation in sum of squares
+  template<typename T>
+  [[nodiscard]] std::pair<reduction_accumulator_t<T>, reduction_accumulator_t<T>> reduce_mean_variance(const T* data, std::int64_t n)
+  {
+      static_assert(is_reducible_v<T>);
+
+      using accum_type = reduction_accumulator_t<T>;
+
+      if (n == 0)
+      { return {0, 0}; }
+
+      const accum_type shift = static_cast<accum_type>(data[0]);
+      accum_type s = 0;
+      accum_type s2 = 0;
+
+      #pragma omp parallel for simd reduction(+:s,s2)
+      for (std::int64_t i = 0; i < n; ++i)
+      {
+          const accum_type d = static_cast<accum_type>(data[i]) - shift;
+          s += d;
+          s2 += d * d;
+      }
+
+      const accum_type mean_shifted = s / n;
+
+      return {shift + mean_shifted, std::max(accum_type(0), s2 / n - mean_shifted * mean_shifted)};
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- ELEMENT-WISE
+  //! dst[i] = op(dst[i], src[i])
+  template<typename TDst, typename TSrc, typename TOp>
+  void transform_inplace(TDst* dst, const TSrc* src, std::int64_t n, TOp op)
+  {
+      #pragma omp parallel for simd
+      for (std::int64_t i = 0; i < n; ++i)
+      { dst[i] = static_cast<TDst>(op(dst[i], src[i])); }
+  }
+
+  //! dst[i] = op(dst[i], x)
+  template<typename TDst, typename TScalar, typename TOp>
+  void transform_inplace_scalar(TDst* dst, const TScalar& x, std::int64_t n, TOp op)
+  {
+      #pragma omp parallel for simd
+      for (std::int64_t i = 0; i < n; ++i)
+      { dst[i] = static_cast<TDst>(op(dst[i], x)); }
+  }
+  /// @}
+} // namespace bk::details
+
+#endif //BKDATASET_IMAGEREDUCTION_H
@@ -0,0 +1,360 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_IMAGESLABPIPELINE_H
+#define BKDATASET_IMAGESLABPIPELINE_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef BK_EMIT_PROGRESS
+
+    #include <bk/Progress>
+    #include <bk/Localization>
+
+#endif
+
+namespace bk
+{
+  namespace details
+  {
+    template<typename TFilter, typename = void> struct filter_has_kernel_size : std::false_type
+    {
+    };
+
+    template<typename TFilter> struct filter_has_kernel_size<TFilter, std::void_t<decltype(std::declval<const TFilter&>().kernel_size()[0])>> : std::true_type
+    {
+    };
+
+    template<typename TFilter, typename = void> struct filter_has_num_iterations : std::false_type
+    {
+    };
+
+    template<typename TFilter> struct filter_has_num_iterations<TFilter, std::void_t<decltype(std::declval<const TFilter&>().num_iterations())>> : std::true_type
+    {
+    };
+
+    template<typename TImage, typename... TFilters> struct slab_pipeline_result
+    { using type = TImage; };
+
+    template<typename TImage, typename TFilter, typename... TFilters> struct slab_pipeline_result<TImage, TFilter, TFilters...>
+    { using type = typename slab_pipeline_result<std::decay_t<decltype(std::declval<const TFilter&>().apply(std::declval<const TImage&>()))>, TFilters...>::type; };
+  } // namespace details
+
+  //! chain of local image filters that is executed slab by slab
+  /*!
+   * - the image is split into slabs along one dimension (default: 0, i.e. contiguous memory);
+   *   each slab is extended by the accumulated halo of all stages, run through the stages,
+   *   and the center is copied into the result. Only the extended slabs of each stage are
+   *   resident instead of one full intermediate volume per stage
+   * - slabs are independent, so several of them are processed concurrently
+   *   (set_num_parallel_slabs()); each slab runs through all stages on one thread
+   * - halo of a stage (in slices of the slab dimension): automatically kernel_size()[dim] / 2
+   *   (times num_iterations()) for filters providing these, otherwise 1; use set_halo() for
+   *   filters with a larger support
+   * - only local filters produce results identical to the full-volume execution; filters that
+   *   depend on global information (histogram equalization, intensity normalization, connected
+   *   components, ...) must be applied to the pipeline's result instead
+   * - filters are applied via their const apply() member function
+   */
+  template<typename... TFilters>
+  class ImageSlabPipeline
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = ImageSlabPipeline<TFilters...>;
+
+    public:
+      static constexpr unsigned int NumStages = sizeof...(TFilters);
+
+      template<typename TImage> using result_type = typename details::slab_pipeline_result<TImage, TFilters...>::type;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      std::tuple<TFilters...> _filters;
+      std::array<int, NumStages> _halo; // -1: automatic
+      unsigned int _slab_dimension;
+      unsigned int _slab_size;
+      unsigned int _num_parallel_slabs;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      ImageSlabPipeline(const self_type&) = default;
+      ImageSlabPipeline(self_type&&) noexcept = default;
+
+      explicit ImageSlabPipeline(TFilters... filters)
+          : _filters(std::move(filters)...),
+            _slab_dimension(0),
+            _slab_size(16),
+            _num_parallel_slabs(std::max(std::thread::hardware_concurrency(), 1U))
+      { _halo.fill(-1); }
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~ImageSlabPipeline() = default;
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET FILTER
+      template<unsigned int I>
+      [[nodiscard]] const auto& filter() const
+      { return std::get<I>(_filters); }
+
+      template<unsigned int I>
+      [[nodiscard]] auto& filter()
+      { return std::get<I>(_filters); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET HALO
+      //! number of additional slices of the slab dimension that stage I requires on each side
+      template<unsigned int I>
+      [[nodiscard]] unsigned int halo() const
+      {
+          static_assert(I < NumStages, "invalid stage id");
+
+          if (_halo[I] >= 0)
+          { return static_cast<unsigned int>(_halo[I]); }
+
+          using filter_type = std::tuple_element_t<I, std::tuple<TFilters...>>;
+          const filter_type& f = std::get<I>(_filters);
+
+          unsigned int h = 1;
+
+          if constexpr (details::filter_has_kernel_size<filter_type>::value)
+          {
+              const auto& ks = f.kernel_size();
+              h = _slab_dimension < ks.size() ? static_cast<unsigned int>(ks[_slab_dimension]) / 2 : 0;
+          }
+
+          if constexpr (details::filter_has_num_iterations<filter_type>::value)
+          { h *= f.num_iterations(); }
+
+          return h;
+      }
+
+      //! accumulated halo of all stages
+      [[nodiscard]] unsigned int total_halo() const
+      { return _total_halo(std::make_integer_sequence<unsigned int, NumStages>()); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SLAB PARAMETERS
+      [[nodiscard]] unsigned int slab_dimension() const
+      { return _slab_dimension; }
+
+      [[nodiscard]] unsigned int slab_size() const
+      { return _slab_size; }
+
+      [[nodiscard]] unsigned int num_parallel_slabs() const
+      { return _num_parallel_slabs; }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] self_type& operator=(const self_type&) = default;
+      [[maybe_unused]] self_type& operator=(self_type&&) noexcept = default;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET HALO
+      template<unsigned int I>
+      void set_halo(unsigned int h)
+      {
+          static_assert(I < NumStages, "invalid stage id");
+          _halo[I] = static_cast<int>(h);
+      }
+
+      //! use kernel_size() / num_iterations() of the filter (or 1)
+      template<unsigned int I>
+      void set_halo_automatic()
+      {
+          static_assert(I < NumStages, "invalid stage id");
+          _halo[I] = -1;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- SET SLAB PARAMETERS
+      void set_slab_dimension(unsigned int dimId)
+      { _slab_dimension = dimId; }
+
+      //! number of result slices per slab
+      void set_slab_size(unsigned int numSlices)
+      { _slab_size = std::max(numSlices, 1U); }
+
+      //! number of slabs that are processed concurrently, each on one thread (default: number of hardware threads)
+      void set_num_parallel_slabs(unsigned int n)
+      { _num_parallel_slabs = std::max(n, 1U); }
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER: TOTAL HALO
+      template<unsigned int... I>
+      [[nodiscard]] unsigned int _total_halo(std::integer_sequence<unsigned int, I...>) const
+      { return (0U + ... + halo<I>()); }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: SLAB LAYOUT
+      //! sizes of the dimensions before (outer) and after (inner) the slab dimension
+      template<typename TImage>
+      [[nodiscard]] std::pair<unsigned int, unsigned int> _outer_inner(const TImage& img) const
+      {
+          unsigned int outer = 1;
+          unsigned int inner = 1;
+
+          for (unsigned int dimId = 0; dimId < img.num_dimensions(); ++dimId)
+          {
+              if (dimId < _slab_dimension)
+              { outer *= img.size(dimId); }
+              else if (dimId > _slab_dimension)
+              { inner *= img.size(dimId); }
+          }
+
+          return {outer, inner};
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: EXTRACT SLAB
+      //! copies the slices [first, last) of the slab dimension
+      template<typename TImage>
+      [[nodiscard]] TImage _extract(const TImage& img, unsigned int first, unsigned int last) const
+      {
+          const auto [outer, inner] = _outer_inner(img);
+          const unsigned int n = img.size(_slab_dimension);
+          const unsigned int m = last - first;
+
+          auto size = img.size();
+          size[_slab_dimension] = m;
+
+          TImage slab;
+          slab.set_size(size);
+
+          const auto* srcData = img.span().data();
+          auto* dstData = slab.span().data();
+
+          for (unsigned int o = 0; o < outer; ++o)
+          {
+              const auto* src = srcData + (o * n + first) * inner;
+              std::copy(src, src + m * inner, dstData + o * m * inner);
+          }
+
+          return slab;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: RUN STAGES
+      template<unsigned int I, typename TImage>
+      [[nodiscard]] auto _run(TImage img) const
+      {
+          if constexpr (I == NumStages)
+          { return img; }
+          else
+          {
+              auto out = std::get<I>(_filters).apply(img);
+              img = TImage(); // release the input of this stage before running the next one
+              return _run<I + 1>(std::move(out));
+          }
+      }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] result_type<TImage> apply(const TImage& img) const
+      {
+          const unsigned int nDims = img.num_dimensions();
+          assert(_slab_dimension < nDims && "invalid slab dimension");
+
+          using res_type = result_type<TImage>;
+
+          res_type res;
+          res.set_size(img.size());
+
+          if constexpr (std::is_assignable_v<decltype(res.geometry().transformation())&, decltype(img.geometry().transformation())>)
+          { res.geometry().transformation() = img.geometry().transformation(); }
+
+          const unsigned int n = img.size(_slab_dimension);
+          const unsigned int H = total_halo();
+          const unsigned int numSlabs = (n + _slab_size - 1) / _slab_size;
+          const auto [outer, inner] = _outer_inner(img);
+          auto* resData = res.span().data();
+
+          #ifdef BK_EMIT_PROGRESS
+          Progress& prog = bk_progress.emplace_task(numSlabs, ___("Slab-wise image filtering"));
+          #endif
+
+          #pragma omp parallel for schedule(dynamic, 1) num_threads(_num_parallel_slabs)
+          for (int slabId = 0; slabId < static_cast<int>(numSlabs); ++slabId)
+          {
+              const unsigned int first = static_cast<unsigned int>(slabId) * _slab_size;
+              const unsigned int last = std::min(first + _slab_size, n);
+              const unsigned int haloFirst = first >= H ? first - H : 0;
+              const unsigned int haloLast = std::min(last + H, n);
+
+              const auto out = _run<0>(_extract(img, haloFirst, haloLast));
+              const auto* outData = out.span().data();
+              const unsigned int m = haloLast - haloFirst;
+
+              // copy the center of the slab
+              for (unsigned int o = 0; o < outer; ++o)
+              {
+                  const auto* src = outData + (o * m + (first - haloFirst)) * inner;
+                  std::copy(src, src + (last - first) * inner, resData + (o * n + first) * inner);
+              }
+
+              #ifdef BK_EMIT_PROGRESS
+              prog.increment(1);
+              #endif
+          } // for slabId
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.set_finished();
+          #endif
+
+          res.invalidate_cache();
+
+          return res;
+      }
+      /// @}
+  }; // class ImageSlabPipeline
+} // namespace bk
+
+#endif //BKDATASET_IMAGESLABPIPELINE_H
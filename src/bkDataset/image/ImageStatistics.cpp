@@ -0,0 +1,198 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/ImageStatistics.h>
+
+namespace bk
+{
+  //====================================================================================================
+  //===== ImageStatisticsResult
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET VARIANCE
+  double ImageStatisticsResult::variance() const
+  { return count != 0 ? m2 / static_cast<double>(count) : 0.0; }
+
+  double ImageStatisticsResult::standard_deviation() const
+  { return std::sqrt(variance()); }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET PERCENTILE
+  double ImageStatisticsResult::percentile(double q) const
+  {
+      if (count == 0 || histogram.empty())
+      { return 0; }
+
+      q = std::clamp(q, 0.0, 1.0);
+
+      const double target = q * static_cast<double>(count);
+      const double binWidth = (histogram_max - histogram_min) / static_cast<double>(histogram.size());
+
+      std::uint64_t cumulative = 0;
+      for (unsigned int i = 0; i < histogram.size(); ++i)
+      {
+          const std::uint64_t next = cumulative + histogram[i];
+
+          if (histogram[i] != 0 && static_cast<double>(next) >= target)
+          {
+              const double frac = (target - static_cast<double>(cumulative)) / static_cast<double>(histogram[i]);
+              return std::clamp(histogram_min + (i + frac) * binWidth, min, max);
+          }
+
+          cumulative = next;
+      }
+
+      return max;
+  }
+
+  double ImageStatisticsResult::median() const
+  { return percentile(0.5); }
+  /// @}
+
+  /// @{ -------------------------------------------------- MERGE
+  void ImageStatisticsResult::merge(const ImageStatisticsResult& other)
+  {
+      if (other.count == 0)
+      { return; }
+
+      if (count == 0)
+      {
+          *this = other;
+          return;
+      }
+
+      assert(histogram.size() == other.histogram.size() && "histogram layouts differ");
+
+      const double n0 = static_cast<double>(count);
+      const double n1 = static_cast<double>(other.count);
+      const double n = n0 + n1;
+      const double d = other.mean - mean;
+
+      mean += d * (n1 / n);
+      m2 += other.m2 + d * d * (n0 * n1 / n);
+      count += other.count;
+      min = std::min(min, other.min);
+      max = std::max(max, other.max);
+
+      for (unsigned int i = 0; i < histogram.size(); ++i)
+      { histogram[i] += other.histogram[i]; }
+  }
+  /// @}
+
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  ImageStatistics::ImageStatistics()
+      : ImageStatistics(256)
+  { /* do nothing */ }
+
+  ImageStatistics::ImageStatistics(const self_type& other) = default;
+  ImageStatistics::ImageStatistics(self_type&& other) noexcept = default;
+
+  ImageStatistics::ImageStatistics(unsigned int numBins)
+      : _num_bins(numBins),
+        _histograms_per_label(false),
+        _has_histogram_range(false),
+        _histogram_min(0),
+        _histogram_max(0)
+  { /* do nothing */ }
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  ImageStatistics::~ImageStatistics() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET NUM BINS
+  unsigned int ImageStatistics::num_bins() const
+  { return _num_bins; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET HISTOGRAMS PER LABEL
+  bool ImageStatistics::histograms_per_label() const
+  { return _histograms_per_label; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET HISTOGRAM RANGE
+  bool ImageStatistics::has_histogram_range() const
+  { return _has_histogram_range; }
+
+  double ImageStatistics::histogram_min() const
+  { return _histogram_min; }
+
+  double ImageStatistics::histogram_max() const
+  { return _histogram_max; }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto ImageStatistics::operator=(const self_type& other) -> self_type& = default;
+  auto ImageStatistics::operator=(self_type&& other) noexcept -> self_type& = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- SET NUM BINS
+  void ImageStatistics::set_num_bins(unsigned int numBins)
+  { _num_bins = numBins; }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET HISTOGRAMS PER LABEL
+  void ImageStatistics::set_histograms_per_label(bool b)
+  { _histograms_per_label = b; }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET HISTOGRAM RANGE
+  void ImageStatistics::set_histogram_range(double histogramMin, double histogramMax)
+  {
+      _has_histogram_range = true;
+      _histogram_min = std::min(histogramMin, histogramMax);
+      _histogram_max = std::max(histogramMin, histogramMax);
+  }
+
+  void ImageStatistics::set_histogram_range_automatic()
+  { _has_histogram_range = false; }
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- HELPER: PREPARE
+  auto ImageStatistics::_make_empty_result(double histogramMin, double histogramMax, bool withHistogram) const -> result_type
+  {
+      result_type r;
+
+      if (withHistogram)
+      {
+          r.histogram_min = histogramMin;
+          r.histogram_max = histogramMax;
+          r.histogram.assign(_num_bins, 0);
+      }
+
+      return r;
+  }
+  /// @}
+} // namespace bk
@@ -0,0 +1,453 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_IMAGESTATISTICS_H
+#define BKDATASET_IMAGESTATISTICS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <bkDataset/image/ImageReduction.h>
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! statistics of a set of scalar values (see ImageStatistics)
+  struct BKDATASET_EXPORT ImageStatisticsResult
+  {
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      std::uint64_t count = 0;
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::lowest();
+      double mean = 0;
+      //! sum of squared differences from the mean (Welford)
+      double m2 = 0;
+      //! value range of the histogram; values outside are counted in the first/last bin
+      double histogram_min = 0;
+      double histogram_max = 0;
+      std::vector<std::uint64_t> histogram;
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET VARIANCE
+      //! population variance (divided by count)
+      [[nodiscard]] double variance() const;
+      [[nodiscard]] double standard_deviation() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET PERCENTILE
+      //! approximate percentile (q in [0,1]) from the histogram; linear interpolation within the bin
+      [[nodiscard]] double percentile(double q) const;
+      [[nodiscard]] double median() const;
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- ADD VALUE
+      //! Welford update
+      void add(double x, int bin)
+      {
+          ++count;
+          min = std::min(min, x);
+          max = std::max(max, x);
+
+          const double d = x - mean;
+          mean += d / static_cast<double>(count);
+          m2 += d * (x - mean);
+
+          if (bin >= 0)
+          { ++histogram[bin]; }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- MERGE
+      //! combines the statistics of two disjoint sets (Chan et al.); histograms must have the same layout
+      void merge(const ImageStatisticsResult& other);
+      /// @}
+  }; // struct ImageStatisticsResult
+
+  //! one-pass parallel statistics of scalar images
+  /*!
+   * - count, min, max, mean, variance, histogram and approximate percentiles
+   * - each thread accumulates its part of the image (Welford); the per-thread results are merged
+   * - optionally restricted to a mask (values != 0) or computed per label of a label image
+   * - the mask/label image may have fewer dimensions than the image, e.g. a 3D segmentation of
+   *   a 3D+t series: it must then match the leading dimensions of the image (the trailing
+   *   dimensions are the fastest-varying ones), i.e. all time steps of a voxel share its label
+   * - if no histogram range is set, a vectorized min/max pass precedes the statistics pass
+   * - set_num_bins(0) disables the histogram (and percentiles)
+   * - per-label statistics have no histograms unless set_histograms_per_label(true) is set
+   * - each thread only stores the slots (labels) that occur in its part of the image if there are
+   *   many of them; the per-thread results are merged in parallel over the slots
+   */
+  class BKDATASET_EXPORT ImageStatistics
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = ImageStatistics;
+
+    public:
+      using result_type = ImageStatisticsResult;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      unsigned int _num_bins;
+      bool _histograms_per_label;
+      bool _has_histogram_range;
+      double _histogram_min;
+      double _histogram_max;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      ImageStatistics();
+      ImageStatistics(const self_type& other);
+      ImageStatistics(self_type&& other) noexcept;
+      ImageStatistics(unsigned int numBins);
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~ImageStatistics();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET NUM BINS
+      [[nodiscard]] unsigned int num_bins() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET HISTOGRAMS PER LABEL
+      [[nodiscard]] bool histograms_per_label() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET HISTOGRAM RANGE
+      [[nodiscard]] bool has_histogram_range() const;
+      [[nodiscard]] double histogram_min() const;
+      [[nodiscard]] double histogram_max() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET NUM BINS
+      void set_num_bins(unsigned int numBins);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET HISTOGRAMS PER LABEL
+      //! compute_per_label() also determines a histogram (and thus percentiles) per label; default: false
+      void set_histograms_per_label(bool b);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET HISTOGRAM RANGE
+      //! fixed histogram range; avoids the additional min/max pass
+      void set_histogram_range(double histogramMin, double histogramMax);
+      //! use the min/max of the image
+      void set_histogram_range_automatic();
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER: PREPARE
+      //! more slots are stored sparsely per thread (only the slots that occur)
+      static constexpr unsigned int MaxNumDenseSlots = 4096;
+
+      [[nodiscard]] result_type _make_empty_result(double histogramMin, double histogramMax, bool withHistogram) const;
+
+      template<typename TImage>
+      [[nodiscard]] std::pair<double, double> _histogram_range(const TImage& img) const
+      {
+          if (_has_histogram_range || img.num_values() == 0)
+          { return {_histogram_min, _histogram_max}; }
+
+          const auto [mi, ma] = details::reduce_minmax(img.span().data(), img.num_values());
+          return {static_cast<double>(mi), static_cast<double>(ma)};
+      }
+
+      //! maps image list ids to mask/label list ids
+      template<typename TImage, typename TLabelImage>
+      [[nodiscard]] static unsigned int _values_per_label_voxel(const TImage& img, const TLabelImage& labels)
+      {
+          assert(labels.num_values() != 0 && img.num_values() % labels.num_values() == 0 && "label image does not match the leading image dimensions");
+          return img.num_values() / labels.num_values();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: MERGE
+      //! res[s] = merge of all per-thread results of slot s; find(local, s) -> const result_type* (nullptr: slot not present)
+      template<typename TLocal, typename TFindFunction>
+      static void _merge(std::vector<result_type>& res, const std::vector<TLocal>& locals, TFindFunction find)
+      {
+          const int numSlots = static_cast<int>(res.size());
+
+          #pragma omp parallel for
+          for (int s = 0; s < numSlots; ++s)
+          {
+              for (const TLocal& local: locals)
+              {
+                  if (const result_type* r = find(local, static_cast<unsigned int>(s)); r != nullptr)
+                  { res[s].merge(*r); }
+              }
+          }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: COMPUTE
+      //! slot_of(listId) -> slot id (-1: skip); slot results are merged over the threads
+      template<typename TImage, typename TSlotFunction>
+      [[nodiscard]] std::vector<result_type> _compute(const TImage& img, unsigned int numSlots, bool withHistogram, TSlotFunction slot_of) const
+      {
+          static_assert(details::is_reducible_v<typename TImage::value_type>, "image statistics require scalar (arithmetic) image values");
+
+          withHistogram = withHistogram && _num_bins != 0;
+
+          const auto [hmin, hmax] = withHistogram ? _histogram_range(img) : std::pair<double, double>(0, 0);
+          const result_type empty = _make_empty_result(hmin, hmax, withHistogram);
+
+          const int nBins = withHistogram ? static_cast<int>(_num_bins) : 0;
+          const double binScale = hmax > hmin ? nBins / (hmax - hmin) : 0.0;
+
+          const auto bin_of = [&](double x)
+          { return nBins != 0 ? std::clamp(static_cast<int>((x - hmin) * binScale), 0, nBins - 1) : -1; };
+
+          std::vector<result_type> res(numSlots, empty);
+
+          const auto* values = img.span().data();
+          const std::int64_t numValues = img.num_values();
+
+          if (numSlots <= MaxNumDenseSlots)
+          {
+              std::vector<std::vector<result_type>> locals;
+
+              #pragma omp parallel
+              {
+                  std::vector<result_type> local(numSlots, empty);
+
+                  #pragma omp for nowait
+                  for (std::int64_t lid = 0; lid < numValues; ++lid)
+                  {
+                      const int slot = slot_of(static_cast<unsigned int>(lid));
+
+                      if (slot < 0)
+                      { continue; }
+
+                      const double x = static_cast<double>(values[lid]);
+                      local[slot].add(x, bin_of(x));
+                  }
+
+                  #pragma omp critical(image_statistics_merge)
+                  { locals.push_back(std::move(local)); }
+              } // omp parallel
+
+              _merge(res, locals, [](const std::vector<result_type>& local, unsigned int s) { return &local[s]; });
+          }
+          else
+          {
+              std::vector<std::unordered_map<int, result_type>> locals;
+
+              #pragma omp parallel
+              {
+                  std::unordered_map<int, result_type> local;
+
+                  // labels are spatially coherent -> consecutive values mostly hit the same slot
+                  int lastSlot = -1;
+                  result_type* last = nullptr;
+
+                  #pragma omp for nowait
+                  for (std::int64_t lid = 0; lid < numValues; ++lid)
+                  {
+                      const int slot = slot_of(static_cast<unsigned int>(lid));
+
+                      if (slot < 0)
+                      { continue; }
+
+                      if (slot != lastSlot)
+                      {
+                          last = &local.try_emplace(slot, empty).first->second;
+                          lastSlot = slot;
+                      }
+
+                      const double x = static_cast<double>(values[lid]);
+                      last->add(x, bin_of(x));
+                  }
+
+                  #pragma omp critical(image_statistics_merge)
+                  { locals.push_back(std::move(local)); }
+              } // omp parallel
+
+              _merge(res, locals, [](const std::unordered_map<int, result_type>& local, unsigned int s) -> const result_type*
+              {
+                  const auto it = local.find(static_cast<int>(s));
+                  return it != local.end() ? &it->second : nullptr;
+              });
+          }
+
+          return res;
+      }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- COMPUTE
+      template<typename TImage>
+      [[nodiscard]] result_type compute(const TImage& img) const
+      { return _compute(img, 1, true, [](unsigned int) { return 0; }).front(); }
+
+      //! only values where mask != 0
+      template<typename TImage, typename TMaskImage>
+      [[nodiscard]] result_type compute(const TImage& img, const TMaskImage& mask) const
+      {
+          const unsigned int div = _values_per_label_voxel(img, mask);
+          return _compute(img, 1, true, [&](unsigned int lid) { return mask[lid / div] != 0 ? 0 : -1; }).front();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- COMPUTE PER LABEL
+      //! statistics of each label (integral values) of the label image; labels without values are omitted
+      /*!
+       * - compact label ranges (<= 2^24) use a lookup table label -> slot, others a hash map
+       * - histograms only if set_histograms_per_label(true)
+       */
+      template<typename TImage, typename TLabelImage>
+      [[nodiscard]] std::map<long long, result_type> compute_per_label(const TImage& img, const TLabelImage& labels, bool ignoreZero = false) const
+      {
+          static_assert(std::is_integral_v<typename TLabelImage::value_type>, "labels must be integral");
+
+          std::map<long long, result_type> res;
+
+          if (img.num_values() == 0 || labels.num_values() == 0)
+          { return res; }
+
+          const unsigned int div = _values_per_label_voxel(img, labels);
+          const auto [labelMin, labelMax] = details::reduce_minmax(labels.span().data(), labels.num_values());
+          const unsigned long long labelRange = static_cast<unsigned long long>(static_cast<long long>(labelMax) - static_cast<long long>(labelMin)) + 1;
+
+          const auto* l = labels.span().data();
+          const std::int64_t numLabelValues = labels.num_values();
+
+          if (labelRange <= (1ULL << 24))
+          {
+              // dense: label -> slot lookup table (labels are usually few and compact)
+              std::vector<int> slotOfLabel;
+              std::vector<long long> labelOfSlot;
+              std::vector<std::uint8_t> present(labelRange, 0);
+
+              #pragma omp parallel for
+              for (std::int64_t i = 0; i < numLabelValues; ++i)
+              { present[static_cast<long long>(l[i]) - labelMin] = 1; }
+
+              slotOfLabel.assign(labelRange, -1);
+              for (unsigned long long i = 0; i < labelRange; ++i)
+              {
+                  const long long label = static_cast<long long>(labelMin) + static_cast<long long>(i);
+
+                  if (present[i] && !(ignoreZero && label == 0))
+                  {
+                      slotOfLabel[i] = static_cast<int>(labelOfSlot.size());
+                      labelOfSlot.push_back(label);
+                  }
+              }
+
+              const auto stats = _compute(img, static_cast<unsigned int>(labelOfSlot.size()), _histograms_per_label, [&](unsigned int lid)
+              { return slotOfLabel[static_cast<long long>(l[lid / div]) - labelMin]; });
+
+              for (unsigned int s = 0; s < stats.size(); ++s)
+              {
+                  if (stats[s].count != 0)
+                  { res.emplace(labelOfSlot[s], stats[s]); }
+              }
+          }
+          else
+          {
+              // sparse labels: hash map label -> slot; one pass to collect the labels, one statistics pass
+              std::unordered_set<long long> uniqueLabels;
+
+              #pragma omp parallel
+              {
+                  std::unordered_set<long long> localLabels;
+
+                  #pragma omp for nowait
+                  for (std::int64_t i = 0; i < numLabelValues; ++i)
+                  { localLabels.insert(static_cast<long long>(l[i])); }
+
+                  #pragma omp critical(image_statistics_labels)
+                  { uniqueLabels.insert(localLabels.begin(), localLabels.end()); }
+              } // omp parallel
+
+              std::vector<long long> labelOfSlot(uniqueLabels.begin(), uniqueLabels.end());
+              std::sort(labelOfSlot.begin(), labelOfSlot.end());
+
+              if (ignoreZero)
+              { labelOfSlot.erase(std::remove(labelOfSlot.begin(), labelOfSlot.end(), 0LL), labelOfSlot.end()); }
+
+              std::unordered_map<long long, int> slotOfLabel;
+              slotOfLabel.reserve(labelOfSlot.size());
+              for (unsigned int s = 0; s < labelOfSlot.size(); ++s)
+              { slotOfLabel.emplace(labelOfSlot[s], static_cast<int>(s)); }
+
+              const auto stats = _compute(img, static_cast<unsigned int>(labelOfSlot.size()), _histograms_per_label, [&](unsigned int lid)
+              {
+                  const auto it = slotOfLabel.find(static_cast<long long>(l[lid / div]));
+                  return it != slotOfLabel.end() ? it->second : -1;
+              });
+
+              for (unsigned int s = 0; s < stats.size(); ++s)
+              {
+                  if (stats[s].count != 0)
+                  { res.emplace(labelOfSlot[s], stats[s]); }
+              }
+          }
+
+          return res;
+      }
+      /// @}
+  }; // class ImageStatistics
+} // namespace bk
+
+#endif //BKDATASET_IMAGESTATISTICS_H
@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/IntegralImage.h>
+
+namespace bk
+{
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  IntegralImage::IntegralImage()
+      : _offset(0)
+  { /* do nothing */ }
+
+  IntegralImage::IntegralImage(const self_type& other) = default;
+  IntegralImage::IntegralImage(self_type&& other) noexcept = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  IntegralImage::~IntegralImage() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET NUM DIMENSIONS
+  unsigned int IntegralImage::num_dimensions() const
+  { return static_cast<unsigned int>(_size.size()); }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET SIZE
+  const std::vector<unsigned int>& IntegralImage::size() const
+  { return _size; }
+
+  unsigned int IntegralImage::size(unsigned int dimId) const
+  { return _size[dimId]; }
+  /// @}
+
+  /// @{ -------------------------------------------------- IS EMPTY
+  bool IntegralImage::is_empty() const
+  { return _sum.empty(); }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto IntegralImage::operator=(const self_type& other) -> self_type& = default;
+  auto IntegralImage::operator=(self_type&& other) noexcept -> self_type& = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- CLEAR
+  void IntegralImage::clear()
+  {
+      _size.clear();
+      _stride.clear();
+      _sum.clear();
+      _sum_sq.clear();
+      _offset = 0;
+  }
+  /// @}
+} // namespace bk
@@ -0,0 +1,366 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_INTEGRALIMAGE_H
+#define BKDATASET_INTEGRALIMAGE_H
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! N-dimensional summed-area table of the values and of the squared values of a scalar image
+  /*!
+   * - sum, mean and variance of arbitrary axis-aligned boxes are obtained in O(2^N),
+   *   independent of the box size
+   * - the tables are padded by one (zero) element at the front of each dimension,
+   *   so queries need no special handling at the lower image border
+   * - the image mean is subtracted before accumulation to reduce the cancellation
+   *   error of the variance (E[x^2] - E[x]^2) for large images
+   */
+  class BKDATASET_EXPORT IntegralImage
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = IntegralImage;
+
+    public:
+      //! upper limit for the number of dimensions
+      static constexpr unsigned int MaxNumDimensions = 8;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      std::vector<unsigned int> _size;
+      std::vector<unsigned int> _stride; // of the padded tables
+      std::vector<double> _sum;
+      std::vector<double> _sum_sq;
+      double _offset;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      IntegralImage();
+      IntegralImage(const self_type& other);
+      IntegralImage(self_type&& other) noexcept;
+
+      template<typename TImage>
+      explicit IntegralImage(const TImage& img)
+          : IntegralImage()
+      { build(img); }
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~IntegralImage();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET NUM DIMENSIONS
+      [[nodiscard]] unsigned int num_dimensions() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SIZE
+      //! size of the source image
+      [[nodiscard]] const std::vector<unsigned int>& size() const;
+      [[nodiscard]] unsigned int size(unsigned int dimId) const;
+      /// @}
+
+      /// @{ -------------------------------------------------- IS EMPTY
+      [[nodiscard]] bool is_empty() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      /// @{ -------------------------------------------------- CLEAR
+      void clear();
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- BUILD
+      //! computes the tables; the prefix sums of each dimension are parallelized over the lines
+      template<typename TImage>
+      void build(const TImage& img)
+      {
+          using value_type = typename TImage::value_type;
+          static_assert(std::is_arithmetic_v<value_type>, "integral images require scalar (arithmetic) image values");
+
+          const unsigned int nDims = img.num_dimensions();
+          assert(nDims <= MaxNumDimensions && "too many dimensions");
+
+          _size.resize(nDims);
+          _stride.resize(nDims);
+
+          unsigned int numPadded = 1;
+          for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
+          {
+              _size[dimId] = img.size(dimId);
+              _stride[dimId] = numPadded;
+              numPadded *= _size[dimId] + 1;
+          }
+
+          const int numValues = static_cast<int>(img.num_values());
+          _offset = numValues != 0 ? static_cast<double>(img.mean_value()) : 0.0;
+
+          _sum.assign(numPadded, 0.0);
+          _sum_sq.assign(numPadded, 0.0);
+
+          // copy values into the padded tables
+          #pragma omp parallel for
+          for (int lid = 0; lid < numValues; ++lid)
+          {
+              unsigned int temp = static_cast<unsigned int>(lid);
+              unsigned int pid = 0;
+
+              for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
+              {
+                  pid += (temp % _size[dimId] + 1) * _stride[dimId];
+                  temp /= _size[dimId];
+              }
+
+              const double v = static_cast<double>(img[lid]) - _offset;
+              _sum[pid] = v;
+              _sum_sq[pid] = v * v;
+          }
+
+          // prefix sums along each dimension
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              const unsigned int n = _size[dimId] + 1;
+              const unsigned int stride = _stride[dimId];
+              const int numLines = static_cast<int>(numPadded / n);
+
+              #pragma omp parallel for
+              for (int lineId = 0; lineId < numLines; ++lineId)
+              {
+                  const unsigned int outer = static_cast<unsigned int>(lineId) / stride;
+                  const unsigned int inner = static_cast<unsigned int>(lineId) % stride;
+                  const unsigned int first = outer * stride * n + inner;
+
+                  for (unsigned int k = 1, off = first + stride; k < n; ++k, off += stride)
+                  {
+                      _sum[off] += _sum[off - stride];
+                      _sum_sq[off] += _sum_sq[off - stride];
+                  }
+              }
+          }
+      }
+      /// @}
+
+    private:
+      /// @{ -------------------------------------------------- HELPER: BOX
+      //! inclusion-exclusion over the 2^N corners; [first, last] is inclusive and intersected with the image (empty if they do not overlap)
+      template<typename TIndexAccessible0, typename TIndexAccessible1>
+      void _box(const TIndexAccessible0& first, const TIndexAccessible1& last, double& sum, double& sumSq, unsigned int& num) const
+      {
+          const unsigned int nDims = num_dimensions();
+
+          unsigned int lo[MaxNumDimensions];
+          unsigned int hi[MaxNumDimensions];
+          num = 1;
+
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              const int s = static_cast<int>(_size[dimId]);
+              const int a = std::max(static_cast<int>(first[dimId]), 0);
+              const int b = std::min(static_cast<int>(last[dimId]), s - 1);
+
+              if (b < a)
+              {
+                  sum = sumSq = 0;
+                  num = 0;
+                  return;
+              }
+
+              // padded table: element i+1 holds the prefix up to (and including) grid position i
+              lo[dimId] = static_cast<unsigned int>(a) * _stride[dimId];
+              hi[dimId] = static_cast<unsigned int>(b + 1) * _stride[dimId];
+              num *= static_cast<unsigned int>(b - a + 1);
+          }
+
+          sum = 0;
+          sumSq = 0;
+
+          const unsigned int nCorners = 1U << nDims;
+          for (unsigned int c = 0; c < nCorners; ++c)
+          {
+              unsigned int off = 0;
+              unsigned int numLow = 0;
+
+              for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+              {
+                  if ((c >> dimId) & 1U)
+                  { off += hi[dimId]; }
+                  else
+                  {
+                      off += lo[dimId];
+                      ++numLow;
+                  }
+              }
+
+              if (numLow & 1U)
+              {
+                  sum -= _sum[off];
+                  sumSq -= _sum_sq[off];
+              }
+              else
+              {
+                  sum += _sum[off];
+                  sumSq += _sum_sq[off];
+              }
+          }
+      }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- BOX QUERIES
+      //! number of image values in the box [first, last] (inclusive, intersected with the image)
+      template<typename TIndexAccessible0, typename TIndexAccessible1>
+      [[nodiscard]] unsigned int box_num_values(const TIndexAccessible0& first, const TIndexAccessible1& last) const
+      {
+          double s = 0;
+          double sq = 0;
+          unsigned int n = 0;
+          _box(first, last, s, sq, n);
+          return n;
+      }
+
+      template<typename TIndexAccessible0, typename TIndexAccessible1>
+      [[nodiscard]] double box_sum(const TIndexAccessible0& first, const TIndexAccessible1& last) const
+      {
+          double s = 0;
+          double sq = 0;
+          unsigned int n = 0;
+          _box(first, last, s, sq, n);
+          return s + n * _offset;
+      }
+
+      template<typename TIndexAccessible0, typename TIndexAccessible1>
+      [[nodiscard]] double box_mean(const TIndexAccessible0& first, const TIndexAccessible1& last) const
+      {
+          double s = 0;
+          double sq = 0;
+          unsigned int n = 0;
+          _box(first, last, s, sq, n);
+          return n != 0 ? s / n + _offset : 0.0;
+      }
+
+      //! population variance (divided by the number of values)
+      template<typename TIndexAccessible0, typename TIndexAccessible1>
+      [[nodiscard]] double box_variance(const TIndexAccessible0& first, const TIndexAccessible1& last) const
+      {
+          double s = 0;
+          double sq = 0;
+          unsigned int n = 0;
+          _box(first, last, s, sq, n);
+
+          if (n == 0)
+          { return 0; }
+
+          const double m = s / n;
+          return std::max(sq / n - m * m, 0.0);
+      }
+
+      //! single query; returns {mean, variance}
+      template<typename TIndexAccessible0, typename TIndexAccessible1>
+      [[nodiscard]] std::pair<double, double> box_mean_and_variance(const TIndexAccessible0& first, const TIndexAccessible1& last) const
+      {
+          double s = 0;
+          double sq = 0;
+          unsigned int n = 0;
+          _box(first, last, s, sq, n);
+
+          if (n == 0)
+          { return {0.0, 0.0}; }
+
+          const double m = s / n;
+          return {m + _offset, std::max(sq / n - m * m, 0.0)};
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- FOR EACH CENTERED BOX
+      //! calls f(listId, mean, variance) for the box of the given size centered at each image position
+      /*!
+       * - O(2^N) per position, independent of the box size; parallelized over the positions
+       * - boxes are clipped at the image border, i.e. only values inside of the image are considered
+       */
+      template<typename TIndexAccessible, typename TFunction>
+      void for_each_centered_box(const TIndexAccessible& boxSize, TFunction f) const
+      {
+          const unsigned int nDims = num_dimensions();
+
+          unsigned int numValues = 1;
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          { numValues *= _size[dimId]; }
+
+          #pragma omp parallel
+          {
+              int first[MaxNumDimensions];
+              int last[MaxNumDimensions];
+
+              #pragma omp for
+              for (int lid = 0; lid < static_cast<int>(numValues); ++lid)
+              {
+                  unsigned int temp = static_cast<unsigned int>(lid);
+
+                  for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
+                  {
+                      const int g = static_cast<int>(temp % _size[dimId]);
+                      temp /= _size[dimId];
+
+                      const int k = static_cast<int>(boxSize[dimId]);
+                      first[dimId] = g - k / 2;
+                      last[dimId] = g + (k - 1) / 2;
+                  }
+
+                  const auto [mean, variance] = box_mean_and_variance(first, last);
+                  f(static_cast<unsigned int>(lid), mean, variance);
+              }
+          } // omp parallel
+      }
+      /// @}
+  }; // class IntegralImage
+} // namespace bk
+
+#endif //BKDATASET_INTEGRALIMAGE_H
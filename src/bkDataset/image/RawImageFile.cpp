@@ -0,0 +1,328 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/RawImageFile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace bk
+{
+  namespace
+  {
+    constexpr char RawImageMagic[8] = {'B', 'K', 'R', 'A', 'W', 'I', 'M', 'G'};
+    constexpr std::uint32_t RawImageByteOrderMark = 0x01020304;
+
+    //! reads a T from the mapped memory and advances pos; false if the file is too short
+    template<typename T>
+    bool read_from(const char* data, std::size_t num_bytes, std::size_t& pos, T& x)
+    {
+        if (pos + sizeof(T) > num_bytes)
+        { return false; }
+
+        std::memcpy(&x, data + pos, sizeof(T));
+        pos += sizeof(T);
+
+        return true;
+    }
+
+    template<typename T>
+    void write_to(std::ofstream& file, const T& x)
+    { file.write(reinterpret_cast<const char*>(&x), sizeof(T)); }
+
+    std::uint64_t align_up(std::uint64_t x)
+    { return (x + RawImageFile::DataAlignment() - 1) / RawImageFile::DataAlignment() * RawImageFile::DataAlignment(); }
+  } // anonymous namespace
+
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  RawImageFile::RawImageFile()
+      : _scalar_type(RawImageScalarType::Unknown),
+        _num_components(0),
+        _value_size(0),
+        _transformation_offset(0),
+        _transformation_num_bytes(0)
+  { /* do nothing */ }
+
+  RawImageFile::RawImageFile(self_type&&) noexcept = default;
+
+  RawImageFile::RawImageFile(std::string_view filepath)
+      : RawImageFile()
+  { open(filepath); }
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  RawImageFile::~RawImageFile() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- IS OPEN
+  bool RawImageFile::is_open() const
+  { return _file.is_open(); }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET FILEPATH
+  const std::string& RawImageFile::filepath() const
+  { return _file.filepath(); }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET SIZE
+  unsigned int RawImageFile::num_dimensions() const
+  { return static_cast<unsigned int>(_size.size()); }
+
+  const std::vector<unsigned int>& RawImageFile::size() const
+  { return _size; }
+
+  unsigned int RawImageFile::size(unsigned int dimId) const
+  { return _size[dimId]; }
+
+  std::uint64_t RawImageFile::num_values() const
+  {
+      if (_size.empty())
+      { return 0; }
+
+      std::uint64_t n = 1;
+
+      for (unsigned int s: _size)
+      { n *= s; }
+
+      return n;
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET VALUE TYPE
+  RawImageScalarType RawImageFile::scalar_type() const
+  { return _scalar_type; }
+
+  std::uint32_t RawImageFile::num_components() const
+  { return _num_components; }
+
+  std::uint32_t RawImageFile::value_size() const
+  { return _value_size; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET ATTRIBUTES
+  const std::vector<RawImageFile::Attribute>& RawImageFile::attributes() const
+  { return _attributes; }
+
+  bool RawImageFile::has_attribute(std::uint64_t hash) const
+  { return attribute(hash) != nullptr; }
+
+  auto RawImageFile::attribute(std::uint64_t hash) const -> const Attribute*
+  {
+      auto it = std::find_if(_attributes.begin(), _attributes.end(), [&](const Attribute& a)
+      { return a.hash == hash; });
+
+      return it != _attributes.end() ? &*it : nullptr;
+  }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto RawImageFile::operator=(self_type&&) noexcept -> self_type& = default;
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPEN
+  bool RawImageFile::open(std::string_view filepath)
+  {
+      close();
+
+      if (!_file.open(filepath))
+      { return false; }
+
+      const char* data = _file.data();
+      const std::size_t numBytes = _file.size();
+      std::size_t pos = 0;
+
+      /*
+       * magic, version, byte order
+       */
+      char magic[8];
+      std::uint32_t version = 0;
+      std::uint32_t byteOrderMark = 0;
+
+      bool success = read_from(data, numBytes, pos, magic) && std::memcmp(magic, RawImageMagic, 8) == 0;
+      success = success && read_from(data, numBytes, pos, version) && version == Version();
+      success = success && read_from(data, numBytes, pos, byteOrderMark) && byteOrderMark == RawImageByteOrderMark;
+
+      /*
+       * size
+       */
+      std::uint32_t numDimensions = 0;
+      success = success && read_from(data, numBytes, pos, numDimensions) && numDimensions != 0;
+
+      if (success)
+      {
+          _size.resize(numDimensions);
+
+          for (std::uint32_t dimId = 0; dimId < numDimensions && success; ++dimId)
+          {
+              std::uint32_t uitemp = 0;
+              success = read_from(data, numBytes, pos, uitemp);
+              _size[dimId] = uitemp;
+          }
+      }
+
+      /*
+       * value type
+       */
+      std::uint32_t scalarType = 0;
+      success = success && read_from(data, numBytes, pos, scalarType);
+      success = success && read_from(data, numBytes, pos, _num_components);
+      success = success && read_from(data, numBytes, pos, _value_size);
+      _scalar_type = static_cast<RawImageScalarType>(scalarType);
+
+      /*
+       * transformation (skipped; see load_transformation())
+       */
+      success = success && read_from(data, numBytes, pos, _transformation_num_bytes);
+      success = success && _transformation_num_bytes <= numBytes - pos; // pos <= numBytes after read_from; no wrap-around
+      _transformation_offset = pos;
+
+      if (success)
+      { pos += _transformation_num_bytes; }
+
+      /*
+       * attributes
+       */
+      std::uint32_t numAttributes = 0;
+      success = success && read_from(data, numBytes, pos, numAttributes);
+
+      for (std::uint32_t i = 0; i < numAttributes && success; ++i)
+      {
+          Attribute a{0, 0, 0, nullptr};
+          success = read_from(data, numBytes, pos, a.hash) && read_from(data, numBytes, pos, a.offset) && read_from(data, numBytes, pos, a.num_bytes);
+          success = success && a.offset <= numBytes && a.num_bytes <= numBytes - a.offset; // no wrap-around on corrupt headers
+
+          if (success)
+          {
+              a.data = data + a.offset;
+              _attributes.push_back(a);
+          }
+      }
+
+      if (!success)
+      { close(); }
+
+      return success;
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- CLOSE
+  void RawImageFile::close()
+  {
+      _file.close();
+      _size.clear();
+      _scalar_type = RawImageScalarType::Unknown;
+      _num_components = 0;
+      _value_size = 0;
+      _transformation_offset = 0;
+      _transformation_num_bytes = 0;
+      _attributes.clear();
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- HELPERS: SAVE
+  bool RawImageFile::_save_header_begin(std::ofstream& file, const std::vector<unsigned int>& size, RawImageScalarType scalarType, std::uint32_t numComponents, std::uint32_t valueSize)
+  {
+      if (!file.is_open() || !file.good() || size.empty())
+      { return false; }
+
+      file.write(RawImageMagic, 8);
+      write_to(file, Version());
+      write_to(file, RawImageByteOrderMark);
+
+      write_to(file, static_cast<std::uint32_t>(size.size()));
+
+      for (unsigned int s: size)
+      { write_to(file, static_cast<std::uint32_t>(s)); }
+
+      write_to(file, static_cast<std::uint32_t>(scalarType));
+      write_to(file, numComponents);
+      write_to(file, valueSize);
+
+      return file.good();
+  }
+
+  std::streamoff RawImageFile::_save_transformation_begin(std::ofstream& file)
+  {
+      // placeholder; the size is known after the transformation was written
+      write_to(file, static_cast<std::uint64_t>(0));
+      return file.tellp();
+  }
+
+  bool RawImageFile::_save_transformation_end(std::ofstream& file, std::streamoff posTransformationBegin)
+  {
+      const std::streamoff posTransformationEnd = file.tellp();
+      const std::uint64_t numBytes = static_cast<std::uint64_t>(posTransformationEnd - posTransformationBegin);
+
+      file.seekp(posTransformationBegin - static_cast<std::streamoff>(sizeof(std::uint64_t)), std::ios_base::beg);
+      write_to(file, numBytes);
+      file.seekp(posTransformationEnd, std::ios_base::beg);
+
+      return file.good();
+  }
+
+  bool RawImageFile::_save_attributes(std::ofstream& file, const std::vector<Attribute>& attributes)
+  {
+      write_to(file, static_cast<std::uint32_t>(attributes.size()));
+
+      const std::uint64_t posTableEnd = static_cast<std::uint64_t>(file.tellp()) + attributes.size() * 3 * sizeof(std::uint64_t);
+
+      std::vector<std::uint64_t> offsets(attributes.size());
+      std::uint64_t off = align_up(posTableEnd);
+
+      for (unsigned int i = 0; i < attributes.size(); ++i)
+      {
+          offsets[i] = off;
+          off = align_up(off + attributes[i].num_bytes);
+
+          write_to(file, attributes[i].hash);
+          write_to(file, offsets[i]);
+          write_to(file, attributes[i].num_bytes);
+      }
+
+      const std::vector<char> zeros(DataAlignment(), 0);
+
+      for (unsigned int i = 0; i < attributes.size(); ++i)
+      {
+          const std::uint64_t padding = offsets[i] - static_cast<std::uint64_t>(file.tellp());
+          file.write(zeros.data(), static_cast<std::streamsize>(padding));
+          file.write(attributes[i].data, static_cast<std::streamsize>(attributes[i].num_bytes));
+      }
+
+      return file.good();
+  }
+  /// @}
+} // namespace bk
@@ -0,0 +1,338 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKDATASET_RAWIMAGEFILE_H
+#define BKDATASET_RAWIMAGEFILE_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <bk/IO>
+#include <bk/Matrix>
+#include <bk/NDContainer>
+#include <bkMath/numeric/Half.h>
+#include <bkTypeTraits/complex_traits.h>
+
+#include <bkDataset/image/ERawImageScalarType.h>
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! versioned binary image format; the value arrays are memory-mapped on load
+  /*!
+   * file layout (native byte order):
+   *
+   *     char[8]    magic "BKRAWIMG"
+   *     uint32     version
+   *     uint32     byte order mark (0x01020304)
+   *     uint32     number of dimensions N
+   *     uint32[N]  size (last dimension has stride 1)
+   *     uint32     scalar type (RawImageScalarType)
+   *     uint32     number of scalar components per value (e.g. 3 for Vec3d)
+   *     uint32     bytes per value
+   *     uint64     number of bytes of the transformation block
+   *     [...]      transformation block (written by TTransformation::save(std::ofstream&))
+   *     uint32     number of attributes M
+   *     M x        uint64 attribute hash, uint64 byte offset (from file begin), uint64 number of bytes
+   *     [...]      attribute arrays, each starts at a multiple of DataAlignment()
+   *
+   * The image values are stored as attribute with Image::DefaultAttributeHash().
+   * Values of static matrix types (e.g. Vec3d) are stored as their contiguous elements.
+   * Values of an opened file can be accessed via values<T>() (or component_values<T>() for matrix types) without copying.
+   */
+  class BKDATASET_EXPORT RawImageFile
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = RawImageFile;
+
+    public:
+      struct Attribute
+      {
+          std::uint64_t hash;
+          std::uint64_t offset;
+          std::uint64_t num_bytes;
+          const char* data;
+      };
+
+      [[nodiscard]] static constexpr std::uint32_t Version() noexcept
+      { return 1; }
+
+      [[nodiscard]] static constexpr std::uint64_t DataAlignment() noexcept
+      { return 4096; }
+
+      [[nodiscard]] static constexpr const char* Suffix() noexcept
+      { return ".bkraw"; }
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      MemoryMappedFile _file;
+      std::vector<unsigned int> _size;
+      RawImageScalarType _scalar_type;
+      std::uint32_t _num_components;
+      std::uint32_t _value_size;
+      std::uint64_t _transformation_offset;
+      std::uint64_t _transformation_num_bytes;
+      std::vector<Attribute> _attributes;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      RawImageFile();
+      RawImageFile(const self_type&) = delete;
+      RawImageFile(self_type&&) noexcept;
+      explicit RawImageFile(std::string_view filepath);
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~RawImageFile();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- IS OPEN
+      [[nodiscard]] bool is_open() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET FILEPATH
+      [[nodiscard]] const std::string& filepath() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SIZE
+      [[nodiscard]] unsigned int num_dimensions() const;
+      [[nodiscard]] const std::vector<unsigned int>& size() const;
+      [[nodiscard]] unsigned int size(unsigned int dimId) const;
+      [[nodiscard]] std::uint64_t num_values() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET VALUE TYPE
+      [[nodiscard]] RawImageScalarType scalar_type() const;
+      [[nodiscard]] std::uint32_t num_components() const;
+      [[nodiscard]] std::uint32_t value_size() const;
+
+      template<typename T>
+      [[nodiscard]] bool value_type_matches() const
+      { return _scalar_type == scalar_type_of<T>() && _num_components == num_components_of<T>() && _value_size == sizeof(T); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET ATTRIBUTES
+      [[nodiscard]] const std::vector<Attribute>& attributes() const;
+      [[nodiscard]] bool has_attribute(std::uint64_t hash) const;
+      [[nodiscard]] const Attribute* attribute(std::uint64_t hash) const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET VALUES
+      //! view of the (memory-mapped) attribute array; empty if the attribute does not exist or has a different type
+      template<typename T>
+      [[nodiscard]] Span<const T> values(std::uint64_t hash) const
+      {
+          static_assert(std::is_trivially_copyable_v<T>, "use component_values() for static matrix types");
+
+          const Attribute* a = attribute(hash);
+
+          if (a == nullptr || !value_type_matches<T>() || a->num_bytes != num_values() * sizeof(T))
+          { return Span<const T>(); }
+
+          return Span<const T>(reinterpret_cast<const T*>(a->data), static_cast<std::size_t>(num_values()));
+      }
+
+      //! view of the attribute array of a static matrix type as its elements (num_components_of<T>() per value)
+      template<typename T>
+      [[nodiscard]] Span<const typename T::value_type> component_values(std::uint64_t hash) const
+      {
+          static_assert(bk::is_static_matrix_v<T>, "component_values() is meant for static matrix types; use values() otherwise");
+
+          using component_type = typename T::value_type;
+          constexpr std::size_t numElements = static_cast<std::size_t>(T::RowsAtCompileTime() * T::ColsAtCompileTime());
+
+          const Attribute* a = attribute(hash);
+
+          if (a == nullptr || !value_type_matches<T>() || a->num_bytes != num_values() * sizeof(T))
+          { return Span<const component_type>(); }
+
+          return Span<const component_type>(reinterpret_cast<const component_type*>(a->data), static_cast<std::size_t>(num_values()) * numElements);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET TRANSFORMATION
+      template<typename TTransformation>
+      [[maybe_unused]] bool load_transformation(TTransformation& transformation) const
+      {
+          if (!is_open())
+          { return false; }
+
+          std::ifstream file(filepath(), std::ios_base::in | std::ios_base::binary);
+
+          if (!file.is_open())
+          { return false; }
+
+          file.seekg(static_cast<std::streamoff>(_transformation_offset), std::ios_base::beg);
+
+          const bool success = transformation.load(file);
+          const std::uint64_t numBytesRead = static_cast<std::uint64_t>(file.tellg()) - _transformation_offset;
+
+          return success && numBytesRead == _transformation_num_bytes;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- SCALAR TYPE OF
+      template<typename T>
+      [[nodiscard]] static constexpr RawImageScalarType scalar_type_of()
+      {
+          if constexpr (bk::is_static_matrix_v<T> || bk::is_complex_v<T>)
+          { return scalar_type_of<typename T::value_type>(); }
+          else if constexpr (std::is_same_v<T, Half>)
+          { return RawImageScalarType::Float16; }
+          else if constexpr (std::is_same_v<T, bool> || !std::is_arithmetic_v<T>)
+          { return RawImageScalarType::Unknown; }
+          else if constexpr (std::is_floating_point_v<T>)
+          {
+              if constexpr (sizeof(T) == 4)
+              { return RawImageScalarType::Float32; }
+              else if constexpr (sizeof(T) == 8)
+              { return RawImageScalarType::Float64; }
+              else
+              { return RawImageScalarType::Unknown; }
+          }
+          else if constexpr (std::is_signed_v<T>)
+          {
+              if constexpr (sizeof(T) == 1)
+              { return RawImageScalarType::Int8; }
+              else if constexpr (sizeof(T) == 2)
+              { return RawImageScalarType::Int16; }
+              else if constexpr (sizeof(T) == 4)
+              { return RawImageScalarType::Int32; }
+              else
+              { return RawImageScalarType::Int64; }
+          }
+          else
+          {
+              if constexpr (sizeof(T) == 1)
+              { return RawImageScalarType::UInt8; }
+              else if constexpr (sizeof(T) == 2)
+              { return RawImageScalarType::UInt16; }
+              else if constexpr (sizeof(T) == 4)
+              { return RawImageScalarType::UInt32; }
+              else
+              { return RawImageScalarType::UInt64; }
+          }
+      }
+
+      //! trivially copyable types and static matrices thereof without padding (stored as contiguous elements)
+      template<typename T>
+      [[nodiscard]] static constexpr bool is_storable()
+      {
+          if constexpr (bk::is_static_matrix_v<T>)
+          { return is_storable<typename T::value_type>() && sizeof(T) == static_cast<std::size_t>(T::RowsAtCompileTime() * T::ColsAtCompileTime()) * sizeof(typename T::value_type); }
+          else
+          { return std::is_trivially_copyable_v<T>; }
+      }
+
+      template<typename T>
+      [[nodiscard]] static constexpr std::uint32_t num_components_of()
+      {
+          if constexpr (bk::is_static_matrix_v<T>)
+          { return static_cast<std::uint32_t>(T::RowsAtCompileTime() * T::ColsAtCompileTime()) * num_components_of<typename T::value_type>(); }
+          else if constexpr (bk::is_complex_v<T>)
+          { return 2 * num_components_of<typename T::value_type>(); }
+          else
+          { return 1; }
+      }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type&) -> self_type& = delete;
+      [[maybe_unused]] auto operator=(self_type&&) noexcept -> self_type&;
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPEN
+      //! maps the file and parses the header; the attribute arrays are not copied
+      [[maybe_unused]] bool open(std::string_view filepath);
+      /// @}
+
+      /// @{ -------------------------------------------------- CLOSE
+      void close();
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPERS: SAVE
+    private:
+      [[nodiscard]] static bool _save_header_begin(std::ofstream& file, const std::vector<unsigned int>& size, RawImageScalarType scalarType, std::uint32_t numComponents, std::uint32_t valueSize);
+      [[nodiscard]] static std::streamoff _save_transformation_begin(std::ofstream& file);
+      [[nodiscard]] static bool _save_transformation_end(std::ofstream& file, std::streamoff posTransformationBegin);
+      [[nodiscard]] static bool _save_attributes(std::ofstream& file, const std::vector<Attribute>& attributes);
+    public:
+      /// @}
+
+      /// @{ -------------------------------------------------- SAVE
+      //! writes a raw image file
+      /*!
+       * - attributes: hash, num_bytes and data must be set (offset is determined automatically);
+       *   each attribute array must contain one value of type TValue per grid point
+       */
+      template<typename TValue, typename TTransformation>
+      [[maybe_unused]] static bool save(std::string_view filepath, const std::vector<unsigned int>& size, const TTransformation& transformation, const std::vector<Attribute>& attributes)
+      {
+          static_assert(is_storable<TValue>(), "raw image files require trivially copyable value types or static matrices thereof");
+
+          std::ofstream file(filepath.data(), std::ios_base::out | std::ios_base::binary);
+
+          if (!_save_header_begin(file, size, scalar_type_of<TValue>(), num_components_of<TValue>(), sizeof(TValue)))
+          { return false; }
+
+          const std::streamoff posTransformationBegin = _save_transformation_begin(file);
+
+          if (!transformation.save(file) || !_save_transformation_end(file, posTransformationBegin))
+          { return false; }
+
+          const bool success = _save_attributes(file, attributes);
+
+          file.close();
+
+          return success;
+      }
+      /// @}
+  }; // class RawImageFile
+} // namespace bk
+
+#endif //BKDATASET_RAWIMAGEFILE_H
@@ -39,7 +39,8 @@ namespace bk
 
   AverageSmoothingImageFilter::AverageSmoothingImageFilter(unsigned int numIterations, unsigned int nDims, unsigned int size)
       : _num_iterations(numIterations),
-        _kernel_size(nDims, size)
+        _kernel_size(nDims, size),
+        _use_integral_image(false)
   { /* do nothing */ }
   /// @}
 
@@ -60,6 +61,11 @@ namespace bk
   { return _kernel_size; }
   /// @}
 
+  /// @{ -------------------------------------------------- GET USE INTEGRAL IMAGE
+  bool AverageSmoothingImageFilter::use_integral_image() const
+  { return _use_integral_image; }
+  /// @}
+
   //====================================================================================================
   //===== SETTER
   //====================================================================================================
@@ -77,4 +83,9 @@ namespace bk
   void AverageSmoothingImageFilter::set_kernel_size(unsigned int nDims, unsigned int size)
   { _kernel_size.assign(nDims, size); }
   /// @}
+
+  /// @{ -------------------------------------------------- SET USE INTEGRAL IMAGE
+  void AverageSmoothingImageFilter::set_use_integral_image(bool b)
+  { _use_integral_image = b; }
+  /// @}
 } // namespace bk
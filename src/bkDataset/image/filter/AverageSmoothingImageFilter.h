@@ -35,6 +35,8 @@
 #include "ConvolutionImageFilter.h"
 #include "KernelFactory.h"
 
+#include <bkDataset/image/IntegralImage.h>
+
 #include <bkDataset/lib/bkDataset_export.h>
 
 namespace bk
@@ -51,6 +53,7 @@ namespace bk
       //====================================================================================================
       unsigned int _num_iterations;
       std::vector<unsigned int> _kernel_size;
+      bool _use_integral_image;
 
       //====================================================================================================
       //===== CONSTRUCTORS & DESTRUCTOR
@@ -78,6 +81,10 @@ namespace bk
       [[nodiscard]] const std::vector<unsigned int>& kernel_size() const;
       /// @}
 
+      /// @{ -------------------------------------------------- GET USE INTEGRAL IMAGE
+      [[nodiscard]] bool use_integral_image() const;
+      /// @}
+
       //====================================================================================================
       //===== SETTER
       //====================================================================================================
@@ -102,6 +109,15 @@ namespace bk
       void set_kernel_size(unsigned int nDims, unsigned int size);
       /// @}
 
+      /// @{ -------------------------------------------------- SET USE INTEGRAL IMAGE
+      //! O(2^N) per voxel independent of the kernel size (scalar images only)
+      /*!
+       * The box is clipped at the image border (only values inside of the image are averaged),
+       * whereas the convolution clamps positions outside of the image to the border.
+       */
+      void set_use_integral_image(bool b);
+      /// @}
+
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
@@ -111,6 +127,25 @@ namespace bk
       {
           assert(!_kernel_size.empty() && "call set_kernel_size() first");
 
+          if constexpr (std::is_arithmetic_v<typename TImage::value_type>)
+          {
+              if (_use_integral_image)
+              {
+                  TImage res = img;
+
+                  for (unsigned int iterId = 0; iterId < _num_iterations; ++iterId)
+                  {
+                      const IntegralImage ii(res);
+                      ii.for_each_centered_box(_kernel_size, [&](unsigned int lid, double mean, double /*variance*/)
+                      { res[lid] = mean; });
+                  }
+
+                  res.invalidate_cache();
+
+                  return res;
+              }
+          }
+
           const bool kernel_has_isotropic_size = std::all_of(_kernel_size.begin(), _kernel_size.end(), [&](unsigned int x)
           { return x == _kernel_size.front(); });
 
@@ -24,15 +24,24 @@
 
 #include <bkDataset/image/filter/ConnectedComponentsAnalysisImageFilter.h>
 
+#include <cassert>
+
 namespace bk
 {
   //====================================================================================================
   //===== CONSTRUCTORS & DESTRUCTOR
   //====================================================================================================
   /// @{ -------------------------------------------------- CTOR
-  ConnectedComponentAnalysisImageFilter::ConnectedComponentAnalysisImageFilter() = default;
+  ConnectedComponentAnalysisImageFilter::ConnectedComponentAnalysisImageFilter()
+      : ConnectedComponentAnalysisImageFilter(ImageConnectivity::Face)
+  { /* do nothing */ }
+
   ConnectedComponentAnalysisImageFilter::ConnectedComponentAnalysisImageFilter(const self_type&) = default;
   ConnectedComponentAnalysisImageFilter::ConnectedComponentAnalysisImageFilter(self_type&&) noexcept = default;
+
+  ConnectedComponentAnalysisImageFilter::ConnectedComponentAnalysisImageFilter(ImageConnectivity connectivity)
+      : _connectivity(connectivity)
+  { /* do nothing */ }
   /// @}
 
   /// @{ -------------------------------------------------- DTOR
@@ -42,6 +51,11 @@ namespace bk
   //====================================================================================================
   //===== GETTER
   //====================================================================================================
+  /// @{ -------------------------------------------------- GET CONNECTIVITY
+  ImageConnectivity ConnectedComponentAnalysisImageFilter::connectivity() const
+  { return _connectivity; }
+  /// @}
+
   /// @{ -------------------------------------------------- GET NUM LABELS
   unsigned int ConnectedComponentAnalysisImageFilter::num_labels() const
   { return _labels.size(); }
@@ -62,6 +76,34 @@ namespace bk
   }
   /// @}
 
+  /// @{ -------------------------------------------------- GET COMPONENTS
+  const std::vector<ConnectedComponent>& ConnectedComponentAnalysisImageFilter::components() const
+  { return _components; }
+
+  const ConnectedComponent& ConnectedComponentAnalysisImageFilter::component(unsigned int labelId) const
+  {
+      assert(labelId != 0 && labelId <= _components.size() && "invalid label id");
+      return _components[labelId - 1];
+  }
+
+  unsigned int ConnectedComponentAnalysisImageFilter::largest_label() const
+  {
+      unsigned int maxSizeLabelId = 0;
+      unsigned int maxSize = 0;
+
+      for (const ConnectedComponent& c: _components)
+      {
+          if (c.num_voxels > maxSize)
+          {
+              maxSize = c.num_voxels;
+              maxSizeLabelId = c.label;
+          }
+      }
+
+      return maxSizeLabelId;
+  }
+  /// @}
+
   //====================================================================================================
   //===== SETTER
   //====================================================================================================
@@ -69,4 +111,58 @@ namespace bk
   auto ConnectedComponentAnalysisImageFilter::operator=(const self_type&) -> self_type& = default;
   auto ConnectedComponentAnalysisImageFilter::operator=(self_type&&) noexcept -> self_type& = default;
   /// @}
+
+  /// @{ -------------------------------------------------- SET CONNECTIVITY
+  void ConnectedComponentAnalysisImageFilter::set_connectivity(ImageConnectivity connectivity)
+  { _connectivity = connectivity; }
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- HELPER: NEIGHBOR OFFSETS
+  std::vector<int> ConnectedComponentAnalysisImageFilter::_backward_neighbor_offsets(unsigned int nDims) const
+  {
+      const unsigned int maxNonZero = _connectivity == ImageConnectivity::Full ? nDims : static_cast<unsigned int>(_connectivity);
+
+      std::vector<int> offsets;
+      std::vector<int> off(nDims, -1);
+
+      // enumerate {-1,0,1}^nDims
+      while (true)
+      {
+          unsigned int numNonZero = 0;
+          int firstNonZero = 0;
+
+          for (unsigned int d = 0; d < nDims; ++d)
+          {
+              if (off[d] != 0)
+              {
+                  if (numNonZero == 0)
+                  { firstNonZero = off[d]; }
+
+                  ++numNonZero;
+              }
+          }
+
+          // first non-zero offset < 0 <=> smaller list id
+          if (firstNonZero < 0 && numNonZero <= maxNonZero)
+          { offsets.insert(offsets.end(), off.begin(), off.end()); }
+
+          int d = static_cast<int>(nDims) - 1;
+          for (; d >= 0; --d)
+          {
+              if (++off[d] <= 1)
+              { break; }
+
+              off[d] = -1;
+          }
+
+          if (d < 0)
+          { break; }
+      }
+
+      return offsets;
+  }
+  /// @}
 } // namespace bk
\ No newline at end of file
@@ -27,11 +27,12 @@
 #ifndef BK_CONNECTEDCOMPONENTSANALYSISIMAGEFILTER_H
 #define BK_CONNECTEDCOMPONENTSANALYSISIMAGEFILTER_H
 
+#include <algorithm>
+#include <limits>
 #include <map>
-#include <queue>
 #include <vector>
 
-#include <bkMath/functions/list_grid_id_conversion.h>
+#include <bkDataset/image/EImageConnectivity.h>
 #include <bkDataset/lib/bkDataset_export.h>
 
 #ifdef BK_EMIT_PROGRESS
@@ -41,6 +42,28 @@
 
 namespace bk
 {
+  //! per-label statistics of ConnectedComponentAnalysisImageFilter (grid coordinates)
+  struct ConnectedComponent
+  {
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      unsigned int label = 0;
+      unsigned int num_voxels = 0;
+      std::vector<unsigned int> bounding_box_min;
+      std::vector<unsigned int> bounding_box_max; // inclusive
+      std::vector<double> centroid;
+  }; // struct ConnectedComponent
+
+  //! labels the connected regions of non-zero voxels (1, 2, ...; background: 0)
+  /*!
+   * - block-parallel two-pass labeling: the image is split into slabs along the first dimension,
+   *   each slab is labeled with union-find, the slabs are merged at their borders, and all voxels
+   *   are relabeled in parallel
+   * - union-find roots are the smallest list id of a region, so labels are assigned in list id
+   *   order of the first voxel of each region
+   * - per-label voxel count, bounding box, and centroid are collected during relabeling
+   */
   class BKDATASET_EXPORT ConnectedComponentAnalysisImageFilter
   {
       //====================================================================================================
@@ -48,10 +71,14 @@ namespace bk
       //====================================================================================================
       using self_type = ConnectedComponentAnalysisImageFilter;
 
+      static constexpr unsigned int NoParent = std::numeric_limits<unsigned int>::max();
+
       //====================================================================================================
       //===== MEMBERS
       //====================================================================================================
+      ImageConnectivity _connectivity;
       std::map<unsigned int/*id*/, unsigned int/*num pixels*/> _labels;
+      std::vector<ConnectedComponent> _components;
 
       //====================================================================================================
       //===== CONSTRUCTORS & DESTRUCTOR
@@ -61,6 +88,7 @@ namespace bk
       ConnectedComponentAnalysisImageFilter();
       ConnectedComponentAnalysisImageFilter(const self_type&);
       ConnectedComponentAnalysisImageFilter(self_type&&) noexcept;
+      explicit ConnectedComponentAnalysisImageFilter(ImageConnectivity connectivity);
       /// @}
 
       /// @{ -------------------------------------------------- DTOR
@@ -70,6 +98,10 @@ namespace bk
       //====================================================================================================
       //===== GETTER
       //====================================================================================================
+      /// @{ -------------------------------------------------- GET CONNECTIVITY
+      [[nodiscard]] ImageConnectivity connectivity() const;
+      /// @}
+
       /// @{ -------------------------------------------------- GET NUM LABELS
       [[nodiscard]] unsigned int num_labels() const;
       /// @}
@@ -82,6 +114,15 @@ namespace bk
       [[nodiscard]] unsigned int num_pixels_with_label(unsigned int labelId) const;
       /// @}
 
+      /// @{ -------------------------------------------------- GET COMPONENTS
+      //! statistics of label l are at index l - 1
+      [[nodiscard]] const std::vector<ConnectedComponent>& components() const;
+      [[nodiscard]] const ConnectedComponent& component(unsigned int labelId) const;
+
+      //! label with the most voxels (smallest label on ties); 0 if there is no component
+      [[nodiscard]] unsigned int largest_label() const;
+      /// @}
+
       //====================================================================================================
       //===== SETTER
       //====================================================================================================
@@ -90,103 +131,368 @@ namespace bk
       [[maybe_unused]] auto operator=(self_type&&) noexcept -> self_type&;
       /// @}
 
+      /// @{ -------------------------------------------------- SET CONNECTIVITY
+      void set_connectivity(ImageConnectivity connectivity);
+      /// @}
+
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
+      /// @{ -------------------------------------------------- HELPER: UNION FIND
+    private:
+      //! root with path halving
+      [[nodiscard]] static unsigned int _find(std::vector<unsigned int>& parent, unsigned int x)
+      {
+          while (parent[x] != x)
+          {
+              parent[x] = parent[parent[x]];
+              x = parent[x];
+          }
+
+          return x;
+      }
+
+      //! root without modification of the tree (concurrent reads)
+      [[nodiscard]] static unsigned int _find_const(const std::vector<unsigned int>& parent, unsigned int x)
+      {
+          while (parent[x] != x)
+          { x = parent[x]; }
+
+          return x;
+      }
+
+      //! the smaller root becomes the parent
+      static void _union(std::vector<unsigned int>& parent, unsigned int a, unsigned int b)
+      {
+          a = _find(parent, a);
+          b = _find(parent, b);
+
+          if (a < b)
+          { parent[b] = a; }
+          else if (b < a)
+          { parent[a] = b; }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: COMPONENT STATISTICS
+      //! partial statistics of one component
+      struct _ComponentAccumulator
+      {
+          unsigned int num_voxels = 0;
+          std::vector<unsigned int> bounding_box_min;
+          std::vector<unsigned int> bounding_box_max;
+          std::vector<double> sum;
+
+          explicit _ComponentAccumulator(unsigned int nDims)
+              : bounding_box_min(nDims, std::numeric_limits<unsigned int>::max()),
+                bounding_box_max(nDims, 0),
+                sum(nDims, 0.0)
+          { /* do nothing */ }
+
+          void add(const std::vector<int>& gid)
+          {
+              ++num_voxels;
+
+              for (unsigned int d = 0; d < sum.size(); ++d)
+              {
+                  const unsigned int x = static_cast<unsigned int>(gid[d]);
+                  bounding_box_min[d] = std::min(bounding_box_min[d], x);
+                  bounding_box_max[d] = std::max(bounding_box_max[d], x);
+                  sum[d] += x;
+              }
+          }
+
+          //! centroid is accumulated as coordinate sum
+          void merge_into(ConnectedComponent& c) const
+          {
+              c.num_voxels += num_voxels;
+
+              for (unsigned int d = 0; d < sum.size(); ++d)
+              {
+                  c.bounding_box_min[d] = std::min(c.bounding_box_min[d], bounding_box_min[d]);
+                  c.bounding_box_max[d] = std::max(c.bounding_box_max[d], bounding_box_max[d]);
+                  c.centroid[d] += sum[d];
+              }
+          }
+      };
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: NEIGHBOR OFFSETS
+      //! grid offsets (nDims per neighbor) of all neighbors with a smaller list id
+      [[nodiscard]] std::vector<int> _backward_neighbor_offsets(unsigned int nDims) const;
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: INCREMENT GRID ID
+      template<typename TSize>
+      static void _increment(std::vector<int>& gid, const TSize& size, unsigned int nDims)
+      {
+          for (int d = static_cast<int>(nDims) - 1; d >= 0; --d)
+          {
+              if (++gid[d] < static_cast<int>(size[d]))
+              { return; }
+
+              gid[d] = 0;
+          }
+      }
+      /// @}
+
+    public:
       /// @{ -------------------------------------------------- APPLY
       template<typename TImage>
       [[nodiscard]] typename TImage::template self_template_type<int> apply(const TImage& img)
       {
-          const unsigned int numDimensions = img.num_dimensions();
+          const unsigned int nDims = img.num_dimensions();
           const unsigned int numValues = img.num_values();
-          const auto size = img.size();
+          const auto& size = img.size();
 
           #ifdef BK_EMIT_PROGRESS
-          bk::Progress& prog = bk_progress.emplace_task(10 + numValues, ___("Connected component analysis"));
+          bk::Progress& prog = bk_progress.emplace_task(5, ___("Connected component analysis"));
           #endif
 
-          std::vector<int> stride(numDimensions, 0);
-          for (unsigned int dimId = 0; dimId < numDimensions; ++dimId)
-          { stride[dimId] = bk::stride_of_dim(size, dimId, img.num_dimensions()); }
-
           typename TImage::template self_template_type<int> labels;
           labels.set_size(size);
-          labels.set_constant(-1);
 
-          #ifdef BK_EMIT_PROGRESS
-          prog.increment(10);
-          #endif
+          _labels.clear();
+          _components.clear();
 
-          unsigned int currentLabel = 0;
+          if (numValues == 0)
+          {
+              #ifdef BK_EMIT_PROGRESS
+              prog.set_finished();
+              #endif
 
-          _labels.clear();
+              return labels;
+          }
+
+          /*
+           * neighbors
+           */
+          const std::vector<int> nbGridOffsets = _backward_neighbor_offsets(nDims);
+          const unsigned int numNeighbors = static_cast<unsigned int>(nbGridOffsets.size()) / nDims;
+
+          std::vector<int> stride(nDims, 1);
+          for (int d = static_cast<int>(nDims) - 2; d >= 0; --d)
+          { stride[d] = stride[d + 1] * static_cast<int>(size[d + 1]); }
 
-          for (unsigned int lid = 0; lid < numValues; ++lid)
+          std::vector<int> nbLidOffsets(numNeighbors, 0);
+          for (unsigned int k = 0; k < numNeighbors; ++k)
           {
-              if (labels[lid] != -1) // already visited and labeled
+              for (unsigned int d = 0; d < nDims; ++d)
+              { nbLidOffsets[k] += nbGridOffsets[k * nDims + d] * stride[d]; }
+          }
+
+          /*
+           * slabs along the first dimension
+           */
+          const unsigned int n0 = size[0];
+          const unsigned int planeSize = numValues / n0;
+          const unsigned int numSlabs = std::min(n0, 64U);
+
+          std::vector<unsigned int> slabBegin(numSlabs + 1);
+          for (unsigned int s = 0; s <= numSlabs; ++s)
+          { slabBegin[s] = static_cast<unsigned int>(static_cast<unsigned long long>(s) * n0 / numSlabs); }
+
+          // visits all voxels of the planes [z0, z1) in list id order; f(lid, gid)
+          const auto for_each_voxel = [&](unsigned int z0, unsigned int z1, auto&& f)
+          {
+              std::vector<int> gid(nDims, 0);
+              gid[0] = static_cast<int>(z0);
+
+              for (unsigned int lid = z0 * planeSize; lid < z1 * planeSize; ++lid, _increment(gid, size, nDims))
+              { f(lid, gid); }
+          };
+
+          const auto neighbor_is_inside = [&](const std::vector<int>& gid, unsigned int k, int minPlane)
+          {
+              if (gid[0] + nbGridOffsets[k * nDims] < minPlane)
+              { return false; }
+
+              for (unsigned int d = 1; d < nDims; ++d)
               {
-                  #ifdef BK_EMIT_PROGRESS
-                  prog.increment(1);
-                  #endif
+                  const int c = gid[d] + nbGridOffsets[k * nDims + d];
 
-                  continue;
+                  if (c < 0 || c >= static_cast<int>(size[d]))
+                  { return false; }
               }
 
-              if (img[lid] == 0) // not in segmentation
+              return true;
+          };
+
+          /*
+           * pass 1: union-find per slab
+           */
+          std::vector<unsigned int> parent(numValues);
+
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (unsigned int s = 0; s < numSlabs; ++s)
+          {
+              const int minPlane = static_cast<int>(slabBegin[s]);
+
+              for_each_voxel(slabBegin[s], slabBegin[s + 1], [&](unsigned int lid, const std::vector<int>& gid)
               {
-                  #ifdef BK_EMIT_PROGRESS
-                  prog.increment(1);
-                  #endif
+                  if (img[lid] == 0)
+                  {
+                      parent[lid] = NoParent;
+                      return;
+                  }
 
-                  labels[lid] = 0;
-                  continue;
-              }
+                  parent[lid] = lid;
+
+                  for (unsigned int k = 0; k < numNeighbors; ++k)
+                  {
+                      if (neighbor_is_inside(gid, k, minPlane))
+                      {
+                          const unsigned int nlid = static_cast<unsigned int>(static_cast<int>(lid) + nbLidOffsets[k]);
+
+                          if (parent[nlid] != NoParent)
+                          { _union(parent, lid, nlid); }
+                      }
+                  }
+              });
+          }
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
+
+          /*
+           * merge slabs: neighbors in the last plane of the previous slab
+           */
+          for (unsigned int s = 1; s < numSlabs; ++s)
+          {
+              const unsigned int z = slabBegin[s];
+
+              for_each_voxel(z, z + 1, [&](unsigned int lid, const std::vector<int>& gid)
+              {
+                  if (parent[lid] == NoParent)
+                  { return; }
+
+                  for (unsigned int k = 0; k < numNeighbors; ++k)
+                  {
+                      if (nbGridOffsets[k * nDims] == -1 && neighbor_is_inside(gid, k, 0))
+                      {
+                          const unsigned int nlid = static_cast<unsigned int>(static_cast<int>(lid) + nbLidOffsets[k]);
+
+                          if (parent[nlid] != NoParent)
+                          { _union(parent, lid, nlid); }
+                      }
+                  }
+              });
+          }
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
+
+          /*
+           * pass 2: consecutive labels for the roots (list id order)
+           */
+          std::vector<unsigned int> numRootsPerSlab(numSlabs + 1, 0);
+
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (unsigned int s = 0; s < numSlabs; ++s)
+          {
+              unsigned int cnt = 0;
+
+              for (unsigned int lid = slabBegin[s] * planeSize; lid < slabBegin[s + 1] * planeSize; ++lid)
+              { cnt += parent[lid] == lid; }
+
+              numRootsPerSlab[s + 1] = cnt;
+          }
+
+          for (unsigned int s = 1; s <= numSlabs; ++s)
+          { numRootsPerSlab[s] += numRootsPerSlab[s - 1]; }
+
+          const unsigned int numLabels = numRootsPerSlab[numSlabs];
+
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (unsigned int s = 0; s < numSlabs; ++s)
+          {
+              int label = static_cast<int>(numRootsPerSlab[s]);
+
+              for (unsigned int lid = slabBegin[s] * planeSize; lid < slabBegin[s + 1] * planeSize; ++lid)
+              { labels[lid] = parent[lid] == lid ? ++label : 0; }
+          }
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
 
-              ++currentLabel; // create new label
-              labels[lid] = currentLabel; // label current pixel
+          /*
+           * pass 3: relabel all voxels and collect statistics
+           */
+          _components.resize(numLabels);
 
-              unsigned int regionSizeCnt = 1;
-              std::queue<unsigned int> q; // queue with list ids
-              q.push(lid);
+          for (unsigned int l = 0; l < numLabels; ++l)
+          {
+              ConnectedComponent& c = _components[l];
+              c.label = l + 1;
+              c.bounding_box_min.assign(nDims, std::numeric_limits<unsigned int>::max());
+              c.bounding_box_max.assign(nDims, 0);
+              c.centroid.assign(nDims, 0.0);
+          }
+
+          // statistics of labels whose roots lie in earlier slabs; merged afterwards
+          std::vector<std::map<int, _ComponentAccumulator>> foreignPerSlab(numSlabs);
+
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (unsigned int s = 0; s < numSlabs; ++s)
+          {
+              // labels of roots in this slab are a contiguous range
+              const int firstLocalLabel = static_cast<int>(numRootsPerSlab[s]) + 1;
+              const int endLocalLabel = static_cast<int>(numRootsPerSlab[s + 1]) + 1;
 
-              while (!q.empty())
+              std::vector<_ComponentAccumulator> local(static_cast<unsigned int>(endLocalLabel - firstLocalLabel), _ComponentAccumulator(nDims));
+              std::map<int, _ComponentAccumulator>& foreign = foreignPerSlab[s];
+              int lastForeignLabel = 0;
+              _ComponentAccumulator* lastForeign = nullptr;
+
+              for_each_voxel(slabBegin[s], slabBegin[s + 1], [&](unsigned int lid, const std::vector<int>& gid)
               {
-                  const unsigned int currentLid = q.front();
+                  const unsigned int p = parent[lid];
+
+                  if (p == NoParent)
+                  { return; }
 
-                  // todo 4 vs 8 neighborhood
+                  int label = labels[lid];
 
-                  for (unsigned int dimId = 0; dimId < numDimensions; ++dimId)
+                  if (p != lid)
                   {
-                      for (int neighborLid: {static_cast<int>(currentLid) - stride[dimId], static_cast<int>(currentLid) + stride[dimId]})
+                      label = labels[_find_const(parent, p)];
+                      labels[lid] = label;
+                  }
+
+                  if (label >= firstLocalLabel)
+                  { local[label - firstLocalLabel].add(gid); }
+                  else
+                  {
+                      if (label != lastForeignLabel)
                       {
-                          if (neighborLid >= 0 && neighborLid < static_cast<int>(numValues))
-                          { // neighbor is inside image bounds
-                              if (labels[neighborLid] == -1)
-                              { // neighbor was not yet visited
-                                  const auto neighborGid = bk::list_to_grid_id(size, neighborLid);
-
-                                  if (img(neighborGid) != 0)
-                                  {
-                                      q.push(neighborLid);
-                                      labels[neighborLid] = currentLabel;
-                                      ++regionSizeCnt;
-                                  }
-                                  else
-                                  { labels[neighborLid] = 0; }
-                              }
-                          }
-                      } // for neighborLid
-                  } // for dimId
-
-                  q.pop();
-              } // while
-
-              _labels.insert(std::make_pair(currentLabel, regionSizeCnt));
+                          lastForeignLabel = label;
+                          lastForeign = &foreign.try_emplace(label, nDims).first->second;
+                      }
 
-              #ifdef BK_EMIT_PROGRESS
-              prog.increment(1);
-              #endif
-          } // for lid
+                      lastForeign->add(gid);
+                  }
+              });
+
+              for (int l = firstLocalLabel; l < endLocalLabel; ++l)
+              { local[l - firstLocalLabel].merge_into(_components[l - 1]); }
+          }
+
+          for (const std::map<int, _ComponentAccumulator>& foreign: foreignPerSlab)
+          {
+              for (const auto&[l, acc]: foreign)
+              { acc.merge_into(_components[l - 1]); }
+          }
+
+          for (ConnectedComponent& c: _components)
+          {
+              for (double& x: c.centroid)
+              { x /= c.num_voxels; }
+
+              _labels.emplace_hint(_labels.end(), c.label, c.num_voxels);
+          }
 
           #ifdef BK_EMIT_PROGRESS
           prog.set_finished();
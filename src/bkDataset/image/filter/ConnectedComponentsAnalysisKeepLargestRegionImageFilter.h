@@ -27,10 +27,6 @@
 #ifndef BK_CONNECTEDCOMPONENTSANALYSISKEEPLARGESTREGIONIMAGEFILTER_H
 #define BK_CONNECTEDCOMPONENTSANALYSISKEEPLARGESTREGIONIMAGEFILTER_H
 
-#include <map>
-#include <queue>
-#include <vector>
-
 #include <bkDataset/image/filter/ConnectedComponentsAnalysisImageFilter.h>
 #include <bkDataset/lib/bkDataset_export.h>
 
@@ -88,19 +84,7 @@ namespace bk
           prog.increment(5);
           #endif
 
-          // determine max size label
-
-          unsigned int maxSizeLabelId = 0;
-          unsigned int maxSize = 0;
-
-          for (const auto[id, num_pixels] : f_cca.labels())
-          {
-              if (num_pixels > maxSize)
-              {
-                  maxSize = num_pixels;
-                  maxSizeLabelId = id;
-              }
-          }
+          const int maxSizeLabelId = static_cast<int>(f_cca.largest_label());
 
           #ifdef BK_EMIT_PROGRESS
           prog.increment(1);
@@ -108,7 +92,7 @@ namespace bk
 
           #pragma omp parallel for
           for (unsigned int i = 0; i < labels.num_values(); ++i)
-          { labels[i] = labels[i] != static_cast<int>(maxSizeLabelId )? 0 : 1; }
+          { labels[i] = labels[i] != maxSizeLabelId ? 0 : 1; }
 
           #ifdef BK_EMIT_PROGRESS
           prog.set_finished();
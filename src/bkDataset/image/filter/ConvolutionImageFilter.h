@@ -28,6 +28,8 @@
 #define BK_CONVOLUTIONIMAGEFILTER_H
 
 #include <algorithm>
+#include <iterator>
+#include <vector>
 
 #ifdef BK_EMIT_PROGRESS
 
@@ -37,6 +39,8 @@
 #endif
 
 #include <bkMath/functions/list_grid_id_conversion.h>
+#include <bkDataset/image/EImageBoundaryMode.h>
+#include <bkDataset/image/ImageNeighborhood.h>
 
 namespace bk
 {
@@ -110,6 +114,30 @@ namespace bk
       //===== FUNCTIONS
       //====================================================================================================
       /// @{ -------------------------------------------------- HELPERS
+      //! single convolution pass; positions outside of the image are clamped to the border
+      template<typename TImage>
+      static void _convolve(const TImage& src, TImage& dst, const std::vector<unsigned int>& kernel_size, const std::vector<double>& weights)
+      {
+          #pragma omp parallel
+          {
+              ImageNeighborhood nb(src.size(), kernel_size, ImageBoundaryMode::Clamp);
+
+              #pragma omp for
+              for (unsigned int lineId = 0; lineId < nb.num_lines(); ++lineId)
+              {
+                  for (nb.set_line(lineId); nb.is_in_line(); nb.next())
+                  {
+                      auto accum = src.template allocate_value<double>();
+
+                      nb.for_each([&](unsigned int k, unsigned int lid)
+                                  { accum += src[lid] * weights[k]; });
+
+                      dst[nb.list_id()] = accum;
+                  } // for nb
+              } // for lineId
+          } // omp parallel
+      }
+
       template<typename TImage, typename TKernel>
       [[nodiscard]] static TImage apply(const TImage& img, const TKernel& kernel, unsigned int numIterations)
       {
@@ -119,17 +147,23 @@ namespace bk
 
           const unsigned int numValues = img.num_values();
 
+          const auto ksize = kernel.size();
+          const std::vector<unsigned int> kernelSize(std::begin(ksize), std::end(ksize));
+          std::vector<double> weights(kernel.num_values());
+
+          for (unsigned int k = 0; k < weights.size(); ++k)
+          { weights[k] = kernel[k]; }
+
           TImage res;
           res.set_size(img.size());
 
           if (numIterations == 1)
           {
-              #pragma omp parallel for
-              for (unsigned int i = 0; i < numValues; ++i)
-              { res[i] = img.apply_convolution_kernel(kernel, bk::list_to_grid_id(img.size(), i)); }
+              _convolve(img, res, kernelSize, weights);
 
               #ifdef BK_EMIT_PROGRESS
               prog.increment(numValues);
+              prog.set_finished();
               #endif
 
               return res;
@@ -145,9 +179,7 @@ namespace bk
                   const TImage* imgRead = lastReadWasImg1 ? &res2 : &res;
                   TImage* imgWrite = lastReadWasImg1 ? &res : &res2;
 
-                  #pragma omp parallel for
-                  for (unsigned int i = 0; i < numValues; ++i)
-                  { (*imgWrite)[i] = imgRead->apply_convolution_kernel(kernel, bk::list_to_grid_id(img.size(), i)); }
+                  _convolve(*imgRead, *imgWrite, kernelSize, weights);
 
                   lastReadWasImg1 = !lastReadWasImg1;
 
@@ -206,14 +238,16 @@ namespace bk
                   TImage* imgWrite = lastReadWasImg1 ? &res : &res2;
 
                   const int stride = static_cast<int>(bk::stride_of_dim(imgsize, dimId, img.num_dimensions()));
+                  const int dimSize = static_cast<int>(imgsize[dimId]);
 
                   #pragma omp parallel for
                   for (int listId = 0; listId < numValues; ++listId)
                   {
+                      // position along dimId; the kernel must not leave the current line
+                      const int x = (listId / stride) % dimSize;
                       int offListId0 = listId - halfKernelSize * stride;
-                      const int offListId1 = listId + halfKernelSize * stride;
 
-                      if (offListId0 < 0 || offListId1 >= numValues)
+                      if (x < halfKernelSize || x + halfKernelSize >= dimSize)
                       {
                           (*imgWrite)[listId] = (*imgRead)[listId];
                           continue;
@@ -40,6 +40,10 @@
 
 namespace bk
 {
+  //! integer city block distance (in voxels) to the voxels with a given value
+  /*!
+   * Voxel spacing is ignored; see EuclideanDistanceMapImageFilter for exact euclidean distances.
+   */
   class BKDATASET_EXPORT DistanceMapImageFilter
   {
       //====================================================================================================
@@ -119,6 +123,8 @@ namespace bk
                       }
                   }
               }
+              else // target dimension is processed in the inner loop
+              { _distance_map(dst, d + 1, dimId, stride, gid, first); }
           }
           else // inner loop (target dimension)
           {
@@ -0,0 +1,45 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_ESTRUCTURINGELEMENTSHAPE_H
+#define BK_ESTRUCTURINGELEMENTSHAPE_H
+
+#include <cstdint>
+
+namespace bk
+{
+  //! shape of a morphological structuring element; determines how morphology is decomposed
+  enum class StructuringElementShape : std::uint8_t
+  {
+      Custom = 0, // arbitrary offset list; gathered per voxel
+      Box = 1, // rectangular; separable running maximum per dimension
+      Cross = 2, // center + axis-aligned arms of a radius; union of 1D passes
+      Diamond = 3, // city block ball (|x|+|y|+... <= r); thresholded city block distance map
+      Ball = 4 // euclidean ball (x^2+y^2+... <= r^2); gathered per voxel
+  };
+} // namespace bk
+
+#endif //BK_ESTRUCTURINGELEMENTSHAPE_H
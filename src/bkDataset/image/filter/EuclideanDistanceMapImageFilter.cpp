@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/filter/EuclideanDistanceMapImageFilter.h>
+
+namespace bk
+{
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  EuclideanDistanceMapImageFilter::EuclideanDistanceMapImageFilter()
+      : _val(1),
+        _value_was_set(false),
+        _signed(false),
+        _squared(false),
+        _spacing()
+  { /* do nothing */ }
+
+  EuclideanDistanceMapImageFilter::EuclideanDistanceMapImageFilter(const self_type&) = default;
+  EuclideanDistanceMapImageFilter::EuclideanDistanceMapImageFilter(self_type&&) noexcept = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  EuclideanDistanceMapImageFilter::~EuclideanDistanceMapImageFilter() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET TARGET VALUE
+  double EuclideanDistanceMapImageFilter::value() const
+  { return _val; }
+
+  bool EuclideanDistanceMapImageFilter::custom_value_was_set() const
+  { return _value_was_set; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET SIGNED DISTANCE
+  bool EuclideanDistanceMapImageFilter::signed_distance_is_enabled() const
+  { return _signed; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET SQUARED DISTANCE
+  bool EuclideanDistanceMapImageFilter::squared_distance_is_enabled() const
+  { return _squared; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET SPACING
+  const std::vector<double>& EuclideanDistanceMapImageFilter::spacing() const
+  { return _spacing; }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto EuclideanDistanceMapImageFilter::operator=(const self_type&) -> self_type& = default;
+  auto EuclideanDistanceMapImageFilter::operator=(self_type&&) noexcept -> self_type& = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- SET VALUE
+  void EuclideanDistanceMapImageFilter::set_value(double val)
+  {
+      _val = val;
+      _value_was_set = true;
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET SIGNED DISTANCE
+  void EuclideanDistanceMapImageFilter::set_signed_distance_enabled(bool b)
+  { _signed = b; }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET SQUARED DISTANCE
+  void EuclideanDistanceMapImageFilter::set_squared_distance_enabled(bool b)
+  { _squared = b; }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET SPACING
+  void EuclideanDistanceMapImageFilter::reset_spacing()
+  { _spacing.clear(); }
+  /// @}
+} // namespace bk
@@ -0,0 +1,403 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_EUCLIDEANDISTANCEMAPIMAGEFILTER_H
+#define BK_EUCLIDEANDISTANCEMAPIMAGEFILTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <bkDataset/lib/bkDataset_export.h>
+
+#ifdef BK_EMIT_PROGRESS
+    #include <bk/Progress>
+    #include <bk/Localization>
+#endif
+
+namespace bk
+{
+  //! exact euclidean distance to the voxels with a given value (feature voxels)
+  /*!
+   * - separable squared distance transform (Felzenszwalb / Huttenlocher): per dimension, the lower
+   *   envelope of the parabolas rooted at the samples of a line is computed in linear time
+   * - voxel spacing is taken into account; by default it is derived from the image transformation
+   *   (world distance between neighboring grid positions), see set_spacing()
+   * - lines of each dimension are processed in parallel
+   * - signed mode: feature voxels get the negative distance to the closest non-feature voxel
+   * - the feature map stores the list id of the closest feature voxel (non-feature voxel for the
+   *   inside of the signed mode)
+   * - without any feature voxel, all distances are infinite and all feature ids are InvalidFeatureId()
+   * - DistanceMapImageFilter computes the (cheaper) integer city block distance
+   */
+  class BKDATASET_EXPORT EuclideanDistanceMapImageFilter
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = EuclideanDistanceMapImageFilter;
+
+    public:
+      [[nodiscard]] static constexpr unsigned int InvalidFeatureId()
+      { return std::numeric_limits<unsigned int>::max(); }
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      double _val;
+      bool _value_was_set;
+      bool _signed;
+      bool _squared;
+      std::vector<double> _spacing;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      EuclideanDistanceMapImageFilter();
+      EuclideanDistanceMapImageFilter(const self_type&);
+      EuclideanDistanceMapImageFilter(self_type&&) noexcept;
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~EuclideanDistanceMapImageFilter();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET TARGET VALUE
+      [[nodiscard]] double value() const;
+      [[nodiscard]] bool custom_value_was_set() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SIGNED DISTANCE
+      [[nodiscard]] bool signed_distance_is_enabled() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SQUARED DISTANCE
+      [[nodiscard]] bool squared_distance_is_enabled() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SPACING
+      //! empty if the spacing is derived from the image transformation
+      [[nodiscard]] const std::vector<double>& spacing() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type&) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&&) noexcept -> self_type&;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET VALUE
+      //! distance to voxels with this value will be determined (default: maximum value of the image)
+      void set_value(double val);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET SIGNED DISTANCE
+      void set_signed_distance_enabled(bool b);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET SQUARED DISTANCE
+      //! skips the final square root
+      void set_squared_distance_enabled(bool b);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET SPACING
+      //! world distance between neighboring grid positions per dimension; missing dimensions are 1
+      template<typename T>
+      void set_spacing(std::initializer_list<T> ilist)
+      { _spacing.assign(ilist.begin(), ilist.end()); }
+
+      template<typename Iter>
+      void set_spacing(Iter first, Iter last)
+      { _spacing.assign(first, last); }
+
+      //! the spacing is derived from the image transformation
+      void reset_spacing();
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- HELPER: SPACING
+    private:
+      template<typename TImage>
+      [[nodiscard]] std::vector<double> _spacing_of(const TImage& img) const
+      {
+          const unsigned int nDims = img.num_dimensions();
+          std::vector<double> spacing(nDims, 1.0);
+
+          if (!_spacing.empty())
+          {
+              std::copy(_spacing.begin(), _spacing.begin() + std::min<std::size_t>(nDims, _spacing.size()), spacing.begin());
+              return spacing;
+          }
+
+          const auto& t = img.geometry().transformation();
+
+          std::vector<double> p(nDims, 0.0);
+          const auto w0 = t.to_world_coordinates(p);
+
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              p[dimId] = 1;
+              const auto w1 = t.to_world_coordinates(p);
+              p[dimId] = 0;
+
+              double d = 0;
+              for (unsigned int i = 0; i < nDims; ++i)
+              { d += (w1[i] - w0[i]) * (w1[i] - w0[i]); }
+
+              spacing[dimId] = std::sqrt(d);
+          }
+
+          return spacing;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: SQUARED DISTANCE TRANSFORM
+      //! in-place separable transform of dist (0 at feature voxels, infinity elsewhere); feat is optional
+      template<typename TSize>
+      static void _transform(std::vector<double>& dist, std::vector<unsigned int>* feat, const TSize& size, unsigned int nDims, const std::vector<double>& spacing)
+      {
+          constexpr double inf = std::numeric_limits<double>::infinity();
+          const unsigned int numValues = static_cast<unsigned int>(dist.size());
+
+          unsigned int stride = numValues;
+
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              const unsigned int n = size[dimId];
+              stride /= n;
+
+              const double sp = spacing[dimId];
+              const double sp2 = sp * sp;
+              const unsigned int numLines = numValues / n;
+
+              #pragma omp parallel
+              {
+                  std::vector<double> f(n);
+                  std::vector<unsigned int> featIn(feat != nullptr ? n : 0);
+                  std::vector<int> v(n); // roots of the parabolas in the lower envelope
+                  std::vector<double> z(n + 1); // boundaries between the parabolas
+
+                  #pragma omp for
+                  for (unsigned int lineId = 0; lineId < numLines; ++lineId)
+                  {
+                      const unsigned int first = (lineId / stride) * stride * n + (lineId % stride);
+
+                      for (unsigned int i = 0; i < n; ++i)
+                      { f[i] = dist[first + i * stride]; }
+
+                      if (feat != nullptr)
+                      {
+                          for (unsigned int i = 0; i < n; ++i)
+                          { featIn[i] = (*feat)[first + i * stride]; }
+                      }
+
+                      /*
+                       * lower envelope (samples with infinite distance have no parabola)
+                       */
+                      int k = -1;
+
+                      for (int q = 0; q < static_cast<int>(n); ++q)
+                      {
+                          if (f[q] == inf)
+                          { continue; }
+
+                          const double fq = f[q] + sp2 * q * q;
+                          double s = 0;
+
+                          while (k >= 0)
+                          {
+                              s = (fq - (f[v[k]] + sp2 * v[k] * v[k])) / (2 * sp2 * (q - v[k]));
+
+                              if (s > z[k])
+                              { break; }
+
+                              --k;
+                          }
+
+                          ++k;
+                          v[k] = q;
+                          z[k] = k == 0 ? -inf : s;
+                          z[k + 1] = inf;
+                      } // for q
+
+                      if (k < 0)
+                      { continue; } // no feature in this line
+
+                      /*
+                       * sample the envelope
+                       */
+                      k = 0;
+
+                      for (unsigned int q = 0; q < n; ++q)
+                      {
+                          while (z[k + 1] < static_cast<double>(q))
+                          { ++k; }
+
+                          const double d = static_cast<double>(q) - v[k];
+                          const unsigned int lid = first + q * stride;
+
+                          dist[lid] = sp2 * d * d + f[v[k]];
+
+                          if (feat != nullptr)
+                          { (*feat)[lid] = featIn[v[k]]; }
+                      } // for q
+                  } // for lineId
+              } // omp parallel
+          } // for dimId
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: APPLY
+      template<typename TImage>
+      [[nodiscard]] std::pair<typename TImage::template self_template_type<float>, typename TImage::template self_template_type<unsigned int>> _apply(const TImage& img, bool computeFeatureMap) const
+      {
+          const unsigned int numValues = img.num_values();
+          const unsigned int nDims = img.num_dimensions();
+          const auto& size = img.size();
+          const std::vector<double> spacing = _spacing_of(img);
+
+          #ifdef BK_EMIT_PROGRESS
+          bk::Progress& prog = bk_progress.emplace_task(_signed ? 4 : 3, ___("Creating euclidean distance map"));
+          #endif
+
+          typename TImage::template self_template_type<float> res;
+          res.set_size(size);
+
+          typename TImage::template self_template_type<unsigned int> featureMap;
+
+          if (numValues == 0)
+          { return {std::move(res), std::move(featureMap)}; }
+
+          const double val = _value_was_set ? _val : static_cast<double>(img.max_value());
+
+          std::vector<char> isFeature(numValues);
+
+          #pragma omp parallel for
+          for (unsigned int i = 0; i < numValues; ++i)
+          { isFeature[i] = img[i] == val; }
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
+
+          constexpr double inf = std::numeric_limits<double>::infinity();
+
+          // distance to the feature voxels
+          std::vector<double> dist(numValues);
+          std::vector<unsigned int> feat(computeFeatureMap ? numValues : 0);
+
+          #pragma omp parallel for
+          for (unsigned int i = 0; i < numValues; ++i)
+          {
+              dist[i] = isFeature[i] ? 0 : inf;
+
+              if (computeFeatureMap)
+              { feat[i] = isFeature[i] ? i : InvalidFeatureId(); }
+          }
+
+          _transform(dist, computeFeatureMap ? &feat : nullptr, size, nDims, spacing);
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
+
+          // inside: distance to the non-feature voxels
+          std::vector<double> distInside;
+          std::vector<unsigned int> featInside;
+
+          if (_signed)
+          {
+              distInside.resize(numValues);
+              featInside.resize(computeFeatureMap ? numValues : 0);
+
+              #pragma omp parallel for
+              for (unsigned int i = 0; i < numValues; ++i)
+              {
+                  distInside[i] = isFeature[i] ? inf : 0;
+
+                  if (computeFeatureMap)
+                  { featInside[i] = isFeature[i] ? InvalidFeatureId() : i; }
+              }
+
+              _transform(distInside, computeFeatureMap ? &featInside : nullptr, size, nDims, spacing);
+
+              #ifdef BK_EMIT_PROGRESS
+              prog.increment(1);
+              #endif
+          }
+
+          if (computeFeatureMap)
+          { featureMap.set_size(size); }
+
+          #pragma omp parallel for
+          for (unsigned int i = 0; i < numValues; ++i)
+          {
+              const bool inside = _signed && isFeature[i];
+              const double d2 = inside ? distInside[i] : dist[i];
+              const double d = _squared ? d2 : std::sqrt(d2);
+
+              res[i] = static_cast<float>(inside ? -d : d);
+
+              if (computeFeatureMap)
+              { featureMap[i] = inside ? featInside[i] : feat[i]; }
+          }
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.set_finished();
+          #endif
+
+          return {std::move(res), std::move(featureMap)};
+      }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] typename TImage::template self_template_type<float> apply(const TImage& img) const
+      { return _apply(img, false).first; }
+
+      //! distance map and feature map (list id of the closest feature voxel)
+      template<typename TImage>
+      [[nodiscard]] std::pair<typename TImage::template self_template_type<float>, typename TImage::template self_template_type<unsigned int>> apply_with_feature_map(const TImage& img) const
+      { return _apply(img, true); }
+      /// @}
+  }; // class EuclideanDistanceMapImageFilter
+} // namespace bk
+
+#endif //BK_EUCLIDEANDISTANCEMAPIMAGEFILTER_H
@@ -140,7 +140,7 @@ namespace bk
           #pragma omp parallel for
           for (unsigned int i = 0; i < newNumValues; ++i)
           {
-              auto gid = bk::list_to_grid_id(sizePow2, i);
+              auto gid = fftimg.grid_id(i);
 
               bool insideOriginalImage = true;
               for (unsigned int dimId = 0; dimId < nDims; ++dimId)
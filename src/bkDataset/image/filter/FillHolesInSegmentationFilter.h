@@ -27,8 +27,7 @@
 #ifndef BK_FILLHOLESINSEGMENTATIONFILTER_H
 #define BK_FILLHOLESINSEGMENTATIONFILTER_H
 
-#include <bkDataset/image/filter/ConnectedComponentsAnalysisKeepLargestRegionImageFilter.h>
-#include <bkDataset/image/filter/InvertIntensityImageFilter.h>
+#include <bkDataset/image/filter/ConnectedComponentsAnalysisImageFilter.h>
 
 #ifdef BK_EMIT_PROGRESS
     #include <bk/Progress>
@@ -66,25 +65,38 @@ namespace bk
       //====================================================================================================
       /// @{ -------------------------------------------------- APPLY
       template<typename TSegmentation>
-      [[nodiscard]] static constexpr TSegmentation apply(const TSegmentation& seg)
+      [[nodiscard]] static TSegmentation apply(const TSegmentation& seg)
       {
           #ifdef BK_EMIT_PROGRESS
           bk::Progress& prog = bk_progress.emplace_task(9, ___("Filling holes in segmentation"));
           #endif
 
-          auto segInverted = InvertIntensityImageFilter::apply(seg);
+          // background regions
+          typename TSegmentation::template self_template_type<unsigned char> background;
+          background.set_size(seg.size());
+
+          #pragma omp parallel for
+          for (unsigned int i = 0; i < seg.num_values(); ++i)
+          { background[i] = seg[i] == 0 ? 1 : 0; }
 
           #ifdef BK_EMIT_PROGRESS
           prog.increment(2);
           #endif
 
-          auto temp = ConnectedComponentAnalysisKeepLargestRegionImageFilter::apply(segInverted);
+          ConnectedComponentAnalysisImageFilter f_cca;
+          const auto labels = f_cca.apply(background);
+          const int largestBackgroundLabel = static_cast<int>(f_cca.largest_label());
 
           #ifdef BK_EMIT_PROGRESS
           prog.increment(5);
           #endif
 
-          TSegmentation res = InvertIntensityImageFilter::apply(temp);
+          // everything except the largest background region is segmentation
+          TSegmentation res = seg;
+
+          #pragma omp parallel for
+          for (unsigned int i = 0; i < res.num_values(); ++i)
+          { res[i] = largestBackgroundLabel != 0 && labels[i] == largestBackgroundLabel ? 0 : 1; }
 
           #ifdef BK_EMIT_PROGRESS
           prog.set_finished();
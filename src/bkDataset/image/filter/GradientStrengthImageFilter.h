@@ -85,16 +85,22 @@ namespace bk
           prog.increment(10);
           #endif
 
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < img.num_values(); ++i)
+          #pragma omp parallel
           {
-              res[i] = img.gradient_strength(bk::list_to_grid_id(img.size(), i));
-
               #ifdef BK_EMIT_PROGRESS
-              #pragma omp critical(filter_gradient_strength)
-              { prog.increment(1); }
+              double progAccum = 0; // thread-local
               #endif
-          }
+
+              #pragma omp for
+              for (unsigned int i = 0; i < img.num_values(); ++i)
+              {
+                  res[i] = img.gradient_strength(bk::list_to_grid_id(img.size(), i));
+
+                  #ifdef BK_EMIT_PROGRESS
+                  prog.increment_batched(progAccum, 1, 4096);
+                  #endif
+              }
+          } // omp parallel
 
           #ifdef BK_EMIT_PROGRESS
           prog.set_finished();
@@ -177,7 +177,7 @@ namespace bk
           #pragma omp parallel for
           for (unsigned int i = 0; i < img.num_values(); ++i)
           {
-              auto gid = bk::list_to_grid_id(size, i);
+              auto gid = img.grid_id(i);
 
               bool insideOriginalImage = true;
               for (unsigned int dimId = 0; dimId < nDims; ++dimId)
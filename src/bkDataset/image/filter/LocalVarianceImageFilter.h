@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_LOCALVARIANCEIMAGEFILTER_H
+#define BK_LOCALVARIANCEIMAGEFILTER_H
+
+#include <cassert>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#ifdef BK_EMIT_PROGRESS
+
+    #include <bk/Progress>
+    #include <bk/Localization>
+
+#endif
+
+#include <bkDataset/image/IntegralImage.h>
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! variance of the values in a box around each voxel (scalar images)
+  /*!
+   * Uses an IntegralImage of the values and squared values, i.e. the cost per voxel
+   * is independent of the kernel size. Boxes are clipped at the image border.
+   */
+  class BKDATASET_EXPORT LocalVarianceImageFilter
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = LocalVarianceImageFilter;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      std::vector<unsigned int> _kernel_size;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      LocalVarianceImageFilter();
+      LocalVarianceImageFilter(const self_type& other);
+      LocalVarianceImageFilter(self_type&& other) noexcept;
+      LocalVarianceImageFilter(unsigned int nDims, unsigned int size);
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~LocalVarianceImageFilter();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET KERNEL SIZE
+      [[nodiscard]] const std::vector<unsigned int>& kernel_size() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET KERNEL SIZE
+      template<typename T>
+      void set_kernel_size(std::initializer_list<T> ilist)
+      { _kernel_size.assign(ilist); }
+
+      template<typename Iter>
+      void set_kernel_size(Iter first, Iter last)
+      { _kernel_size.assign(first, last); }
+
+      void set_kernel_size(unsigned int nDims, unsigned int size);
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] typename TImage::template self_template_type<double> apply(const TImage& img) const
+      {
+          static_assert(std::is_arithmetic_v<typename TImage::value_type>, "local variance requires scalar image values");
+          assert(_kernel_size.size() == img.num_dimensions() && "call set_kernel_size() first");
+
+          #ifdef BK_EMIT_PROGRESS
+          Progress& prog = bk_progress.emplace_task(2, ___("Local variance filtering"));
+          #endif
+
+          typename TImage::template self_template_type<double> res;
+          res.set_size(img.size());
+
+          const IntegralImage ii(img);
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
+
+          ii.for_each_centered_box(_kernel_size, [&](unsigned int lid, double /*mean*/, double variance)
+          { res[lid] = variance; });
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.set_finished();
+          #endif
+
+          return res;
+      }
+      /// @}
+  }; // class LocalVarianceImageFilter
+} // namespace bk
+
+#endif //BK_LOCALVARIANCEIMAGEFILTER_H
@@ -33,18 +33,21 @@
 #ifndef BK_MARCHINGCUBESFILTER_H
 #define BK_MARCHINGCUBESFILTER_H
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include <bkDataset/geometry/ExplicitGeometry.h>
 #include <bkDataset/topology/ExplicitTopology.h>
 #include <bkDataset/mesh/TriangularMesh3D.h>
 #include <bkDataset/lib/bkDataset_export.h>
-#include <bkMath/functions/list_grid_id_conversion.h>
 #include <bkMath/functions/equals_approx.h>
 #include <bk/Image>
 #include <bk/Matrix>
-#include <bk/ThreadPool>
 
 #ifdef BK_EMIT_PROGRESS
 
@@ -100,320 +103,353 @@ namespace bk
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
+      /// @{ -------------------------------------------------- HELPER: PLANE
+    private:
+      //! values and vertex ids of one point plane (constant first coordinate) of the padded grid
+      struct _Plane
+      {
+          std::vector<double> values;
+          std::vector<std::uint8_t> below_iso; // marching cubes classification
+          std::vector<unsigned int> point_ids; // vertex at the grid point (iso value at the point)
+          std::array<std::vector<unsigned int>, 3> edge_ids; // vertex on the edge to the next point in dimension 0/1/2
+      };
+
+      //! vertex of an edge crossing the iso surface; 0: lower point, 1: upper point, 2: interpolated
+      [[nodiscard]] int _edge_vertex_type(double valLower, double valUpper) const
+      {
+          if (equals_approx(_iso, valLower))
+          { return 0; }
+
+          if (equals_approx(_iso, valUpper))
+          { return 1; }
+
+          if (equals_approx(valLower, valUpper))
+          { return 0; }
+
+          return 2;
+      }
+
+      [[nodiscard]] bool _is_crossing(double val0, double val1) const
+      { return (val0 < _iso) != (val1 < _iso); }
+    public:
+      /// @}
+
       /// @{ -------------------------------------------------- APPLY
+      /*!
+       * Slab-parallel in two passes (flying edges style): the first pass counts the vertices and
+       * triangles of each slab, the second pass writes them to their prefix-summed offsets in the
+       * preallocated mesh. Vertices are shared between cells via per-plane edge index arrays.
+       */
       template<typename TImage>
       [[nodiscard]] TriangularMesh3D apply(const TImage& img) const
       {
           assert(img.num_dimensions() == 3 && "marching cubes can only be used on 3D images");
+
           static constexpr int edgeTable[256] = {0x0, 0x109, 0x203, 0x30a, 0x406, 0x50f, 0x605, 0x70c, 0x80c, 0x905, 0xa0f, 0xb06, 0xc0a, 0xd03, 0xe09, 0xf00, 0x190, 0x99, 0x393, 0x29a, 0x596, 0x49f, 0x795, 0x69c, 0x99c, 0x895, 0xb9f, 0xa96, 0xd9a, 0xc93, 0xf99, 0xe90, 0x230, 0x339, 0x33, 0x13a, 0x636, 0x73f, 0x435, 0x53c, 0xa3c, 0xb35, 0x83f, 0x936, 0xe3a, 0xf33, 0xc39, 0xd30, 0x3a0, 0x2a9, 0x1a3, 0xaa, 0x7a6, 0x6af, 0x5a5, 0x4ac, 0xbac, 0xaa5, 0x9af, 0x8a6, 0xfaa, 0xea3, 0xda9, 0xca0, 0x460, 0x569, 0x663, 0x76a, 0x66, 0x16f, 0x265, 0x36c, 0xc6c, 0xd65, 0xe6f, 0xf66, 0x86a, 0x963, 0xa69, 0xb60, 0x5f0, 0x4f9, 0x7f3, 0x6fa, 0x1f6, 0xff, 0x3f5, 0x2fc, 0xdfc, 0xcf5, 0xfff, 0xef6, 0x9fa, 0x8f3, 0xbf9, 0xaf0, 0x650, 0x759, 0x453, 0x55a, 0x256, 0x35f, 0x55, 0x15c, 0xe5c, 0xf55, 0xc5f, 0xd56, 0xa5a, 0xb53, 0x859, 0x950, 0x7c0, 0x6c9, 0x5c3, 0x4ca, 0x3c6, 0x2cf, 0x1c5, 0xcc, 0xfcc, 0xec5, 0xdcf, 0xcc6, 0xbca, 0xac3, 0x9c9, 0x8c0, 0x8c0, 0x9c9, 0xac3, 0xbca, 0xcc6, 0xdcf, 0xec5, 0xfcc, 0xcc, 0x1c5, 0x2cf, 0x3c6, 0x4ca, 0x5c3, 0x6c9, 0x7c0, 0x950, 0x859, 0xb53, 0xa5a, 0xd56, 0xc5f, 0xf55, 0xe5c, 0x15c, 0x55, 0x35f, 0x256, 0x55a, 0x453, 0x759, 0x650, 0xaf0, 0xbf9, 0x8f3, 0x9fa, 0xef6, 0xfff, 0xcf5, 0xdfc, 0x2fc, 0x3f5, 0xff, 0x1f6, 0x6fa, 0x7f3, 0x4f9, 0x5f0, 0xb60, 0xa69, 0x963, 0x86a, 0xf66, 0xe6f, 0xd65, 0xc6c, 0x36c, 0x265, 0x16f, 0x66, 0x76a, 0x663, 0x569, 0x460, 0xca0, 0xda9, 0xea3, 0xfaa, 0x8a6, 0x9af, 0xaa5, 0xbac, 0x4ac, 0x5a5, 0x6af, 0x7a6, 0xaa, 0x1a3, 0x2a9, 0x3a0, 0xd30, 0xc39, 0xf33, 0xe3a, 0x936, 0x83f, 0xb35, 0xa3c, 0x53c, 0x435, 0x73f, 0x636, 0x13a, 0x33, 0x339, 0x230, 0xe90, 0xf99, 0xc93, 0xd9a, 0xa96, 0xb9f, 0x895, 0x99c, 0x69c, 0x795, 0x49f, 0x596, 0x29a, 0x393, 0x99, 0x190, 0xf00, 0xe09, 0xd03, 0xc0a, 0xb06, 0xa0f, 0x905, 0x80c, 0x70c, 0x605, 0x50f, 0x406, 0x30a, 0x203, 0x109, 0x0};
           static constexpr int triTable[256][16] = {{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 8, 3, 9, 8, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 3, 1, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {9, 2, 10, 0, 2, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {2, 8, 3, 2, 10, 8, 10, 9, 8, -1, -1, -1, -1, -1, -1, -1}, {3, 11, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 11, 2, 8, 11, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 9, 0, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 11, 2, 1, 9, 11, 9, 8, 11, -1, -1, -1, -1, -1, -1, -1}, {3, 10, 1, 11, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 10, 1, 0, 8, 10, 8, 11, 10, -1, -1, -1, -1, -1, -1, -1}, {3, 9, 0, 3, 11, 9, 11, 10, 9, -1, -1, -1, -1, -1, -1, -1}, {9, 8, 10, 10, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 3, 0, 7, 3, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 1, 9, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 1, 9, 4, 7, 1, 7, 3, 1, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 10, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {3, 4, 7, 3, 0, 4, 1, 2, 10, -1, -1, -1, -1, -1, -1, -1}, {9, 2, 10, 9, 0, 2, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1}, {2, 10, 9, 2, 9, 7, 2, 7, 3, 7, 9, 4, -1, -1, -1, -1}, {8, 4, 7, 3, 11, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {11, 4, 7, 11, 2, 4, 2, 0, 4, -1, -1, -1, -1, -1, -1, -1}, {9, 0, 1, 8, 4, 7, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1}, {4, 7, 11, 9, 4, 11, 9, 11, 2, 9, 2, 1, -1, -1, -1, -1}, {3, 10, 1, 3, 11, 10, 7, 8, 4, -1, -1, -1, -1, -1, -1, -1}, {1, 11, 10, 1, 4, 11, 1, 0, 4, 7, 11, 4, -1, -1, -1, -1}, {4, 7, 8, 9, 0, 11, 9, 11, 10, 11, 0, 3, -1, -1, -1, -1}, {4, 7, 11, 4, 11, 9, 9, 11, 10, -1, -1, -1, -1, -1, -1, -1}, {9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {9, 5, 4, 0, 8, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 5, 4, 1, 5, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {8, 5, 4, 8, 3, 5, 3, 1, 5, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 10, 9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {3, 0, 8, 1, 2, 10, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1}, {5, 2, 10, 5, 4, 2, 4, 0, 2, -1, -1, -1, -1, -1, -1, -1}, {2, 10, 5, 3, 2, 5, 3, 5, 4, 3, 4, 8, -1, -1, -1, -1}, {9, 5, 4, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 11, 2, 0, 8, 11, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1}, {0, 5, 4, 0, 1, 5, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1}, {2, 1, 5, 2, 5, 8, 2, 8, 11, 4, 8, 5, -1, -1, -1, -1}, {10, 3, 11, 10, 1, 3, 9, 5, 4, -1, -1, -1, -1, -1, -1, -1}, {4, 9, 5, 0, 8, 1, 8, 10, 1, 8, 11, 10, -1, -1, -1, -1}, {5, 4, 0, 5, 0, 11, 5, 11, 10, 11, 0, 3, -1, -1, -1, -1}, {5, 4, 8, 5, 8, 10, 10, 8, 11, -1, -1, -1, -1, -1, -1, -1}, {9, 7, 8, 5, 7, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {9, 3, 0, 9, 5, 3, 5, 7, 3, -1, -1, -1, -1, -1, -1, -1}, {0, 7, 8, 0, 1, 7, 1, 5, 7, -1, -1, -1, -1, -1, -1, -1}, {1, 5, 3, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {9, 7, 8, 9, 5, 7, 10, 1, 2, -1, -1, -1, -1, -1, -1, -1}, {10, 1, 2, 9, 5, 0, 5, 3, 0, 5, 7, 3, -1, -1, -1, -1}, {8, 0, 2, 8, 2, 5, 8, 5, 7, 10, 5, 2, -1, -1, -1, -1}, {2, 10, 5, 2, 5, 3, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1}, {7, 9, 5, 7, 8, 9, 3, 11, 2, -1, -1, -1, -1, -1, -1, -1}, {9, 5, 7, 9, 7, 2, 9, 2, 0, 2, 7, 11, -1, -1, -1, -1}, {2, 3, 11, 0, 1, 8, 1, 7, 8, 1, 5, 7, -1, -1, -1, -1}, {11, 2, 1, 11, 1, 7, 7, 1, 5, -1, -1, -1, -1, -1, -1, -1}, {9, 5, 8, 8, 5, 7, 10, 1, 3, 10, 3, 11, -1, -1, -1, -1}, {5, 7, 0, 5, 0, 9, 7, 11, 0, 1, 0, 10, 11, 10, 0, -1}, {11, 10, 0, 11, 0, 3, 10, 5, 0, 8, 0, 7, 5, 7, 0, -1}, {11, 10, 5, 7, 11, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 3, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {9, 0, 1, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 8, 3, 1, 9, 8, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1}, {1, 6, 5, 2, 6, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 6, 5, 1, 2, 6, 3, 0, 8, -1, -1, -1, -1, -1, -1, -1}, {9, 6, 5, 9, 0, 6, 0, 2, 6, -1, -1, -1, -1, -1, -1, -1}, {5, 9, 8, 5, 8, 2, 5, 2, 6, 3, 2, 8, -1, -1, -1, -1}, {2, 3, 11, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {11, 0, 8, 11, 2, 0, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1}, {0, 1, 9, 2, 3, 11, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1}, {5, 10, 6, 1, 9, 2, 9, 11, 2, 9, 8, 11, -1, -1, -1, -1}, {6, 3, 11, 6, 5, 3, 5, 1, 3, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 11, 0, 11, 5, 0, 5, 1, 5, 11, 6, -1, -1, -1, -1}, {3, 11, 6, 0, 3, 6, 0, 6, 5, 0, 5, 9, -1, -1, -1, -1}, {6, 5, 9, 6, 9, 11, 11, 9, 8, -1, -1, -1, -1, -1, -1, -1}, {5, 10, 6, 4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 3, 0, 4, 7, 3, 6, 5, 10, -1, -1, -1, -1, -1, -1, -1}, {1, 9, 0, 5, 10, 6, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1}, {10, 6, 5, 1, 9, 7, 1, 7, 3, 7, 9, 4, -1, -1, -1, -1}, {6, 1, 2, 6, 5, 1, 4, 7, 8, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 5, 5, 2, 6, 3, 0, 4, 3, 4, 7, -1, -1, -1, -1}, {8, 4, 7, 9, 0, 5, 0, 6, 5, 0, 2, 6, -1, -1, -1, -1}, {7, 3, 9, 7, 9, 4, 3, 2, 9, 5, 9, 6, 2, 6, 9, -1}, {3, 11, 2, 7, 8, 4, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1}, {5, 10, 6, 4, 7, 2, 4, 2, 0, 2, 7, 11, -1, -1, -1, -1}, {0, 1, 9, 4, 7, 8, 2, 3, 11, 5, 10, 6, -1, -1, -1, -1}, {9, 2, 1, 9, 11, 2, 9, 4, 11, 7, 11, 4, 5, 10, 6, -1}, {8, 4, 7, 3, 11, 5, 3, 5, 1, 5, 11, 6, -1, -1, -1, -1}, {5, 1, 11, 5, 11, 6, 1, 0, 11, 7, 11, 4, 0, 4, 11, -1}, {0, 5, 9, 0, 6, 5, 0, 3, 6, 11, 6, 3, 8, 4, 7, -1}, {6, 5, 9, 6, 9, 11, 4, 7, 9, 7, 11, 9, -1, -1, -1, -1}, {10, 4, 9, 6, 4, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 10, 6, 4, 9, 10, 0, 8, 3, -1, -1, -1, -1, -1, -1, -1}, {10, 0, 1, 10, 6, 0, 6, 4, 0, -1, -1, -1, -1, -1, -1, -1}, {8, 3, 1, 8, 1, 6, 8, 6, 4, 6, 1, 10, -1, -1, -1, -1}, {1, 4, 9, 1, 2, 4, 2, 6, 4, -1, -1, -1, -1, -1, -1, -1}, {3, 0, 8, 1, 2, 9, 2, 4, 9, 2, 6, 4, -1, -1, -1, -1}, {0, 2, 4, 4, 2, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {8, 3, 2, 8, 2, 4, 4, 2, 6, -1, -1, -1, -1, -1, -1, -1}, {10, 4, 9, 10, 6, 4, 11, 2, 3, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 2, 2, 8, 11, 4, 9, 10, 4, 10, 6, -1, -1, -1, -1}, {3, 11, 2, 0, 1, 6, 0, 6, 4, 6, 1, 10, -1, -1, -1, -1}, {6, 4, 1, 6, 1, 10, 4, 8, 1, 2, 1, 11, 8, 11, 1, -1}, {9, 6, 4, 9, 3, 6, 9, 1, 3, 11, 6, 3, -1, -1, -1, -1}, {8, 11, 1, 8, 1, 0, 11, 6, 1, 9, 1, 4, 6, 4, 1, -1}, {3, 11, 6, 3, 6, 0, 0, 6, 4, -1, -1, -1, -1, -1, -1, -1}, {6, 4, 8, 11, 6, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {7, 10, 6, 7, 8, 10, 8, 9, 10, -1, -1, -1, -1, -1, -1, -1}, {0, 7, 3, 0, 10, 7, 0, 9, 10, 6, 7, 10, -1, -1, -1, -1}, {10, 6, 7, 1, 10, 7, 1, 7, 8, 1, 8, 0, -1, -1, -1, -1}, {10, 6, 7, 10, 7, 1, 1, 7, 3, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 6, 1, 6, 8, 1, 8, 9, 8, 6, 7, -1, -1, -1, -1}, {2, 6, 9, 2, 9, 1, 6, 7, 9, 0, 9, 3, 7, 3, 9, -1}, {7, 8, 0, 7, 0, 6, 6, 0, 2, -1, -1, -1, -1, -1, -1, -1}, {7, 3, 2, 6, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {2, 3, 11, 10, 6, 8, 10, 8, 9, 8, 6, 7, -1, -1, -1, -1}, {2, 0, 7, 2, 7, 11, 0, 9, 7, 6, 7, 10, 9, 10, 7, -1}, {1, 8, 0, 1, 7, 8, 1, 10, 7, 6, 7, 10, 2, 3, 11, -1}, {11, 2, 1, 11, 1, 7, 10, 6, 1, 6, 7, 1, -1, -1, -1, -1}, {8, 9, 6, 8, 6, 7, 9, 1, 6, 11, 6, 3, 1, 3, 6, -1}, {0, 9, 1, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {7, 8, 0, 7, 0, 6, 3, 11, 0, 11, 6, 0, -1, -1, -1, -1}, {7, 11, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {7, 6, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {3, 0, 8, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 1, 9, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {8, 1, 9, 8, 3, 1, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1}, {10, 1, 2, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 10, 3, 0, 8, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1}, {2, 9, 0, 2, 10, 9, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1}, {6, 11, 7, 2, 10, 3, 10, 8, 3, 10, 9, 8, -1, -1, -1, -1}, {7, 2, 3, 6, 2, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {7, 0, 8, 7, 6, 0, 6, 2, 0, -1, -1, -1, -1, -1, -1, -1}, {2, 7, 6, 2, 3, 7, 0, 1, 9, -1, -1, -1, -1, -1, -1, -1}, {1, 6, 2, 1, 8, 6, 1, 9, 8, 8, 7, 6, -1, -1, -1, -1}, {10, 7, 6, 10, 1, 7, 1, 3, 7, -1, -1, -1, -1, -1, -1, -1}, {10, 7, 6, 1, 7, 10, 1, 8, 7, 1, 0, 8, -1, -1, -1, -1}, {0, 3, 7, 0, 7, 10, 0, 10, 9, 6, 10, 7, -1, -1, -1, -1}, {7, 6, 10, 7, 10, 8, 8, 10, 9, -1, -1, -1, -1, -1, -1, -1}, {6, 8, 4, 11, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {3, 6, 11, 3, 0, 6, 0, 4, 6, -1, -1, -1, -1, -1, -1, -1}, {8, 6, 11, 8, 4, 6, 9, 0, 1, -1, -1, -1, -1, -1, -1, -1}, {9, 4, 6, 9, 6, 3, 9, 3, 1, 11, 3, 6, -1, -1, -1, -1}, {6, 8, 4, 6, 11, 8, 2, 10, 1, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 10, 3, 0, 11, 0, 6, 11, 0, 4, 6, -1, -1, -1, -1}, {4, 11, 8, 4, 6, 11, 0, 2, 9, 2, 10, 9, -1, -1, -1, -1}, {10, 9, 3, 10, 3, 2, 9, 4, 3, 11, 3, 6, 4, 6, 3, -1}, {8, 2, 3, 8, 4, 2, 4, 6, 2, -1, -1, -1, -1, -1, -1, -1}, {0, 4, 2, 4, 6, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 9, 0, 2, 3, 4, 2, 4, 6, 4, 3, 8, -1, -1, -1, -1}, {1, 9, 4, 1, 4, 2, 2, 4, 6, -1, -1, -1, -1, -1, -1, -1}, {8, 1, 3, 8, 6, 1, 8, 4, 6, 6, 10, 1, -1, -1, -1, -1}, {10, 1, 0, 10, 0, 6, 6, 0, 4, -1, -1, -1, -1, -1, -1, -1}, {4, 6, 3, 4, 3, 8, 6, 10, 3, 0, 3, 9, 10, 9, 3, -1}, {10, 9, 4, 6, 10, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 9, 5, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 3, 4, 9, 5, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1}, {5, 0, 1, 5, 4, 0, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1}, {11, 7, 6, 8, 3, 4, 3, 5, 4, 3, 1, 5, -1, -1, -1, -1}, {9, 5, 4, 10, 1, 2, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1}, {6, 11, 7, 1, 2, 10, 0, 8, 3, 4, 9, 5, -1, -1, -1, -1}, {7, 6, 11, 5, 4, 10, 4, 2, 10, 4, 0, 2, -1, -1, -1, -1}, {3, 4, 8, 3, 5, 4, 3, 2, 5, 10, 5, 2, 11, 7, 6, -1}, {7, 2, 3, 7, 6, 2, 5, 4, 9, -1, -1, -1, -1, -1, -1, -1}, {9, 5, 4, 0, 8, 6, 0, 6, 2, 6, 8, 7, -1, -1, -1, -1}, {3, 6, 2, 3, 7, 6, 1, 5, 0, 5, 4, 0, -1, -1, -1, -1}, {6, 2, 8, 6, 8, 7, 2, 1, 8, 4, 8, 5, 1, 5, 8, -1}, {9, 5, 4, 10, 1, 6, 1, 7, 6, 1, 3, 7, -1, -1, -1, -1}, {1, 6, 10, 1, 7, 6, 1, 0, 7, 8, 7, 0, 9, 5, 4, -1}, {4, 0, 10, 4, 10, 5, 0, 3, 10, 6, 10, 7, 3, 7, 10, -1}, {7, 6, 10, 7, 10, 8, 5, 4, 10, 4, 8, 10, -1, -1, -1, -1}, {6, 9, 5, 6, 11, 9, 11, 8, 9, -1, -1, -1, -1, -1, -1, -1}, {3, 6, 11, 0, 6, 3, 0, 5, 6, 0, 9, 5, -1, -1, -1, -1}, {0, 11, 8, 0, 5, 11, 0, 1, 5, 5, 6, 11, -1, -1, -1, -1}, {6, 11, 3, 6, 3, 5, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 10, 9, 5, 11, 9, 11, 8, 11, 5, 6, -1, -1, -1, -1}, {0, 11, 3, 0, 6, 11, 0, 9, 6, 5, 6, 9, 1, 2, 10, -1}, {11, 8, 5, 11, 5, 6, 8, 0, 5, 10, 5, 2, 0, 2, 5, -1}, {6, 11, 3, 6, 3, 5, 2, 10, 3, 10, 5, 3, -1, -1, -1, -1}, {5, 8, 9, 5, 2, 8, 5, 6, 2, 3, 8, 2, -1, -1, -1, -1}, {9, 5, 6, 9, 6, 0, 0, 6, 2, -1, -1, -1, -1, -1, -1, -1}, {1, 5, 8, 1, 8, 0, 5, 6, 8, 3, 8, 2, 6, 2, 8, -1}, {1, 5, 6, 2, 1, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 3, 6, 1, 6, 10, 3, 8, 6, 5, 6, 9, 8, 9, 6, -1}, {10, 1, 0, 10, 0, 6, 9, 5, 0, 5, 6, 0, -1, -1, -1, -1}, {0, 3, 8, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {11, 5, 10, 7, 5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {11, 5, 10, 11, 7, 5, 8, 3, 0, -1, -1, -1, -1, -1, -1, -1}, {5, 11, 7, 5, 10, 11, 1, 9, 0, -1, -1, -1, -1, -1, -1, -1}, {10, 7, 5, 10, 11, 7, 9, 8, 1, 8, 3, 1, -1, -1, -1, -1}, {11, 1, 2, 11, 7, 1, 7, 5, 1, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 3, 1, 2, 7, 1, 7, 5, 7, 2, 11, -1, -1, -1, -1}, {9, 7, 5, 9, 2, 7, 9, 0, 2, 2, 11, 7, -1, -1, -1, -1}, {7, 5, 2, 7, 2, 11, 5, 9, 2, 3, 2, 8, 9, 8, 2, -1}, {2, 5, 10, 2, 3, 5, 3, 7, 5, -1, -1, -1, -1, -1, -1, -1}, {8, 2, 0, 8, 5, 2, 8, 7, 5, 10, 2, 5, -1, -1, -1, -1}, {9, 0, 1, 5, 10, 3, 5, 3, 7, 3, 10, 2, -1, -1, -1, -1}, {9, 8, 2, 9, 2, 1, 8, 7, 2, 10, 2, 5, 7, 5, 2, -1}, {1, 3, 5, 3, 7, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 7, 0, 7, 1, 1, 7, 5, -1, -1, -1, -1, -1, -1, -1}, {9, 0, 3, 9, 3, 5, 5, 3, 7, -1, -1, -1, -1, -1, -1, -1}, {9, 8, 7, 5, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {5, 8, 4, 5, 10, 8, 10, 11, 8, -1, -1, -1, -1, -1, -1, -1}, {5, 0, 4, 5, 11, 0, 5, 10, 11, 11, 3, 0, -1, -1, -1, -1}, {0, 1, 9, 8, 4, 10, 8, 10, 11, 10, 4, 5, -1, -1, -1, -1}, {10, 11, 4, 10, 4, 5, 11, 3, 4, 9, 4, 1, 3, 1, 4, -1}, {2, 5, 1, 2, 8, 5, 2, 11, 8, 4, 5, 8, -1, -1, -1, -1}, {0, 4, 11, 0, 11, 3, 4, 5, 11, 2, 11, 1, 5, 1, 11, -1}, {0, 2, 5, 0, 5, 9, 2, 11, 5, 4, 5, 8, 11, 8, 5, -1}, {9, 4, 5, 2, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {2, 5, 10, 3, 5, 2, 3, 4, 5, 3, 8, 4, -1, -1, -1, -1}, {5, 10, 2, 5, 2, 4, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1}, {3, 10, 2, 3, 5, 10, 3, 8, 5, 4, 5, 8, 0, 1, 9, -1}, {5, 10, 2, 5, 2, 4, 1, 9, 2, 9, 4, 2, -1, -1, -1, -1}, {8, 4, 5, 8, 5, 3, 3, 5, 1, -1, -1, -1, -1, -1, -1, -1}, {0, 4, 5, 1, 0, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {8, 4, 5, 8, 5, 3, 9, 0, 5, 0, 3, 5, -1, -1, -1, -1}, {9, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 11, 7, 4, 9, 11, 9, 10, 11, -1, -1, -1, -1, -1, -1, -1}, {0, 8, 3, 4, 9, 7, 9, 11, 7, 9, 10, 11, -1, -1, -1, -1}, {1, 10, 11, 1, 11, 4, 1, 4, 0, 7, 4, 11, -1, -1, -1, -1}, {3, 1, 4, 3, 4, 8, 1, 10, 4, 7, 4, 11, 10, 11, 4, -1}, {4, 11, 7, 9, 11, 4, 9, 2, 11, 9, 1, 2, -1, -1, -1, -1}, {9, 7, 4, 9, 11, 7, 9, 1, 11, 2, 11, 1, 0, 8, 3, -1}, {11, 7, 4, 11, 4, 2, 2, 4, 0, -1, -1, -1, -1, -1, -1, -1}, {11, 7, 4, 11, 4, 2, 8, 3, 4, 3, 2, 4, -1, -1, -1, -1}, {2, 9, 10, 2, 7, 9, 2, 3, 7, 7, 4, 9, -1, -1, -1, -1}, {9, 10, 7, 9, 7, 4, 10, 2, 7, 8, 7, 0, 2, 0, 7, -1}, {3, 7, 10, 3, 10, 2, 7, 4, 10, 1, 10, 0, 4, 0, 10, -1}, {1, 10, 2, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 9, 1, 4, 1, 7, 7, 1, 3, -1, -1, -1, -1, -1, -1, -1}, {4, 9, 1, 4, 1, 7, 0, 8, 1, 8, 7, 1, -1, -1, -1, -1}, {4, 0, 3, 7, 4, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {4, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {9, 10, 8, 10, 11, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {3, 0, 9, 3, 9, 11, 11, 9, 10, -1, -1, -1, -1, -1, -1, -1}, {0, 1, 10, 0, 10, 8, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1}, {3, 1, 10, 11, 3, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 2, 11, 1, 11, 9, 9, 11, 8, -1, -1, -1, -1, -1, -1, -1}, {3, 0, 9, 3, 9, 11, 1, 2, 9, 2, 11, 9, -1, -1, -1, -1}, {0, 2, 11, 8, 0, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {3, 2, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {2, 3, 8, 2, 8, 10, 10, 8, 9, -1, -1, -1, -1, -1, -1, -1}, {9, 10, 2, 0, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {2, 3, 8, 2, 8, 10, 0, 1, 8, 1, 10, 8, -1, -1, -1, -1}, {1, 10, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {1, 3, 8, 9, 1, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 9, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {0, 3, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}};
 
-          #ifdef BK_EMIT_PROGRESS
-          const unsigned int N = img.geometry().size(2) + 2;
-          const unsigned int N2 = (img.geometry().size(0) + 2) * (img.geometry().size(1) + 2);
-          bk::Progress& prog = bk_progress.emplace_task(N * (7 + N2), ___("Extracing surface via Marching Cubes"));
-          #endif
-
           /*
-           * create
+           * the image is padded by one voxel with its minimum value to obtain closed surfaces
            */
-          bk::CartesianImage<double, 3> tempimg;
-          tempimg.set_size(img.geometry().size(0) + 2, img.geometry().size(1) + 2, img.geometry().size(2) + 2);
-          const auto minval = img.min_value();
-          const auto s = tempimg.geometry().size();
+          const unsigned int n1 = img.geometry().size(1);
+          const unsigned int n2 = img.geometry().size(2);
+          const unsigned int s0 = img.geometry().size(0) + 2;
+          const unsigned int s1 = n1 + 2;
+          const unsigned int s2 = n2 + 2;
+          const unsigned int planeSize = s1 * s2;
+          const double minval = img.min_value();
+
+          // slabs of cell layers along the first dimension; slab s owns the point planes [slabBegin[s], slabBegin[s+1]) (the last one also the last plane)
+          const unsigned int numLayers = s0 - 1;
+          const unsigned int numSlabs = std::min(numLayers, 64U);
+
+          std::vector<unsigned int> slabBegin(numSlabs + 1);
+          for (unsigned int s = 0; s <= numSlabs; ++s)
+          { slabBegin[s] = s * numLayers / numSlabs; }
 
           #ifdef BK_EMIT_PROGRESS
-          prog.increment(N);
+          bk::Progress& prog = bk_progress.emplace_task(2 * numSlabs + 2, ___("Extracing surface via Marching Cubes"));
           #endif
 
-          /*
-           * copy inner values
-           */
-          auto fut_set_inner = bk_threadpool.enqueue([&]()
-                                                     {
-                                                         for (unsigned int z = 1; z < s[2] - 1; ++z)
-                                                         {
-                                                             for (unsigned int y = 1; y < s[1] - 1; ++y)
-                                                             {
-                                                                 for (unsigned int x = 1; x < s[0] - 1; ++x)
-                                                                 { tempimg(x, y, z) = img(x - 1, y - 1, z - 1); }
-                                                             }
-                                                         }
-
-                                                         #ifdef BK_EMIT_PROGRESS
-                                                         prog.increment(N);
-                                                         #endif
-                                                     });
-
-          /*
-           * set boundaries to minimum value
-           */
-          auto fut_set_z_boundary = bk_threadpool.enqueue([&]()
-                                                          {
-                                                              for (unsigned int z = 0; z < s[2]; z += s[2] - 1)
-                                                              {
-                                                                  for (unsigned int y = 0; y < s[1]; ++y)
-                                                                  {
-                                                                      for (unsigned int x = 0; x < s[0]; ++x)
-                                                                      { tempimg(x, y, z) = minval; }
-                                                                  }
-                                                              }
-
-                                                              #ifdef BK_EMIT_PROGRESS
-                                                              prog.increment(N);
-                                                              #endif
-                                                          });
-
-          auto fut_set_y_boundary = bk_threadpool.enqueue([&]()
-                                                          {
-                                                              for (unsigned int z = 0; z < s[2]; ++z)
-                                                              {
-                                                                  for (unsigned int y = 0; y < s[1]; y += s[1] - 1)
-                                                                  {
-                                                                      for (unsigned int x = 0; x < s[0]; ++x)
-                                                                      { tempimg(x, y, z) = minval; }
-                                                                  }
-                                                              }
-
-                                                              #ifdef BK_EMIT_PROGRESS
-                                                              prog.increment(N);
-                                                              #endif
-                                                          });
-
-          auto fut_set_x_boundary = bk_threadpool.enqueue([&]()
-                                                          {
-                                                              for (unsigned int z = 0; z < s[2]; ++z)
-                                                              {
-                                                                  for (unsigned int y = 0; y < s[1]; ++y)
-                                                                  {
-                                                                      for (unsigned int x = 0; x < s[0]; x += s[0] - 1)
-                                                                      { tempimg(x, y, z) = minval; }
-                                                                  }
-                                                              }
-
-                                                              #ifdef BK_EMIT_PROGRESS
-                                                              prog.increment(N);
-                                                              #endif
-                                                          });
-
-          fut_set_inner.get();
-          fut_set_z_boundary.get();
-          fut_set_y_boundary.get();
-          fut_set_x_boundary.get();
           TriangularMesh3D mesh;
 
-          using key_type = std::pair<unsigned int, unsigned int>; // edge between point id <-> point id
-          struct key_comp
+          // cell edges: lower corner, upper corner (0-3: plane x, 4-7: plane x+1), edge dimension
+          // corner k of a cell at (x,y,z): k & 4 -> x+1, k & 2 -> y+1, k & 1 -> z+1
+          static constexpr unsigned int cellEdges[12][3] = {{0, 4, 0}, {4, 6, 1}, {2, 6, 0}, {0, 2, 1}, {1, 5, 0}, {5, 7, 1}, {3, 7, 0}, {1, 3, 1}, {0, 1, 2}, {4, 5, 2}, {6, 7, 2}, {2, 3, 2}};
+          // marching cubes corner order -> corner id (see above)
+          static constexpr unsigned int cellCorners[8] = {0, 4, 6, 2, 1, 5, 7, 3};
+
+          const auto load_values = [&](int x, _Plane& plane)
           {
-              bool operator()(const key_type& a, const key_type& b) const
+              plane.values.assign(planeSize, minval);
+
+              if (x > 0 && x < static_cast<int>(s0) - 1)
               {
-                  unsigned int amin = std::min(a.first, a.second);
-                  unsigned int amax = std::max(a.first, a.second);
-                  unsigned int bmin = std::min(b.first, b.second);
-                  unsigned int bmax = std::max(b.first, b.second);
-                  return amin < bmin ? true : amin > bmin ? false : amax < bmax;
+                  for (unsigned int y = 1; y < s1 - 1; ++y)
+                  {
+                      unsigned int lid = (static_cast<unsigned int>(x - 1) * n1 + (y - 1)) * n2;
+
+                      for (unsigned int z = 1; z < s2 - 1; ++z, ++lid)
+                      { plane.values[y * s2 + z] = img[lid]; }
+                  }
               }
-          };
 
-          using edge_map_type = std::map<key_type, unsigned int, key_comp>;
-          edge_map_type edge_with_intersection;
-          std::map<unsigned int, unsigned int> points_as_intersection;
+              plane.below_iso.resize(planeSize);
 
-          /*
-             Linearly interpolate the position where an isosurface cuts
-             an edge between two vertices, each with their own scalar value
-          */
-          auto VertexInterp = [&](const auto& p0, const auto& p1, double valp0, double valp1, int& intersection_is_datapoint) -> Vec3d
-          {
-              if (equals_approx(_iso, valp0))
-              {
-                  intersection_is_datapoint = 0;
-                  return p0;
-              }
-              if (equals_approx(_iso, valp1))
-              {
-                  intersection_is_datapoint = 1;
-                  return p1;
-              }
-              if (equals_approx(valp0, valp1))
-              {
-                  intersection_is_datapoint = 0;
-                  return p0;
-              }
-              intersection_is_datapoint = -1;
-              const double mu = (_iso - valp0) / (valp1 - valp0);
-              return Vec3d(p0[0] + mu * (p1[0] - p0[0]), p0[1] + mu * (p1[1] - p0[1]), p0[2] + mu * (p1[2] - p0[2]));
+              for (unsigned int i = 0; i < planeSize; ++i)
+              { plane.below_iso[i] = plane.values[i] < _iso; }
           };
 
-          int cnt = 0;
+          const auto to_world = [&](double x, double y, double z)
+          {
+              const auto w = img.geometry().transformation().to_world_coordinates(Vec3d(x - 1, y - 1, z - 1));
+              return Vec3d(w[0], w[1], w[2]);
+          };
 
-          auto calc_and_add_intersection = [&](unsigned int pid0, unsigned int pid1)
+          // assigns consecutive vertex ids to the points and edges of plane x; positions are written if mesh != nullptr
+          const auto process_plane_vertices = [&](unsigned int x, const _Plane* prev, _Plane& cur, const _Plane* next, unsigned int vid, TriangularMesh3D* m)
           {
-              const key_type key(pid0, pid1);
-              auto it = edge_with_intersection.find(key);
-              if (it == edge_with_intersection.end())
+              cur.point_ids.resize(planeSize);
+              for (std::vector<unsigned int>& ids: cur.edge_ids)
+              { ids.resize(planeSize); }
+
+              const std::vector<double>& v = cur.values;
+
+              for (unsigned int y = 0; y < s1; ++y)
               {
-                  int intersection_is_datapoint = -1;
-
-                  //Vec3d intersection = VertexInterp(//
-                  //    tempimg.geometry().point_in_world_coordinates(pid0), //
-                  //    tempimg.geometry().point_in_world_coordinates(pid1), //
-                  //    tempimg[pid0], //
-                  //    tempimg[pid1], //
-                  //    intersection_is_datapoint);
-
-                  Vec3d intersection = VertexInterp(//
-                      img.geometry().transformation().to_world_coordinates(tempimg.geometry().point(pid0)), //
-                      img.geometry().transformation().to_world_coordinates(tempimg.geometry().point(pid1)), //
-                      tempimg[pid0], //
-                      tempimg[pid1], //
-                      intersection_is_datapoint);
-
-                  switch (intersection_is_datapoint)
+                  for (unsigned int z = 0; z < s2; ++z)
                   {
-                      case 0:
+                      const unsigned int i = y * s2 + z;
+                      const std::uint8_t below = cur.below_iso[i];
+
+                      // early out if no incident edge crosses the iso surface
+                      if ((prev == nullptr || prev->below_iso[i] == below)
+                          && (next == nullptr || next->below_iso[i] == below)
+                          && (y == 0 || cur.below_iso[i - s2] == below)
+                          && (y + 1 == s1 || cur.below_iso[i + s2] == below)
+                          && (z == 0 || cur.below_iso[i - 1] == below)
+                          && (z + 1 == s2 || cur.below_iso[i + 1] == below))
+                      { continue; }
+
+                      const double val = v[i];
+
+                      // edges from lower neighbors (upper point = this) and to upper neighbors (lower point = this)
+                      const bool isPointVertex = (prev != nullptr && _is_crossing(prev->values[i], val) && _edge_vertex_type(prev->values[i], val) == 1)
+                                                 || (y != 0 && _is_crossing(v[i - s2], val) && _edge_vertex_type(v[i - s2], val) == 1)
+                                                 || (z != 0 && _is_crossing(v[i - 1], val) && _edge_vertex_type(v[i - 1], val) == 1)
+                                                 || (next != nullptr && _is_crossing(val, next->values[i]) && _edge_vertex_type(val, next->values[i]) == 0)
+                                                 || (y + 1 != s1 && _is_crossing(val, v[i + s2]) && _edge_vertex_type(val, v[i + s2]) == 0)
+                                                 || (z + 1 != s2 && _is_crossing(val, v[i + 1]) && _edge_vertex_type(val, v[i + 1]) == 0);
+
+                      if (isPointVertex)
                       {
-                          const auto it2 = points_as_intersection.find(pid0);
-                          if (it2 == points_as_intersection.end())
-                          {
-                              mesh.geometry().emplace_back(std::move(intersection));
-                              const int id = cnt;
-                              //points_as_intersection.insert(std::pair<unsigned int, unsigned int>(pid0, cnt++));
-                              points_as_intersection.emplace(pid0, cnt++);
-                              return id;
-                          }
-                          else
-                          { return static_cast<int>(it2->second); }
+                          if (m != nullptr)
+                          { m->geometry().point(vid) = to_world(x, y, z); }
+
+                          cur.point_ids[i] = vid++;
                       }
-                      case 1:
+
+                      const double upper[3] = {next != nullptr ? next->values[i] : val, y + 1 != s1 ? v[i + s2] : val, z + 1 != s2 ? v[i + 1] : val};
+
+                      for (unsigned int dimId = 0; dimId < 3; ++dimId)
                       {
-                          const auto it2 = points_as_intersection.find(pid1);
-                          if (it2 == points_as_intersection.end())
+                          if (!_is_crossing(val, upper[dimId]) || _edge_vertex_type(val, upper[dimId]) != 2)
+                          { continue; }
+
+                          if (m != nullptr)
                           {
-                              mesh.geometry().emplace_back(std::move(intersection));
-                              const int id = cnt;
-                              //points_as_intersection.insert(std::pair<unsigned int, unsigned int>(pid1, cnt++));
-                              points_as_intersection.emplace(pid1, cnt++);
-                              return id;
+                              const double mu = (_iso - val) / (upper[dimId] - val);
+                              m->geometry().point(vid) = to_world(x + (dimId == 0 ? mu : 0), y + (dimId == 1 ? mu : 0), z + (dimId == 2 ? mu : 0));
                           }
-                          else
-                          { return static_cast<int>(it2->second); }
-                      }
-                      default:
-                      {
-                          mesh.geometry().emplace_back(std::move(intersection));
-                          const int id = cnt;
-                          //edge_with_intersection.insert(std::pair<key_type, unsigned int>(key, cnt++));
-                          edge_with_intersection.emplace(key, cnt++);
-                          return id;
+
+                          cur.edge_ids[dimId][i] = vid++;
                       }
-                  }
-              }
-              else
-              { return static_cast<int>(it->second); }
+                  } // for z
+              } // for y
+
+              return vid;
           };
 
-          //#pragma omp parallel for
-          for (unsigned int z = 0; z < s[2] - 1; ++z)
+          // counts (m == nullptr) or writes the vertices and triangles of a slab; returns the number of owned vertices and triangles
+          const auto process_slab = [&](unsigned int s, unsigned int vid, unsigned int tid, TriangularMesh3D* m)
           {
-              for (unsigned int y = 0; y < s[1] - 1; ++y)
+              const unsigned int xBegin = slabBegin[s];
+              const unsigned int xEnd = slabBegin[s + 1];
+              const bool ownsLastPlane = s + 1 == numSlabs;
+              const unsigned int firstVid = vid;
+              const unsigned int firstTid = tid;
+
+              // ring buffer of planes x-1 ... x+2
+              std::array<_Plane, 4> ring;
+              const auto plane = [&](unsigned int x) -> _Plane& { return ring[x & 3]; };
+
+              if (xBegin != 0)
+              { load_values(static_cast<int>(xBegin) - 1, plane(xBegin - 1)); }
+
+              load_values(static_cast<int>(xBegin), plane(xBegin));
+              load_values(static_cast<int>(xBegin) + 1, plane(xBegin + 1));
+
+              vid = process_plane_vertices(xBegin, xBegin != 0 ? &plane(xBegin - 1) : nullptr, plane(xBegin), &plane(xBegin + 1), vid, m);
+              unsigned int ownedVid = vid;
+
+              for (unsigned int x = xBegin; x < xEnd; ++x)
               {
-                  for (unsigned int x = 0; x < s[0] - 1; ++x)
+                  const bool hasNext = x + 2 < s0;
+
+                  if (hasNext)
+                  { load_values(static_cast<int>(x) + 2, plane(x + 2)); }
+
+                  // plane x+1 is shared with the next slab, which owns and writes its vertices
+                  const bool ownsNextPlane = x + 1 < xEnd || ownsLastPlane;
+                  vid = process_plane_vertices(x + 1, &plane(x), plane(x + 1), hasNext ? &plane(x + 2) : nullptr, vid, ownsNextPlane ? m : nullptr);
+
+                  if (ownsNextPlane)
+                  { ownedVid = vid; }
+
+                  const _Plane* cellPlanes[2] = {&plane(x), &plane(x + 1)};
+
+                  for (unsigned int y = 0; y < s1 - 1; ++y)
                   {
-                      const unsigned int current_cell[8] = {grid_to_list_id(s, x, y, z), //
-                                                            grid_to_list_id(s, x + 1, y, z), //
-                                                            grid_to_list_id(s, x + 1, y + 1, z), //
-                                                            grid_to_list_id(s, x, y + 1, z), //
-                                                            grid_to_list_id(s, x, y, z + 1), //
-                                                            grid_to_list_id(s, x + 1, y, z + 1), //
-                                                            grid_to_list_id(s, x + 1, y + 1, z + 1), //
-                                                            grid_to_list_id(s, x, y + 1, z + 1) //
-                      };
-
-                      /*
-                          determine edge table index
-                       */
-
-                      unsigned int index = 0;
-                      unsigned int flag = 1;
-
-                      for (unsigned int i = 0; i < 8; ++i, flag <<= 1)
+                      for (unsigned int z = 0; z < s2 - 1; ++z)
                       {
-                          if (tempimg[current_cell[i]] < _iso)
-                          { index |= flag; }
-                      }
+                          const unsigned int i = y * s2 + z;
+                          const unsigned int cornerOffsets[4] = {i, i + 1, i + s2, i + s2 + 1};
 
-                      // alternative version to the for-loop above
-
-                      //if (tempimg[current_cell[0]] < _iso)
-                      //{ index |= 1; }
-                      //if (tempimg[current_cell[1]] < _iso)
-                      //{ index |= 2; }
-                      //if (tempimg[current_cell[2]] < _iso)
-                      //{ index |= 4; }
-                      //if (tempimg[current_cell[3]] < _iso)
-                      //{ index |= 8; }
-                      //if (tempimg[current_cell[4]] < _iso)
-                      //{ index |= 16; }
-                      //if (tempimg[current_cell[5]] < _iso)
-                      //{ index |= 32; }
-                      //if (tempimg[current_cell[6]] < _iso)
-                      //{ index |= 64; }
-                      //if (tempimg[current_cell[7]] < _iso)
-                      //{ index |= 128; }
-
-                      /* edgeTable[index] == 0 means that cube is entirely in/out of the surface */
-                      if (edgeTable[index] != 0)
-                      {
-                          /* Find the vertices where the surface intersects the cube */
-                          const int real_indices[12] = {//
-                              edgeTable[index] & 1 ? calc_and_add_intersection(current_cell[0], current_cell[1]) : -1, //
-                              edgeTable[index] & 2 ? calc_and_add_intersection(current_cell[1], current_cell[2]) : -1, //
-                              edgeTable[index] & 4 ? calc_and_add_intersection(current_cell[2], current_cell[3]) : -1, //
-                              edgeTable[index] & 8 ? calc_and_add_intersection(current_cell[3], current_cell[0]) : -1, //
-                              edgeTable[index] & 16 ? calc_and_add_intersection(current_cell[4], current_cell[5]) : -1, //
-                              edgeTable[index] & 32 ? calc_and_add_intersection(current_cell[5], current_cell[6]) : -1, //
-                              edgeTable[index] & 64 ? calc_and_add_intersection(current_cell[6], current_cell[7]) : -1, //
-                              edgeTable[index] & 128 ? calc_and_add_intersection(current_cell[7], current_cell[4]) : -1, //
-                              edgeTable[index] & 256 ? calc_and_add_intersection(current_cell[0], current_cell[4]) : -1, //
-                              edgeTable[index] & 512 ? calc_and_add_intersection(current_cell[1], current_cell[5]) : -1, //
-                              edgeTable[index] & 1024 ? calc_and_add_intersection(current_cell[2], current_cell[6]) : -1, //
-                              edgeTable[index] & 2048 ? calc_and_add_intersection(current_cell[3], current_cell[7]) : -1 //
-                          };
-
-                          // make triangle
-                          for (unsigned int i = 0; triTable[index][i] != -1; i += 3)
+                          const auto corner_value = [&](unsigned int k)
+                          { return cellPlanes[k >> 2]->values[cornerOffsets[k & 3]]; };
+
+                          unsigned int index = 0;
+                          for (unsigned int k = 0; k < 8; ++k)
+                          { index |= static_cast<unsigned int>(cellPlanes[cellCorners[k] >> 2]->below_iso[cornerOffsets[cellCorners[k] & 3]]) << k; }
+
+                          /* edgeTable[index] == 0 means that cube is entirely in/out of the surface */
+                          if (edgeTable[index] == 0)
+                          { continue; }
+
+                          unsigned int vertexIds[12];
+
+                          for (unsigned int e = 0; e < 12; ++e)
                           {
-                              if (real_indices[triTable[index][i]] != real_indices[triTable[index][i + 1]] && real_indices[triTable[index][i]] != real_indices[triTable[index][i + 2]] && real_indices[triTable[index][i + 1]] != real_indices[triTable[index][i + 2]])
+                              if (!(edgeTable[index] & (1 << e)))
+                              { continue; }
+
+                              const unsigned int lower = cellEdges[e][0];
+                              const unsigned int upper = cellEdges[e][1];
+
+                              switch (_edge_vertex_type(corner_value(lower), corner_value(upper)))
                               {
-                                  // inverted cell ordering for outward-pointing normals via cross product
-                                  //mesh.topology().emplace_back(real_indices[triTable[index][i + 2]], real_indices[triTable[index][i + 1]], real_indices[triTable[index][i]]);
+                                  case 0: vertexIds[e] = cellPlanes[lower >> 2]->point_ids[cornerOffsets[lower & 3]]; break;
+                                  case 1: vertexIds[e] = cellPlanes[upper >> 2]->point_ids[cornerOffsets[upper & 3]]; break;
+                                  default: vertexIds[e] = cellPlanes[lower >> 2]->edge_ids[cellEdges[e][2]][cornerOffsets[lower & 3]]; break;
+                              }
+                          }
 
-                                  mesh.topology().emplace_back(real_indices[triTable[index][i]], real_indices[triTable[index][i + 1]], real_indices[triTable[index][i + 2]]);
+                          // make triangles; degenerated ones (intersections at grid points) are skipped
+                          for (unsigned int k = 0; triTable[index][k] != -1; k += 3)
+                          {
+                              const unsigned int a = vertexIds[triTable[index][k]];
+                              const unsigned int b = vertexIds[triTable[index][k + 1]];
+                              const unsigned int c = vertexIds[triTable[index][k + 2]];
+
+                              if (a != b && a != c && b != c)
+                              {
+                                  if (m != nullptr)
+                                  {
+                                      auto& cell = m->topology().cell(tid);
+                                      cell[0] = a;
+                                      cell[1] = b;
+                                      cell[2] = c;
+                                  }
+
+                                  ++tid;
                               }
                           }
-                      }
-                  } // for x
-              } // for y
+                      } // for z
+                  } // for y
+              } // for x
+
+              return std::make_pair(ownedVid - firstVid, tid - firstTid);
+          };
+
+          /*
+           * pass 1: count
+           */
+          std::vector<unsigned int> vertexOffset(numSlabs + 1, 0);
+          std::vector<unsigned int> triangleOffset(numSlabs + 1, 0);
+
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (unsigned int s = 0; s < numSlabs; ++s)
+          {
+              std::tie(vertexOffset[s + 1], triangleOffset[s + 1]) = process_slab(s, 0, 0, nullptr);
 
               #ifdef BK_EMIT_PROGRESS
-              prog.increment(N2);
+              prog.increment(1);
               #endif
-          } // for z
+          }
 
-          // correct the 0-boundary
-          const auto p0 = img.geometry().transformation().to_world_coordinates(Vec3d(0, 0, 0));
-          const auto p1 = img.geometry().transformation().to_world_coordinates(Vec3d(1, 1, 1));
-          const auto correction = p1 - p0;
+          for (unsigned int s = 1; s <= numSlabs; ++s)
+          {
+              vertexOffset[s] += vertexOffset[s - 1];
+              triangleOffset[s] += triangleOffset[s - 1];
+          }
 
-          #pragma omp parallel for
-          for (int i = 0; i < static_cast<int>(mesh.geometry().num_points()); ++i)
-          { mesh.geometry().point(i) -= correction; }
+          mesh.geometry().set_num_points(vertexOffset[numSlabs]);
+          mesh.topology().set_num_cells(triangleOffset[numSlabs]);
 
           #ifdef BK_EMIT_PROGRESS
-          prog.increment(N);
+          prog.increment(1);
           #endif
 
+          /*
+           * pass 2: generate
+           */
+          if (vertexOffset[numSlabs] != 0)
+          {
+              #pragma omp parallel for schedule(dynamic, 1)
+              for (unsigned int s = 0; s < numSlabs; ++s)
+              {
+                  [[maybe_unused]] const auto cnt = process_slab(s, vertexOffset[s], triangleOffset[s], &mesh);
+
+                  #ifdef BK_EMIT_PROGRESS
+                  prog.increment(1);
+                  #endif
+              }
+          }
+
+          /*
+           * remove vertices whose triangles are all degenerated
+           */
+          const unsigned int numVertices = vertexOffset[numSlabs];
+          std::vector<unsigned int> newVertexId(numVertices, 0);
+
+          for (const auto& cell: mesh.topology())
+          {
+              for (unsigned int k = 0; k < 3; ++k)
+              { newVertexId[cell[k]] = 1; }
+          }
+
+          if (std::find(newVertexId.begin(), newVertexId.end(), 0) != newVertexId.end())
+          {
+              unsigned int cnt = 0;
+
+              for (unsigned int i = 0; i < numVertices; ++i)
+              {
+                  if (newVertexId[i] != 0)
+                  {
+                      mesh.geometry().point(cnt) = mesh.geometry().point(i);
+                      newVertexId[i] = cnt++;
+                  }
+              }
+
+              mesh.geometry().set_num_points(cnt);
+
+              for (auto& cell: mesh.topology())
+              {
+                  for (unsigned int k = 0; k < 3; ++k)
+                  { cell[k] = newVertexId[cell[k]]; }
+              }
+          }
+
           mesh.init(); // update point neighbor lists, calc normals, ...
 
           #ifdef BK_EMIT_PROGRESS
@@ -34,6 +34,8 @@
 #include <type_traits>
 #include <vector>
 
+#include <bkDataset/image/EImageBoundaryMode.h>
+#include <bkDataset/image/ImageNeighborhood.h>
 #include <bkDataset/lib/bkDataset_export.h>
 
 namespace bk
@@ -45,6 +47,13 @@ namespace bk
       //====================================================================================================
       using self_type = MedianImageFilter;
 
+    public:
+      //! integer images with a larger value range fall back to the selection-based median
+      [[nodiscard]] static constexpr unsigned int MaxNumHistogramBins()
+      { return 1U << 16; }
+
+    private:
+
       //====================================================================================================
       //===== MEMBERS
       //====================================================================================================
@@ -95,7 +104,208 @@ namespace bk
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
+      /// @{ -------------------------------------------------- HELPER: HISTOGRAM MEDIAN
+    private:
+      //! sliding histogram median (Huang) along the lines of the last dimension
+      /*!
+       * - the window is moved by one voxel per step: one slab of the kernel (all kernel elements
+       *   with the same offset in the last dimension) leaves, one slab enters
+       * - the median bin and the number of window values below it are tracked incrementally,
+       *   so the median is found by walking only a few bins from the previous result
+       * - bins cover the value range [minVal, minVal + numBins) of the image
+       */
+      template<typename TImage>
+      void _apply_histogram(const TImage& img, TImage& res, long long minVal, unsigned int numBins) const
+      {
+          using value_type = typename TImage::value_type;
+
+          const unsigned int nDims = img.num_dimensions();
+          const auto& size = img.size();
+          const int lineLength = static_cast<int>(size[nDims - 1]);
+
+          std::vector<int> offMin(nDims, 0);
+          std::vector<int> offMax(nDims, 0);
+          std::vector<unsigned int> stride(nDims, 1);
+          unsigned int numLines = 1;
+          unsigned int maxNumRows = 1;
+
+          for (unsigned int d = 0; d < nDims; ++d)
+          {
+              const int ks = d < _kernel_size.size() ? std::max(1, static_cast<int>(_kernel_size[d])) : 1;
+              offMin[d] = -(ks >> 1); // integer division
+              offMax[d] = ks - 1 + offMin[d];
+
+              if (d + 1 < nDims)
+              {
+                  numLines *= size[d];
+                  maxNumRows *= static_cast<unsigned int>(ks);
+              }
+          }
+
+          for (int d = static_cast<int>(nDims) - 2; d >= 0; --d)
+          { stride[d] = stride[d + 1] * size[d + 1]; }
+
+          #pragma omp parallel
+          {
+              std::vector<unsigned int> hist(numBins, 0);
+              std::vector<unsigned int> rows; // list ids of the kernel rows (last dimension = 0)
+              std::vector<int> lineGid(nDims, 0);
+              std::vector<int> rowGid(nDims, 0);
+              std::vector<int> rowMin(nDims, 0);
+              std::vector<int> rowMax(nDims, 0);
+              rows.reserve(maxNumRows);
+
+              // state is kept between lines; the median of the previous line is a good starting point
+              unsigned int medBin = 0;
+              unsigned int numBelow = 0; // number of window values in bins < medBin
+              unsigned int n = 0;
+
+              const auto add_column = [&](int x)
+              {
+                  for (unsigned int r: rows)
+                  {
+                      const unsigned int b = static_cast<unsigned int>(static_cast<long long>(img[r + x]) - minVal);
+                      ++hist[b];
+                      numBelow += b < medBin;
+                  }
+
+                  n += static_cast<unsigned int>(rows.size());
+              };
+
+              const auto remove_column = [&](int x)
+              {
+                  for (unsigned int r: rows)
+                  {
+                      const unsigned int b = static_cast<unsigned int>(static_cast<long long>(img[r + x]) - minVal);
+                      --hist[b];
+                      numBelow -= b < medBin;
+                  }
+
+                  n -= static_cast<unsigned int>(rows.size());
+              };
+
+              #pragma omp for
+              for (unsigned int lineId = 0; lineId < numLines; ++lineId)
+              {
+                  /*
+                   * kernel rows of this line (clipped to the image)
+                   */
+                  unsigned int rem = lineId;
+
+                  for (int d = static_cast<int>(nDims) - 2; d >= 0; --d)
+                  {
+                      lineGid[d] = static_cast<int>(rem % size[d]);
+                      rem /= size[d];
+                  }
+
+                  rows.clear();
+
+                  for (unsigned int d = 0; d + 1 < nDims; ++d)
+                  {
+                      rowMin[d] = std::max(0, lineGid[d] + offMin[d]);
+                      rowMax[d] = std::min(static_cast<int>(size[d]) - 1, lineGid[d] + offMax[d]);
+                      rowGid[d] = rowMin[d];
+                  }
+
+                  for (bool done = false; !done;)
+                  {
+                      unsigned int lid = 0;
+
+                      for (unsigned int d = 0; d + 1 < nDims; ++d)
+                      { lid += static_cast<unsigned int>(rowGid[d]) * stride[d]; }
+
+                      rows.push_back(lid);
+
+                      done = true;
+
+                      for (int d = static_cast<int>(nDims) - 2; d >= 0; --d)
+                      {
+                          if (++rowGid[d] <= rowMax[d])
+                          {
+                              done = false;
+                              break;
+                          }
+
+                          rowGid[d] = rowMin[d];
+                      }
+                  }
+
+                  /*
+                   * slide along the line
+                   */
+                  const unsigned int lineStart = lineId * static_cast<unsigned int>(lineLength);
+
+                  for (int x = 0; x <= std::min(offMax[nDims - 1], lineLength - 1); ++x)
+                  { add_column(x); }
+
+                  for (int x = 0; x < lineLength; ++x)
+                  {
+                      const unsigned int rank = n >> 1;
+
+                      while (numBelow > rank)
+                      { numBelow -= hist[--medBin]; }
+
+                      while (numBelow + hist[medBin] <= rank)
+                      { numBelow += hist[medBin++]; }
+
+                      res[lineStart + static_cast<unsigned int>(x)] = static_cast<value_type>(static_cast<long long>(medBin) + minVal);
+
+                      if (const int xOut = x + offMin[nDims - 1]; xOut >= 0)
+                      { remove_column(xOut); }
+
+                      if (const int xIn = x + offMax[nDims - 1] + 1; xIn < lineLength)
+                      { add_column(xIn); }
+                  } // for x
+
+                  // empty the histogram for the next line
+                  for (int x = std::max(0, lineLength + offMin[nDims - 1]); x < lineLength; ++x)
+                  { remove_column(x); }
+              } // for lineId
+          } // omp parallel
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: SELECTION MEDIAN
+      //! nth_element on the gathered neighborhood (reused buffer per thread)
+      template<typename TImage>
+      void _apply_selection(const TImage& img, TImage& res) const
+      {
+          using value_type = typename TImage::value_type;
+
+          #pragma omp parallel
+          {
+              ImageNeighborhood nb(img.size(), _kernel_size, ImageBoundaryMode::Skip);
+              std::vector<value_type> values(nb.num_values());
+
+              #pragma omp for
+              for (unsigned int lineId = 0; lineId < nb.num_lines(); ++lineId)
+              {
+                  for (nb.set_line(lineId); nb.is_in_line(); nb.next())
+                  {
+                      const unsigned int lid = nb.list_id();
+                      const unsigned int n = nb.gather(img, values.data());
+
+                      if (n != 0)
+                      {
+                          std::nth_element(values.begin(), values.begin() + (n >> 1), values.begin() + n);
+                          res[lid] = values[n >> 1];
+                      }
+                      else
+                      { res[lid] = img[lid]; }
+                  } // for nb
+              } // for lineId
+          } // omp parallel
+      }
+    public:
+      /// @}
+
       /// @{ -------------------------------------------------- APPLY
+      //! median of the kernel neighborhood; positions outside of the image are omitted
+      /*!
+       * - integer images whose value range fits into MaxNumHistogramBins() use a sliding histogram,
+       *   i.e. the cost per voxel grows with the kernel cross-section instead of the kernel volume
+       * - all other images (e.g. floating point) use a selection (nth_element) per voxel
+       */
       template<typename TImage>
       [[nodiscard]] TImage apply(const TImage& img) const
       {
@@ -106,20 +316,23 @@ namespace bk
           TImage res;
           res.set_size(img.size());
 
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < img.num_values(); ++i)
+          if (img.num_values() == 0)
+          { return res; }
+
+          if constexpr (std::is_integral_v<value_type> && !std::is_same_v<value_type, bool>)
           {
-              std::vector<value_type> values = img.values_of_neighborhood(i, _kernel_size);
+              const long long minVal = static_cast<long long>(img.min_value());
+              const long long maxVal = static_cast<long long>(img.max_value());
 
-              if (!values.empty())
+              if (maxVal - minVal < static_cast<long long>(MaxNumHistogramBins()))
               {
-                  std::sort(values.begin(), values.end());
-                  res[i] = values[values.size() >> 1];
+                  _apply_histogram(img, res, minVal, static_cast<unsigned int>(maxVal - minVal + 1));
+                  return res;
               }
-              else
-              { res[i] = img[i]; }
           }
 
+          _apply_selection(img, res);
+
           return res;
       }
       /// @}
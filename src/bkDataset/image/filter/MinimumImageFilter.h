@@ -27,13 +27,12 @@
 #ifndef BK_MINIMUMIMAGEFILTER_H
 #define BK_MINIMUMIMAGEFILTER_H
 
-#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <initializer_list>
-#include <numeric>
-#include <type_traits>
 #include <vector>
 
+#include <bkDataset/image/filter/VanHerkGilWerman.h>
 #include <bkDataset/lib/bkDataset_export.h>
 
 namespace bk
@@ -96,6 +95,10 @@ namespace bk
       //===== FUNCTIONS
       //====================================================================================================
       /// @{ -------------------------------------------------- APPLY
+      //! minimum of the box kernel neighborhood; positions outside of the image are omitted
+      /*!
+       * Separable van Herk / Gil-Werman passes, i.e. the cost per voxel does not depend on the kernel size.
+       */
       template<typename TImage>
       [[nodiscard]] TImage apply(const TImage& img) const
       {
@@ -103,22 +106,8 @@ namespace bk
 
           using value_type = typename TImage::value_type;
 
-          TImage res;
-          res.set_size(img.size());
-
-          #pragma omp parallel for
-          for (unsigned int i = 0; i < img.num_values(); ++i)
-          {
-              std::vector<value_type> values = img.values_of_neighborhood(i, _kernel_size);
-
-              if (!values.empty())
-              {
-                  std::sort(values.begin(), values.end());
-                  res[i] = values.front();
-              }
-              else
-              { res[i] = img[i]; }
-          }
+          TImage res = img;
+          details::van_herk_gil_werman(res, _kernel_size, std::less<value_type>());
 
           return res;
       }
@@ -95,9 +95,9 @@ namespace bk
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
-      /// @{ -------------------------------------------------- APPLY
+      /// @{ -------------------------------------------------- APPLY IN PLACE
       template<typename TImage>
-      [[nodiscard]] TImage apply(const TImage& img) const
+      void apply_in_place(TImage& img) const
       {
           // kernel: 1x dilation
           MorphologicalDilationImageFilter fdilation;
@@ -112,7 +112,19 @@ namespace bk
           ferosiontwice.set_kernel_size(doubleKernelSize.begin(), doubleKernelSize.end());
 
           // apply: closing=[dilation, erosion], opening=[erosion, dilation]
-          return fdilation.apply(ferosiontwice.apply(fdilation.apply(img)));
+          fdilation.apply_in_place(img);
+          ferosiontwice.apply_in_place(img);
+          fdilation.apply_in_place(img);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] TImage apply(const TImage& img) const
+      {
+          TImage res = img;
+          apply_in_place(res);
+          return res;
       }
       /// @}
   }; // class MorphologicalClosingAndOpeningImageFilter
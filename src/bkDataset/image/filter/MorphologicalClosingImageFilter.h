@@ -95,9 +95,9 @@ namespace bk
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
-      /// @{ -------------------------------------------------- APPLY
+      /// @{ -------------------------------------------------- APPLY IN PLACE
       template<typename TImage>
-      [[nodiscard]] TImage apply(const TImage& img) const
+      void apply_in_place(TImage& img) const
       {
           MorphologicalDilationImageFilter fdilation;
           fdilation.set_kernel_size(_kernel_size.begin(), _kernel_size.end());
@@ -105,7 +105,18 @@ namespace bk
           MorphologicalErosionImageFilter ferosion;
           ferosion.set_kernel_size(_kernel_size.begin(), _kernel_size.end());
 
-          return ferosion.apply(fdilation.apply(img));
+          fdilation.apply_in_place(img);
+          ferosion.apply_in_place(img);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] TImage apply(const TImage& img) const
+      {
+          TImage res = img;
+          apply_in_place(res);
+          return res;
       }
       /// @}
   }; // class MorphologicalClosingImageFilter
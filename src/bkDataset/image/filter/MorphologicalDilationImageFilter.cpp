@@ -24,6 +24,8 @@
 
 #include <bkDataset/image/filter/MorphologicalDilationImageFilter.h>
 
+#include <algorithm>
+
 namespace bk
 {
   //====================================================================================================
@@ -54,6 +56,19 @@ namespace bk
   { return _kernel_size; }
   /// @}
 
+  /// @{ -------------------------------------------------- GET STRUCTURING ELEMENT
+  StructuringElement MorphologicalDilationImageFilter::structuring_element() const
+  {
+      const bool kernel_has_isotropic_size = std::all_of(_kernel_size.begin(), _kernel_size.end(), [&](unsigned int x)
+      { return x == _kernel_size.front(); });
+
+      if (kernel_has_isotropic_size && !_kernel_size.empty())
+      { return StructuringElement::make_diamond(static_cast<unsigned int>(_kernel_size.size()), _kernel_size.front() >> 1); }
+
+      return StructuringElement::make_box(_kernel_size);
+  }
+  /// @}
+
   //====================================================================================================
   //===== SETTER
   //====================================================================================================
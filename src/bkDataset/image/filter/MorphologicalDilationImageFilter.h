@@ -27,22 +27,14 @@
 #ifndef BK_MORPHOLOGICALDILATIONIMAGEFILTER_H
 #define BK_MORPHOLOGICALDILATIONIMAGEFILTER_H
 
-#include <algorithm>
 #include <cassert>
 #include <initializer_list>
-#include <type_traits>
 #include <vector>
 
-#include <bkDataset/image/filter/KernelFactory.h>
 #include <bkDataset/image/filter/MorphologicalOperationImageFilter.h>
-#include <bkDataset/image/filter/DistanceMapImageFilter.h>
+#include <bkDataset/image/filter/StructuringElement.h>
 #include <bkDataset/lib/bkDataset_export.h>
 
-#ifdef BK_EMIT_PROGRESS
-    #include <bk/Progress>
-    #include <bk/Localization>
-#endif
-
 namespace bk
 {
   class BKDATASET_EXPORT MorphologicalDilationImageFilter
@@ -79,6 +71,11 @@ namespace bk
       [[nodiscard]] const std::vector<unsigned int>& kernel_size() const;
       /// @}
 
+      /// @{ -------------------------------------------------- GET STRUCTURING ELEMENT
+      //! isotropic kernel size k: diamond of radius k/2; box otherwise
+      [[nodiscard]] StructuringElement structuring_element() const;
+      /// @}
+
       //====================================================================================================
       //===== SETTER
       //====================================================================================================
@@ -102,52 +99,25 @@ namespace bk
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
-      /// @{ -------------------------------------------------- APPLY
+      /// @{ -------------------------------------------------- APPLY IN PLACE
+      //! grows the region of the maximum value by structuring_element()
       template<typename TImage>
-      [[nodiscard]] TImage apply(const TImage& img) const
+      void apply_in_place(TImage& img) const
       {
           assert(!_kernel_size.empty() && "call set_kernel_size() first");
 
-          const bool kernel_has_isotropic_size = std::all_of(_kernel_size.begin(), _kernel_size.end(), [&](unsigned int x)
-          { return x == _kernel_size.front(); });
-
-          if (kernel_has_isotropic_size)
-          {
-              #ifdef BK_EMIT_PROGRESS
-              bk::Progress& prog = bk_progress.emplace_task(3, ___("Morphological dilation filtering"));
-              #endif
-
-              TImage res;
-              res.set_size(img.size());
-
-              const auto maxVal = img.max_value();
-
-              #ifdef BK_EMIT_PROGRESS
-              prog.increment(1);
-              #endif
-
-              DistanceMapImageFilter f;
-              f.set_value(maxVal);
-              auto distance_map = img.filter(f);
-
-              #ifdef BK_EMIT_PROGRESS
-              prog.increment(1);
-              #endif
-
-              const unsigned int halfKernelSize = _kernel_size.front() >> 1;
-
-              #pragma omp parallel for
-              for (unsigned int i = 0; i < img.num_values(); ++i)
-              { res[i] = distance_map[i] <= halfKernelSize ? maxVal : img[i]; }
-
-              #ifdef BK_EMIT_PROGRESS
-              prog.set_finished();
-              #endif
+          if (img.num_values() != 0)
+          { MorphologicalOperationImageFilter::apply_in_place(img, structuring_element(), img.max_value()); }
+      }
+      /// @}
 
-              return res;
-          }
-          else
-          { return MorphologicalOperationImageFilter::apply(img, KernelFactory::make_dilation_morphological_of_sizes(_kernel_size)); }
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] TImage apply(const TImage& img) const
+      {
+          TImage res = img;
+          apply_in_place(res);
+          return res;
       }
       /// @}
   }; // class MorphologicalDilationImageFilter
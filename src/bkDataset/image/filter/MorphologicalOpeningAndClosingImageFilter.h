@@ -95,9 +95,9 @@ namespace bk
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
-      /// @{ -------------------------------------------------- APPLY
+      /// @{ -------------------------------------------------- APPLY IN PLACE
       template<typename TImage>
-      [[nodiscard]] TImage apply(const TImage& img) const
+      void apply_in_place(TImage& img) const
       {
           // kernel: 1x erosion
           MorphologicalErosionImageFilter ferosion;
@@ -112,7 +112,19 @@ namespace bk
           fdilationtwice.set_kernel_size(doubleKernelSize.begin(), doubleKernelSize.end());
 
           // apply: opening=[erosion, dilation], closing=[dilation, erosion]
-          return ferosion.apply(fdilationtwice.apply(ferosion.apply(img)));
+          ferosion.apply_in_place(img);
+          fdilationtwice.apply_in_place(img);
+          ferosion.apply_in_place(img);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] TImage apply(const TImage& img) const
+      {
+          TImage res = img;
+          apply_in_place(res);
+          return res;
       }
       /// @}
   }; // class MorphologicalOpeningAndClosingImageFilter
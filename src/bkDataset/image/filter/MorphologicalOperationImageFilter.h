@@ -28,6 +28,8 @@
 #define BK_MORPHOLOGICALOPERATIONIMAGEFILTER_H
 
 #include <algorithm>
+#include <functional>
+#include <vector>
 
 #ifdef BK_EMIT_PROGRESS
 
@@ -36,95 +38,279 @@
 
 #endif
 
-#include <bkMath/matrix/MatrixFactory.h>
-#include <bkMath/functions/list_grid_id_conversion.h>
+#include <bkDataset/image/filter/DistanceMapImageFilter.h>
+#include <bkDataset/image/filter/EuclideanDistanceMapImageFilter.h>
+#include <bkDataset/image/filter/StructuringElement.h>
+#include <bkDataset/image/filter/VanHerkGilWerman.h>
 #include <bkDataset/lib/bkDataset_export.h>
 
 namespace bk
 {
+  //! binary morphology engine: grows the region of voxels that have a given value (structel)
+  /*!
+   * - a voxel is set to structel if the structuring element, centered at any voxel of the region,
+   *   covers it (dilation of the region; the erosion of an image is the dilation of its minimum)
+   * - the region is extracted to a byte mask, dilated, and written back, i.e. there are no
+   *   concurrent writes and the result does not depend on the thread schedule
+   * - the dilation is decomposed according to the shape of the structuring element:
+   *      Box:      separable running maximum (van Herk / Gil-Werman), independent of the size
+   *      Cross:    union of 1D running maxima along each dimension
+   *      Diamond:  thresholded city block distance map, independent of the radius
+   *      Ball:     thresholded squared euclidean distance map, independent of the radius
+   *      Custom:   per-voxel gather over the offset list
+   * - neighbors outside of the image are omitted
+   */
   class BKDATASET_EXPORT MorphologicalOperationImageFilter
   {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      template<typename TImage> using mask_type = typename TImage::template self_template_type<unsigned char>;
+
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
-      /// @{ -------------------------------------------------- HELPERS
-    private:
-      template<typename TKernel, typename TIndexAccessible0, typename TIndexAccessible1, typename TIndexAccessible2, typename TImage, typename T>
-      static void _apply_morphological_operation_kernel(unsigned int dimId, const TKernel& kernel, const TIndexAccessible0& gid, TIndexAccessible1& off, TIndexAccessible2& kernel_gid, TImage& res, const T& fillValue)
+      /// @{ -------------------------------------------------- HELPER: DILATE MASK
+      //! running maximum over the reflected box [-offMax, -offMin]
+      template<typename TMask>
+      static void _dilate_mask_box(TMask& mask, const StructuringElement& se, unsigned int dimBegin, unsigned int dimEnd)
       {
-          const int halfsize = kernel.size(dimId) >> 1; // integer division
+          std::vector<int> offMin(mask.num_dimensions(), 0);
+          std::vector<int> offMax(mask.num_dimensions(), 0);
 
-          if (dimId < res.num_dimensions() - 1)
+          for (unsigned int d = dimBegin; d < std::min(dimEnd, mask.num_dimensions()); ++d)
           {
-              for (int i = -halfsize; i <= halfsize; ++i)
-              {
-                  off[dimId] = i;
-                  kernel_gid[dimId] = i + halfsize;
-                  _apply_morphological_operation_kernel(dimId + 1, kernel, gid, off, kernel_gid, res, fillValue);
-              } // for i
+              offMin[d] = -se.offset_max(d);
+              offMax[d] = -se.offset_min(d);
           }
-          else // if (d == res.num_dimensions()-1)
+
+          details::van_herk_gil_werman(mask, offMin, offMax, std::greater<unsigned char>());
+      }
+
+      //! dst[j] = 1 if src[j - offset] == 1 for any element offset of se
+      template<typename TMask>
+      static void _dilate_mask_gather(const TMask& src, TMask& dst, const StructuringElement& se)
+      {
+          const unsigned int nDims = src.num_dimensions();
+          const unsigned int numElements = se.num_elements();
+          const auto& size = src.size();
+          const int lineLength = static_cast<int>(size[nDims - 1]);
+
+          std::vector<int> stride(nDims, 1);
+          for (int d = static_cast<int>(nDims) - 2; d >= 0; --d)
+          { stride[d] = stride[d + 1] * static_cast<int>(size[d + 1]); }
+
+          // linear offsets of the reflected element
+          std::vector<int> lidOffsets(numElements, 0);
+          for (unsigned int k = 0; k < numElements; ++k)
           {
-              for (int i = -halfsize; i <= halfsize; ++i)
+              for (unsigned int d = 0; d < nDims; ++d)
+              { lidOffsets[k] -= se.offset(k, d) * stride[d]; }
+          }
+
+          const unsigned int numLines = src.num_values() / static_cast<unsigned int>(lineLength);
+
+          #pragma omp parallel
+          {
+              std::vector<int> gid(nDims, 0);
+
+              #pragma omp for
+              for (unsigned int lineId = 0; lineId < numLines; ++lineId)
               {
-                  off[dimId] = i;
-                  kernel_gid[dimId] = i + halfsize;
+                  unsigned int rem = lineId;
 
-                  auto gidoff = MatrixFactory::create<int, TImage::NumDimensionsAtCompileTime(), 1>(res.num_dimensions(), 1);
+                  for (int d = static_cast<int>(nDims) - 2; d >= 0; --d)
+                  {
+                      gid[d] = static_cast<int>(rem % size[d]);
+                      rem /= size[d];
+                  }
 
-                  for (unsigned int d = 0; d < res.num_dimensions(); ++d)
-                  { gidoff[d] = gid[d] + off[d]; }
+                  const int lineStart = static_cast<int>(lineId) * lineLength;
 
-                  gidoff = res.clamp_to_size(std::move(gidoff));
+                  for (int x = 0; x < lineLength; ++x)
+                  {
+                      const int lid = lineStart + x;
+                      gid[nDims - 1] = x;
 
-                  #pragma omp critical
-                  { res(gidoff) = fillValue * kernel(kernel_gid); }
-              } // for i
-          }
-      }
+                      bool isInterior = true;
 
-    public:
+                      for (unsigned int d = 0; d < nDims; ++d)
+                      {
+                          if (gid[d] - se.offset_max(d) < 0 || gid[d] - se.offset_min(d) >= static_cast<int>(size[d]))
+                          {
+                              isInterior = false;
+                              break;
+                          }
+                      }
+
+                      unsigned char hit = src[lid];
+
+                      for (unsigned int k = 0; k < numElements && !hit; ++k)
+                      {
+                          if (isInterior)
+                          { hit = src[lid + lidOffsets[k]]; }
+                          else
+                          {
+                              bool inside = true;
+
+                              for (unsigned int d = 0; d < nDims && inside; ++d)
+                              {
+                                  const int c = gid[d] - se.offset(k, d);
+                                  inside = c >= 0 && c < static_cast<int>(size[d]);
+                              }
+
+                              if (inside)
+                              { hit = src[lid + lidOffsets[k]]; }
+                          }
+                      } // for k
+
+                      dst[lid] = hit;
+                  } // for x
+              } // for lineId
+          } // omp parallel
+      }
       /// @}
 
-      /// @{ -------------------------------------------------- APPLY
-      template<typename TImage, typename TKernel>
-      [[nodiscard]] static TImage apply(const TImage& img, const TKernel& kernel)
+    public:
+      /// @{ -------------------------------------------------- APPLY IN PLACE
+      //! dilates the region of voxels with value structel by se; no copy of the image is created
+      template<typename TImage>
+      static void apply_in_place(TImage& img, const StructuringElement& se, const typename TImage::value_type& structel)
       {
-          using value_type = typename TImage::value_type;
+          const unsigned int numValues = img.num_values();
+          const unsigned int nDims = img.num_dimensions();
 
-          TImage res = img;
-
-          /*const*/ auto[itMinVal, itMaxVal] = std::minmax_element(img.begin(), img.end());
-          const value_type structel = *itMinVal + (*itMaxVal - *itMinVal) * kernel[kernel.num_values() / 2];
+          if (numValues == 0 || se.num_elements() == 0)
+          { return; }
 
           #ifdef BK_EMIT_PROGRESS
-          Progress& prog = bk_progress.emplace_task(img.num_values(), ___("Morphological image filtering"));
+          Progress& prog = bk_progress.emplace_task(3, ___("Morphological image filtering"));
           #endif
 
+          mask_type<TImage> mask;
+          mask.set_size(img.size());
+
           #pragma omp parallel for
-          for (unsigned int i = 0; i < img.num_values(); ++i)
+          for (unsigned int i = 0; i < numValues; ++i)
+          { mask[i] = img[i] == structel ? 1 : 0; }
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
+
+          switch (se.shape())
           {
-              if (img[i] == structel)
+              case StructuringElementShape::Box:
               {
-                  const auto gid = bk::list_to_grid_id(img.size(), i);
-                  auto gidoff = MatrixFactory::create<int, TImage::NumDimensionsAtCompileTime(), 1>(img.num_dimensions(), 1);
-                  auto kernel_gid = MatrixFactory::create<int, TImage::NumDimensionsAtCompileTime(), 1>(img.num_dimensions(), 1);
+                  _dilate_mask_box(mask, se, 0, nDims);
+                  break;
+              }
+              case StructuringElementShape::Cross:
+              {
+                  mask_type<TImage> arm;
+                  mask_type<TImage> res = mask;
+
+                  for (unsigned int d = 0; d < std::min(nDims, se.num_dimensions()); ++d)
+                  {
+                      arm = mask;
+                      _dilate_mask_box(arm, se, d, d + 1);
+
+                      #pragma omp parallel for
+                      for (unsigned int i = 0; i < numValues; ++i)
+                      { res[i] |= arm[i]; }
+                  }
+
+                  mask = std::move(res);
+                  break;
+              }
+              case StructuringElementShape::Diamond:
+              {
+                  if (se.num_dimensions() == nDims)
+                  {
+                      DistanceMapImageFilter f;
+                      f.set_value(1);
+                      const auto distance_map = mask.filter(f);
+                      const unsigned int radius = se.radius();
+
+                      #pragma omp parallel for
+                      for (unsigned int i = 0; i < numValues; ++i)
+                      { mask[i] = distance_map[i] <= radius ? 1 : 0; }
 
-                  _apply_morphological_operation_kernel(0, kernel, gid, gidoff, kernel_gid, res, structel);
+                      break;
+                  }
+
+                  [[fallthrough]];
               }
+              case StructuringElementShape::Ball:
+              {
+                  if (se.shape() == StructuringElementShape::Ball && se.num_dimensions() == nDims)
+                  {
+                      const std::vector<double> unitSpacing(nDims, 1.0);
+
+                      EuclideanDistanceMapImageFilter f;
+                      f.set_value(1);
+                      f.set_spacing(unitSpacing.begin(), unitSpacing.end());
+                      f.set_squared_distance_enabled(true);
+                      const auto distance_map = mask.filter(f);
+                      const float radiusSquared = static_cast<float>(se.radius() * se.radius()) + 0.5f; // distances are integers
+
+                      #pragma omp parallel for
+                      for (unsigned int i = 0; i < numValues; ++i)
+                      { mask[i] = distance_map[i] <= radiusSquared ? 1 : 0; }
+
+                      break;
+                  }
+
+                  [[fallthrough]];
+              }
+              default: // Custom
+              {
+                  mask_type<TImage> res;
+                  res.set_size(img.size());
+                  _dilate_mask_gather(mask, res, se);
+                  mask = std::move(res);
+                  break;
+              }
+          }
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.increment(1);
+          #endif
 
-              #ifdef BK_EMIT_PROGRESS
-                  #pragma omp critical
-              { prog.increment(1); }
-              #endif
+          #pragma omp parallel for
+          for (unsigned int i = 0; i < numValues; ++i)
+          {
+              if (mask[i] != 0)
+              { img[i] = structel; }
           }
 
           #ifdef BK_EMIT_PROGRESS
           prog.set_finished();
           #endif
+      }
+      /// @}
 
+      /// @{ -------------------------------------------------- APPLY
+      template<typename TImage>
+      [[nodiscard]] static TImage apply(const TImage& img, const StructuringElement& se, const typename TImage::value_type& structel)
+      {
+          TImage res = img;
+          apply_in_place(res, se, structel);
           return res;
       }
+
+      //! box structuring element of the kernel's size; structel = min + (max - min) * (center weight of the kernel)
+      template<typename TImage, typename TKernel>
+      [[nodiscard]] static TImage apply(const TImage& img, const TKernel& kernel)
+      {
+          using value_type = typename TImage::value_type;
+
+          /*const*/ auto[itMinVal, itMaxVal] = std::minmax_element(img.begin(), img.end());
+          const value_type structel = *itMinVal + (*itMaxVal - *itMinVal) * kernel[kernel.num_values() / 2];
+
+          const auto& kernelSize = kernel.size();
+          return apply(img, StructuringElement::make_box(std::vector<unsigned int>(kernelSize.begin(), kernelSize.end())), structel);
+      }
       /// @}
   }; // class MorphologicalOperationImageFilter
 } // namespace bk
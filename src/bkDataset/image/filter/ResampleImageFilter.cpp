@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/filter/ResampleImageFilter.h>
+
+namespace bk
+{
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  ResampleImageFilter::ResampleImageFilter()
+      : ResampleImageFilter(ImageBoundaryMode::Clamp, 0)
+  { /* do nothing */ }
+
+  ResampleImageFilter::ResampleImageFilter(const self_type& other) = default;
+  ResampleImageFilter::ResampleImageFilter(self_type&& other) noexcept = default;
+
+  ResampleImageFilter::ResampleImageFilter(ImageBoundaryMode boundaryMode, double constantValue)
+      : _boundary_mode(boundaryMode),
+        _constant_value(constantValue)
+  { /* do nothing */ }
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  ResampleImageFilter::~ResampleImageFilter() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET BOUNDARY MODE
+  ImageBoundaryMode ResampleImageFilter::boundary_mode() const
+  { return _boundary_mode; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET CONSTANT VALUE
+  double ResampleImageFilter::constant_value() const
+  { return _constant_value; }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto ResampleImageFilter::operator=(const self_type& other) -> self_type& = default;
+  auto ResampleImageFilter::operator=(self_type&& other) noexcept -> self_type& = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- SET BOUNDARY MODE
+  void ResampleImageFilter::set_boundary_mode(ImageBoundaryMode boundaryMode)
+  { _boundary_mode = boundaryMode; }
+  /// @}
+
+  /// @{ -------------------------------------------------- SET CONSTANT VALUE
+  void ResampleImageFilter::set_constant_value(double x)
+  { _constant_value = x; }
+  /// @}
+} // namespace bk
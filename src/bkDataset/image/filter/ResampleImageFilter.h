@@ -0,0 +1,303 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_RESAMPLEIMAGEFILTER_H
+#define BK_RESAMPLEIMAGEFILTER_H
+
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#ifdef BK_EMIT_PROGRESS
+
+    #include <bk/Progress>
+    #include <bk/Localization>
+
+#endif
+
+#include <bkDataset/image/EImageBoundaryMode.h>
+#include <bkDataset/image/interpolation/CubicBSplineImageInterpolation.h>
+#include <bkDataset/image/interpolation/LinearImageInterpolation.h>
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! resamples an image onto the grid of another image (size + transformation)
+  /*!
+   * - all transformations (NoTransformation, Scale, Translation, WorldMatrix, Dicom) are affine,
+   *   so the mapping "target grid position -> source grid position" is determined once as
+   *   A * p + b; the source position is then computed incrementally along the scanlines
+   *   (one matrix-vector product per row, one vector addition per voxel)
+   * - parallelized over the slices (first dimension) of the target image
+   * - the interpolation is chosen by the interpolator object
+   *   (NearestNeighborImageInterpolation, LinearImageInterpolation, CubicBSplineImageInterpolation)
+   * - boundary modes: Clamp (default; positions are clamped by the interpolator) and Constant
+   *   (target voxels whose center is outside of the source image are set to constant_value())
+   */
+  class BKDATASET_EXPORT ResampleImageFilter
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = ResampleImageFilter;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      ImageBoundaryMode _boundary_mode;
+      double _constant_value;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      ResampleImageFilter();
+      ResampleImageFilter(const self_type& other);
+      ResampleImageFilter(self_type&& other) noexcept;
+      ResampleImageFilter(ImageBoundaryMode boundaryMode, double constantValue = 0);
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~ResampleImageFilter();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET BOUNDARY MODE
+      [[nodiscard]] ImageBoundaryMode boundary_mode() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET CONSTANT VALUE
+      [[nodiscard]] double constant_value() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET BOUNDARY MODE
+      //! Clamp or Constant
+      void set_boundary_mode(ImageBoundaryMode boundaryMode);
+      /// @}
+
+      /// @{ -------------------------------------------------- SET CONSTANT VALUE
+      //! value of target voxels outside of the source image (ImageBoundaryMode::Constant)
+      void set_constant_value(double x);
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER: SOURCE GRID POSITION
+      //! source grid position of the target grid position p
+      template<typename TImageIn, typename TImageOut>
+      [[nodiscard]] static std::vector<double> _source_grid_pos(const TImageIn& img, const TImageOut& res, const std::vector<double>& p)
+      {
+          const unsigned int nDims = img.num_dimensions();
+
+          const auto w = res.geometry().transformation().to_world_coordinates(p);
+
+          std::vector<double> wp(nDims);
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          { wp[dimId] = w[dimId]; }
+
+          const auto g = img.geometry().transformation().to_object_coordinates(wp);
+
+          std::vector<double> gp(nDims);
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          { gp[dimId] = g[dimId]; }
+
+          return gp;
+      }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- APPLY
+      //! resamples img onto the grid of res; size and transformation of res must be set
+      template<typename TImageIn, typename TImageOut, typename TInterpolator = LinearImageInterpolation>
+      void apply(const TImageIn& img, TImageOut& res, TInterpolator interp = TInterpolator()) const
+      {
+          assert((_boundary_mode == ImageBoundaryMode::Clamp || _boundary_mode == ImageBoundaryMode::Constant) && "unsupported boundary mode");
+          assert(img.num_dimensions() == res.num_dimensions() && "dimensionality mismatch");
+
+          const unsigned int nDims = res.num_dimensions();
+          const unsigned int lastDim = nDims - 1;
+          const unsigned int numValues = res.num_values();
+
+          if (numValues == 0 || img.num_values() == 0)
+          { return; }
+
+          /*
+           * affine mapping: source grid pos = b + sum_i p[i] * A[i]
+           */
+          std::vector<double> p(nDims, 0.0);
+          const std::vector<double> b = _source_grid_pos(img, res, p);
+          std::vector<std::vector<double>> A(nDims);
+
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              p[dimId] = 1;
+              A[dimId] = _source_grid_pos(img, res, p);
+              p[dimId] = 0;
+
+              for (unsigned int i = 0; i < nDims; ++i)
+              { A[dimId][i] -= b[i]; }
+          }
+
+          const unsigned int lineLength = res.size(lastDim);
+          const unsigned int numLines = numValues / lineLength;
+          const unsigned int numSlices = nDims > 1 ? res.size(0) : 1;
+          const unsigned int numLinesPerSlice = numLines / numSlices;
+
+          std::vector<double> srcMin(nDims);
+          std::vector<double> srcMax(nDims);
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              srcMin[dimId] = -0.5;
+              srcMax[dimId] = static_cast<double>(img.size(dimId)) - 0.5;
+          }
+
+          auto outside = img.template allocate_value<double>();
+          if constexpr (std::is_arithmetic_v<std::decay_t<decltype(outside)>>)
+          { outside = _constant_value; }
+          else
+          { outside.set_constant(_constant_value); }
+
+          const bool useConstant = _boundary_mode == ImageBoundaryMode::Constant;
+
+          // cubic B-spline coefficients are fetched once; a cache lookup per voxel would serialize the loop
+          constexpr bool isCubicBSpline = std::is_same_v<TInterpolator, CubicBSplineImageInterpolation>;
+          [[maybe_unused]] const auto coeff = [&]()
+          {
+              if constexpr (isCubicBSpline)
+              { return CubicBSplineImageInterpolation::coefficients(img); }
+              else
+              { return nullptr; }
+          }();
+
+          // detaches shared values and clears the cache once instead of per voxel
+          auto dst = res.span();
+
+          #ifdef BK_EMIT_PROGRESS
+          Progress& prog = bk_progress.emplace_task(numSlices, ___("Resampling image"));
+          #endif
+
+          #pragma omp parallel
+          {
+              std::vector<unsigned int> gid(nDims, 0);
+              std::vector<double> pos(nDims);
+
+              #pragma omp for
+              for (int sliceId = 0; sliceId < static_cast<int>(numSlices); ++sliceId)
+              {
+                  for (unsigned int l = 0; l < numLinesPerSlice; ++l)
+                  {
+                      // grid position of the line start (last coordinate 0)
+                      unsigned int lineId = static_cast<unsigned int>(sliceId) * numLinesPerSlice + l;
+
+                      for (int dimId = static_cast<int>(lastDim) - 1; dimId >= 0; --dimId)
+                      {
+                          gid[dimId] = lineId % res.size(dimId);
+                          lineId /= res.size(dimId);
+                      }
+
+                      // one matrix-vector product per line
+                      pos = b;
+                      for (unsigned int dimId = 0; dimId < lastDim; ++dimId)
+                      {
+                          for (unsigned int i = 0; i < nDims; ++i)
+                          { pos[i] += gid[dimId] * A[dimId][i]; }
+                      }
+
+                      const std::vector<double>& step = A[lastDim];
+                      unsigned int lid = (static_cast<unsigned int>(sliceId) * numLinesPerSlice + l) * lineLength;
+
+                      for (unsigned int x = 0; x < lineLength; ++x, ++lid)
+                      {
+                          bool isInside = true;
+
+                          if (useConstant)
+                          {
+                              for (unsigned int i = 0; i < nDims; ++i)
+                              {
+                                  if (!(pos[i] >= srcMin[i] && pos[i] <= srcMax[i])) // also catches NaN
+                                  {
+                                      isInside = false;
+                                      break;
+                                  }
+                              }
+                          }
+
+                          if (!isInside)
+                          { dst[lid] = outside; }
+                          else if constexpr (isCubicBSpline)
+                          { dst[lid] = interp(img, pos, coeff->data()); }
+                          else
+                          { dst[lid] = interp(img, pos); }
+
+                          for (unsigned int i = 0; i < nDims; ++i)
+                          { pos[i] += step[i]; }
+                      } // for x
+                  } // for l
+
+                  #ifdef BK_EMIT_PROGRESS
+                  #pragma omp critical (resample_progress)
+                  { prog.increment(1); }
+                  #endif
+              } // for sliceId
+          } // omp parallel
+
+          res.invalidate_cache();
+
+          #ifdef BK_EMIT_PROGRESS
+          prog.set_finished();
+          #endif
+      }
+
+      //! resamples img onto a grid of the given size and transformation (of the image's transformation type)
+      template<typename TImage, typename TIndexAccessible, typename TTransformation, typename TInterpolator = LinearImageInterpolation>
+      [[nodiscard]] TImage apply(const TImage& img, const TIndexAccessible& size, const TTransformation& transformation, TInterpolator interp = TInterpolator()) const
+      {
+          TImage res;
+          res.set_size(size);
+          res.geometry().transformation() = transformation;
+
+          apply(img, res, interp);
+
+          return res;
+      }
+      /// @}
+  }; // class ResampleImageFilter
+} // namespace bk
+
+#endif //BK_RESAMPLEIMAGEFILTER_H
@@ -0,0 +1,238 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkDataset/image/filter/StructuringElement.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <utility>
+
+namespace bk
+{
+  namespace
+  {
+    //! offsets of all positions in [offMin, offMax] (per dimension) for which pred(off) is true
+    template<typename TPredicate>
+    std::vector<int> enumerate_offsets(const std::vector<int>& offMin, const std::vector<int>& offMax, TPredicate pred)
+    {
+        const unsigned int nDims = static_cast<unsigned int>(offMin.size());
+        std::vector<int> offsets;
+        std::vector<int> off(offMin);
+
+        for (bool done = nDims == 0; !done;)
+        {
+            if (pred(off))
+            { offsets.insert(offsets.end(), off.begin(), off.end()); }
+
+            // increment grid pos (last dimension first)
+            done = true;
+
+            for (int d = static_cast<int>(nDims) - 1; d >= 0; --d)
+            {
+                if (++off[d] <= offMax[d])
+                {
+                    done = false;
+                    break;
+                }
+
+                off[d] = offMin[d];
+            }
+        }
+
+        return offsets;
+    }
+  } // anonymous namespace
+
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  StructuringElement::StructuringElement()
+      : _shape(StructuringElementShape::Custom),
+        _num_dimensions(0)
+  { /* do nothing */ }
+
+  StructuringElement::StructuringElement(const self_type& other) = default;
+  StructuringElement::StructuringElement(self_type&& other) noexcept = default;
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  StructuringElement::~StructuringElement() = default;
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET SHAPE
+  StructuringElementShape StructuringElement::shape() const
+  { return _shape; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET NUM DIMENSIONS
+  unsigned int StructuringElement::num_dimensions() const
+  { return _num_dimensions; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET NUM ELEMENTS
+  unsigned int StructuringElement::num_elements() const
+  { return _num_dimensions != 0 ? static_cast<unsigned int>(_offsets.size()) / _num_dimensions : 0; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET OFFSETS
+  const std::vector<int>& StructuringElement::offsets() const
+  { return _offsets; }
+
+  int StructuringElement::offset(unsigned int k, unsigned int dimId) const
+  { return dimId < _num_dimensions ? _offsets[k * _num_dimensions + dimId] : 0; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET EXTENT
+  int StructuringElement::offset_min(unsigned int dimId) const
+  { return dimId < _num_dimensions ? _offset_min[dimId] : 0; }
+
+  int StructuringElement::offset_max(unsigned int dimId) const
+  { return dimId < _num_dimensions ? _offset_max[dimId] : 0; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET RADIUS
+  unsigned int StructuringElement::radius() const
+  {
+      int r = 0;
+
+      for (unsigned int d = 0; d < _num_dimensions; ++d)
+      { r = std::max({r, -_offset_min[d], _offset_max[d]}); }
+
+      return static_cast<unsigned int>(r);
+  }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto StructuringElement::operator=(const self_type& other) -> self_type& = default;
+  auto StructuringElement::operator=(self_type&& other) noexcept -> self_type& = default;
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- MAKE
+  auto StructuringElement::make_box(const std::vector<unsigned int>& size) -> self_type
+  {
+      self_type se;
+      se._shape = StructuringElementShape::Box;
+      se._num_dimensions = static_cast<unsigned int>(size.size());
+      se._offset_min.resize(se._num_dimensions);
+      se._offset_max.resize(se._num_dimensions);
+
+      for (unsigned int d = 0; d < se._num_dimensions; ++d)
+      {
+          const int k = std::max(1, static_cast<int>(size[d]));
+          se._offset_min[d] = -(k >> 1); // integer division
+          se._offset_max[d] = k - 1 + se._offset_min[d];
+      }
+
+      se._offsets = enumerate_offsets(se._offset_min, se._offset_max, [](const std::vector<int>&)
+      { return true; });
+
+      return se;
+  }
+
+  auto StructuringElement::make_cross(unsigned int nDims, unsigned int radius) -> self_type
+  {
+      self_type se;
+      se._shape = StructuringElementShape::Cross;
+      se._num_dimensions = nDims;
+      se._offset_min.assign(nDims, -static_cast<int>(radius));
+      se._offset_max.assign(nDims, static_cast<int>(radius));
+      se._offsets = enumerate_offsets(se._offset_min, se._offset_max, [](const std::vector<int>& off)
+      { return std::count(off.begin(), off.end(), 0) + 1 >= static_cast<std::ptrdiff_t>(off.size()); });
+
+      return se;
+  }
+
+  auto StructuringElement::make_diamond(unsigned int nDims, unsigned int radius) -> self_type
+  {
+      self_type se;
+      se._shape = StructuringElementShape::Diamond;
+      se._num_dimensions = nDims;
+      se._offset_min.assign(nDims, -static_cast<int>(radius));
+      se._offset_max.assign(nDims, static_cast<int>(radius));
+      se._offsets = enumerate_offsets(se._offset_min, se._offset_max, [&](const std::vector<int>& off)
+      {
+          unsigned int l1 = 0;
+
+          for (int x: off)
+          { l1 += static_cast<unsigned int>(std::abs(x)); }
+
+          return l1 <= radius;
+      });
+
+      return se;
+  }
+
+  auto StructuringElement::make_ball(unsigned int nDims, unsigned int radius) -> self_type
+  {
+      self_type se;
+      se._shape = StructuringElementShape::Ball;
+      se._num_dimensions = nDims;
+      se._offset_min.assign(nDims, -static_cast<int>(radius));
+      se._offset_max.assign(nDims, static_cast<int>(radius));
+      se._offsets = enumerate_offsets(se._offset_min, se._offset_max, [&](const std::vector<int>& off)
+      {
+          unsigned int l2sq = 0;
+
+          for (int x: off)
+          { l2sq += static_cast<unsigned int>(x * x); }
+
+          return l2sq <= radius * radius;
+      });
+
+      return se;
+  }
+
+  auto StructuringElement::make_from_offsets(unsigned int nDims, std::vector<int> offsets) -> self_type
+  {
+      assert(nDims != 0 && offsets.size() % nDims == 0 && "offsets must contain nDims values per element");
+
+      self_type se;
+      se._shape = StructuringElementShape::Custom;
+      se._num_dimensions = nDims;
+      se._offset_min.assign(nDims, 0);
+      se._offset_max.assign(nDims, 0);
+      se._offsets = std::move(offsets);
+
+      for (unsigned int i = 0; i < se._offsets.size(); ++i)
+      {
+          const unsigned int d = i % nDims;
+          se._offset_min[d] = std::min(se._offset_min[d], se._offsets[i]);
+          se._offset_max[d] = std::max(se._offset_max[d], se._offsets[i]);
+      }
+
+      return se;
+  }
+  /// @}
+} // namespace bk
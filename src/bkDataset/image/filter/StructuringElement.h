@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_STRUCTURINGELEMENT_H
+#define BK_STRUCTURINGELEMENT_H
+
+#include <vector>
+
+#include <bkDataset/image/filter/EStructuringElementShape.h>
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! morphological structuring element as a list of grid offsets relative to the center
+  /*!
+   * - the shape is kept so that morphology can use a cheaper decomposition than the generic
+   *   per-voxel gather (see MorphologicalOperationImageFilter)
+   * - box offsets follow the kernel convention of ImageNeighborhood: size k covers [-(k/2), k-1-(k/2)]
+   * - offsets of dimensions >= num_dimensions() are treated as 0
+   */
+  class BKDATASET_EXPORT StructuringElement
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = StructuringElement;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      StructuringElementShape _shape;
+      unsigned int _num_dimensions;
+      std::vector<int> _offset_min; // per dimension; <= 0
+      std::vector<int> _offset_max; // per dimension; >= 0
+      std::vector<int> _offsets; // num_dimensions() grid offsets per element
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      StructuringElement();
+      StructuringElement(const self_type& other);
+      StructuringElement(self_type&& other) noexcept;
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~StructuringElement();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET SHAPE
+      [[nodiscard]] StructuringElementShape shape() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET NUM DIMENSIONS
+      [[nodiscard]] unsigned int num_dimensions() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET NUM ELEMENTS
+      [[nodiscard]] unsigned int num_elements() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET OFFSETS
+      //! num_dimensions() grid offsets per element
+      [[nodiscard]] const std::vector<int>& offsets() const;
+
+      //! grid offset of element k in dimension dimId (0 if dimId >= num_dimensions())
+      [[nodiscard]] int offset(unsigned int k, unsigned int dimId) const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET EXTENT
+      //! smallest offset in dimension dimId (0 if dimId >= num_dimensions())
+      [[nodiscard]] int offset_min(unsigned int dimId) const;
+      //! largest offset in dimension dimId (0 if dimId >= num_dimensions())
+      [[nodiscard]] int offset_max(unsigned int dimId) const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET RADIUS
+      //! radius of cross/diamond/ball elements; largest absolute offset otherwise
+      [[nodiscard]] unsigned int radius() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type& other) -> self_type&;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- MAKE
+      [[nodiscard]] static self_type make_box(const std::vector<unsigned int>& size);
+      [[nodiscard]] static self_type make_cross(unsigned int nDims, unsigned int radius);
+      [[nodiscard]] static self_type make_diamond(unsigned int nDims, unsigned int radius);
+      [[nodiscard]] static self_type make_ball(unsigned int nDims, unsigned int radius);
+
+      //! offsets: nDims grid offsets per element
+      [[nodiscard]] static self_type make_from_offsets(unsigned int nDims, std::vector<int> offsets);
+      /// @}
+  }; // class StructuringElement
+} // namespace bk
+
+#endif //BK_STRUCTURINGELEMENT_H
@@ -0,0 +1,176 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_VANHERKGILWERMAN_H
+#define BK_VANHERKGILWERMAN_H
+
+#include <algorithm>
+#include <vector>
+
+namespace bk::details
+{
+  /*
+   * Running minimum / maximum over rectangular windows (van Herk / Gil-Werman).
+   *
+   * - a line is split into blocks of the window width w; per block, prefix and suffix extrema
+   *   are computed, and every window is covered by the suffix of one block and the prefix of
+   *   the next one, i.e. ~3 comparisons per value independent of w
+   * - box kernels are separable, so N-D filters run the 1D pass once per dimension
+   * - windows are clipped at the image border (same result as ImageBoundaryMode::Skip); this is
+   *   implemented by padding with the border value, which is part of every clipped window
+   * - TCompare selects the result: std::less -> minimum, std::greater -> maximum
+   */
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- LINE
+  //! out[x] = extremum of in[x + offMin, ..., x + offMax] (clipped to [0, n)); offMin <= 0 <= offMax
+  /*!
+   * ext, g, h are scratch buffers that are resized to n + offMax - offMin (reuse them between calls).
+   * in and out may be the same.
+   */
+  template<typename T, typename TCompare>
+  void van_herk_gil_werman_line(const T* in, T* out, int n, int offMin, int offMax, TCompare comp, std::vector<T>& ext, std::vector<T>& g, std::vector<T>& h)
+  {
+      const int w = offMax - offMin + 1;
+
+      if (w <= 1 || n <= 0)
+      {
+          if (in != out)
+          { std::copy(in, in + std::max(n, 0), out); }
+
+          return;
+      }
+
+      const auto pick = [&](const T& a, const T& b) -> const T&
+      { return comp(b, a) ? b : a; };
+
+      const int m = n + w - 1;
+      ext.resize(m);
+      g.resize(m);
+      h.resize(m);
+
+      // ext[j] corresponds to position j + offMin
+      for (int j = 0; j < m; ++j)
+      { ext[j] = in[std::clamp(j + offMin, 0, n - 1)]; }
+
+      for (int blockStart = 0; blockStart < m; blockStart += w)
+      {
+          const int blockEnd = std::min(blockStart + w, m);
+
+          g[blockStart] = ext[blockStart];
+          for (int j = blockStart + 1; j < blockEnd; ++j)
+          { g[j] = pick(g[j - 1], ext[j]); }
+
+          h[blockEnd - 1] = ext[blockEnd - 1];
+          for (int j = blockEnd - 2; j >= blockStart; --j)
+          { h[j] = pick(h[j + 1], ext[j]); }
+      }
+
+      for (int x = 0; x < n; ++x)
+      { out[x] = pick(h[x], g[x + w - 1]); }
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- IMAGE
+  //! separable running extremum over the box [offMin[d], offMax[d]] per dimension; lines are processed in parallel
+  /*!
+   * Lines along strided dimensions are copied to a contiguous buffer, filtered, and written back.
+   * Missing dimensions are treated as [0, 0].
+   */
+  template<typename TImage, typename TCompare>
+  void van_herk_gil_werman(TImage& img, const std::vector<int>& offMin, const std::vector<int>& offMax, TCompare comp)
+  {
+      using value_type = typename TImage::value_type;
+
+      const unsigned int nDims = img.num_dimensions();
+      const auto& size = img.size();
+
+      unsigned int stride = img.num_values();
+
+      for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+      {
+          const unsigned int n = size[dimId];
+          stride /= n;
+
+          const int a = dimId < offMin.size() ? std::min(0, offMin[dimId]) : 0;
+          const int b = dimId < offMax.size() ? std::max(0, offMax[dimId]) : 0;
+
+          if (a == b || n <= 1)
+          { continue; }
+
+          const unsigned int numLines = img.num_values() / n;
+
+          #pragma omp parallel
+          {
+              std::vector<value_type> line(n);
+              std::vector<value_type> ext;
+              std::vector<value_type> g;
+              std::vector<value_type> h;
+
+              #pragma omp for
+              for (unsigned int lineId = 0; lineId < numLines; ++lineId)
+              {
+                  const unsigned int first = (lineId / stride) * stride * n + (lineId % stride);
+
+                  for (unsigned int i = 0; i < n; ++i)
+                  { line[i] = img[first + i * stride]; }
+
+                  van_herk_gil_werman_line(line.data(), line.data(), static_cast<int>(n), a, b, comp, ext, g, h);
+
+                  for (unsigned int i = 0; i < n; ++i)
+                  { img[first + i * stride] = line[i]; }
+              } // for lineId
+          } // omp parallel
+      } // for dimId
+  }
+
+  //! separable running extremum with a box kernel (kernel convention of ImageNeighborhood)
+  /*!
+   * Missing kernel dimensions are treated as size 1.
+   */
+  template<typename TImage, typename TKernelSize, typename TCompare>
+  void van_herk_gil_werman(TImage& img, const TKernelSize& kernel_size, TCompare comp)
+  {
+      const unsigned int numKernelDims = static_cast<unsigned int>(kernel_size.size());
+
+      std::vector<int> offMin(numKernelDims, 0);
+      std::vector<int> offMax(numKernelDims, 0);
+
+      for (unsigned int dimId = 0; dimId < numKernelDims; ++dimId)
+      {
+          const int ks = std::max(1, static_cast<int>(kernel_size[dimId]));
+          offMin[dimId] = -(ks >> 1); // integer division
+          offMax[dimId] = ks - 1 + offMin[dimId];
+      }
+
+      van_herk_gil_werman(img, offMin, offMax, comp);
+  }
+  /// @}
+} // namespace bk::details
+
+#endif //BK_VANHERKGILWERMAN_H
@@ -0,0 +1,345 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BK_CUBICBSPLINEIMAGEINTERPOLATION_H
+#define BK_CUBICBSPLINEIMAGEINTERPOLATION_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <bkTools/ndcontainer/Span.h>
+#include <bkTools/string_utils/string_utils.h>
+#include <bkTypeTraits/has_index_operator.h>
+
+#include <bkDataset/lib/bkDataset_export.h>
+
+namespace bk
+{
+  //! cubic B-spline interpolation (Unser et al.)
+  /*!
+   * - the spline interpolates the image values exactly at the grid positions
+   * - requires a coefficient image that is obtained by a separable recursive prefilter;
+   *   it is computed on first use and stored in the image's cache (see Image::cached()),
+   *   so subsequent interpolations only evaluate the fixed 4^N support
+   * - the cache is cleared by bulk modifications of the image (assignment, set_constant(), data(),
+   *   span(), non-const iterators, ...), but not by writing single values via operator[] / operator();
+   *   call img.invalidate_cache() after such writes, otherwise stale coefficients are used
+   * - mirrored boundary conditions
+   */
+  class BKDATASET_EXPORT CubicBSplineImageInterpolation
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+    public:
+      //! upper limit for the number of dimensions of images with run-time dimensionality
+      static constexpr unsigned int MaxNumDimensions = 8;
+
+      //! key of the coefficient image in the image's cache
+      [[nodiscard]] static constexpr unsigned long long CacheKey()
+      { return string_utils::hash("CubicBSplineImageInterpolation::coefficients"); }
+
+      template<typename TImage>
+      using coefficient_type = std::decay_t<decltype(std::declval<const TImage&>().template allocate_value<double>())>;
+
+      template<typename TImage>
+      using coefficient_vector_type = std::vector<coefficient_type<TImage>>;
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER: FILTER LINE
+      //! in-place conversion of samples to cubic B-spline coefficients (mirrored boundaries)
+      template<typename T>
+      static void _prefilter_line(T* c, int n)
+      {
+          if (n < 2)
+          { return; }
+
+          constexpr double gain = 6;
+          const double z = std::sqrt(3.0) - 2;
+
+          for (int k = 0; k < n; ++k)
+          { c[k] *= gain; }
+
+          /*
+           * causal initialization: truncated sum with a horizon that makes the
+           * neglected terms smaller than the double precision
+           */
+          const int horizon = std::min(n, static_cast<int>(std::ceil(std::log(std::numeric_limits<double>::epsilon()) / std::log(std::abs(z)))));
+
+          T sum = c[0];
+          double zk = z;
+          for (int k = 1; k < horizon; ++k)
+          {
+              sum += c[k] * zk;
+              zk *= z;
+          }
+
+          if (horizon < n)
+          { c[0] = sum; }
+          else
+          {
+              // exact mirrored initialization
+              const double zn = std::pow(z, n - 1);
+              const double iz = 1.0 / z;
+              double z2n = zn * zn * iz;
+              double zk0 = z;
+
+              sum = c[0] + c[n - 1] * zn;
+              for (int k = 1; k < n - 1; ++k)
+              {
+                  sum += c[k] * (zk0 + z2n);
+                  zk0 *= z;
+                  z2n *= iz;
+              }
+
+              c[0] = sum * (1.0 / (1.0 - zn * zn));
+          }
+
+          // causal
+          for (int k = 1; k < n; ++k)
+          { c[k] += c[k - 1] * z; }
+
+          // anticausal
+          c[n - 1] = (c[n - 2] * z + c[n - 1]) * (z / (z * z - 1));
+          for (int k = n - 2; k >= 0; --k)
+          { c[k] = (c[k + 1] - c[k]) * z; }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- HELPER: INTERPOLATE
+      /*
+       * - TDims > 0: dimensionality known at compile time
+       * - TDims == 0: run-time dimensionality
+       * - per dimension, the 4 offsets (mirrored indices * stride) and weights are
+       *   determined once; the 4^N support is then a plain weighted sum
+       */
+      template<unsigned int TDims, typename TImage, typename TIndexAccessible, typename TCoefficient>
+      [[nodiscard]] static auto _interpolate(const TImage& img, const TIndexAccessible& grid_pos, const TCoefficient* coeff)
+      {
+          constexpr unsigned int N = TDims != 0 ? TDims : MaxNumDimensions;
+          const unsigned int nDims = TDims != 0 ? TDims : img.num_dimensions();
+          assert(nDims <= MaxNumDimensions && "too many dimensions");
+
+          std::array<std::array<double, 4>, N> w{};
+          std::array<std::array<unsigned int, 4>, N> off{};
+          unsigned int stride = 1;
+
+          for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
+          {
+              const int s = static_cast<int>(img.size(dimId));
+              const double x = std::clamp(static_cast<double>(grid_pos[dimId]), 0.0, static_cast<double>(s - 1));
+              const double xf = std::floor(x);
+              const double t = x - xf;
+              const double t2 = t * t;
+              const double t3 = t2 * t;
+              const double u = 1 - t;
+
+              w[dimId] = {u * u * u / 6, (4 - 6 * t2 + 3 * t3) / 6, (1 + 3 * t + 3 * t2 - 3 * t3) / 6, t3 / 6};
+
+              // periodic mirroring (period 2(s-1)) keeps the support inside the image, also for s < 4
+              const int i0 = static_cast<int>(xf) - 1;
+              const int period = 2 * (s - 1);
+              for (int k = 0; k < 4; ++k)
+              {
+                  int i = 0;
+
+                  if (s > 1)
+                  {
+                      i = std::abs(i0 + k) % period;
+
+                      if (i >= s)
+                      { i = period - i; }
+                  }
+
+                  off[dimId][k] = static_cast<unsigned int>(i) * stride;
+              }
+
+              stride *= static_cast<unsigned int>(s);
+          }
+
+          auto res = img.template allocate_value<double>();
+
+          unsigned int nSupport = 1;
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          { nSupport *= 4; }
+
+          for (unsigned int c = 0; c < nSupport; ++c)
+          {
+              double weight = 1.0;
+              unsigned int o = 0;
+              unsigned int digits = c;
+
+              for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+              {
+                  const unsigned int k = digits & 3U;
+                  digits >>= 2;
+
+                  weight *= w[dimId][k];
+                  o += off[dimId][k];
+              }
+
+              res += coeff[o] * weight;
+          }
+
+          return res;
+      }
+
+      template<typename TImage, typename TIndexAccessible, typename TCoefficient>
+      [[nodiscard]] static auto _interpolate_dispatch(const TImage& img, const TIndexAccessible& grid_pos, const TCoefficient* coeff)
+      {
+          constexpr unsigned int nDims = TImage::NumDimensionsAtCompileTime();
+
+          if constexpr (nDims != 0)
+          { return _interpolate<nDims>(img, grid_pos, coeff); }
+          else
+          {
+              switch (img.num_dimensions())
+              {
+                  case 2: return _interpolate<2>(img, grid_pos, coeff);
+                  case 3: return _interpolate<3>(img, grid_pos, coeff);
+                  case 4: return _interpolate<4>(img, grid_pos, coeff);
+                  default: return _interpolate<0>(img, grid_pos, coeff);
+              }
+          }
+      }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- PREFILTER
+      //! computes the B-spline coefficients of all image values
+      /*!
+       * Separable: the recursive filter is applied along each dimension; the lines of
+       * a dimension are independent and processed in parallel.
+       */
+      template<typename TImage>
+      [[nodiscard]] static coefficient_vector_type<TImage> prefilter(const TImage& img)
+      {
+          using coeff_type = coefficient_type<TImage>;
+
+          const auto values = img.span();
+          coefficient_vector_type<TImage> coeff(values.size(), img.template allocate_value<double>());
+
+          for (unsigned int i = 0; i < values.size(); ++i)
+          { coeff[i] += values[i]; }
+
+          const unsigned int nDims = img.num_dimensions();
+          const unsigned int numValues = static_cast<unsigned int>(coeff.size());
+
+          unsigned int stride = numValues;
+          for (unsigned int dimId = 0; dimId < nDims; ++dimId)
+          {
+              const unsigned int s = img.size(dimId);
+              stride /= s;
+
+              if (s < 2)
+              { continue; }
+
+              const int numLines = static_cast<int>(numValues / s);
+
+              #pragma omp parallel
+              {
+                  std::vector<coeff_type> line(s);
+
+                  #pragma omp for
+                  for (int lineId = 0; lineId < numLines; ++lineId)
+                  {
+                      const unsigned int outer = static_cast<unsigned int>(lineId) / stride;
+                      const unsigned int inner = static_cast<unsigned int>(lineId) % stride;
+                      coeff_type* first = coeff.data() + outer * stride * s + inner;
+
+                      for (unsigned int k = 0; k < s; ++k)
+                      { line[k] = first[k * stride]; }
+
+                      _prefilter_line(line.data(), static_cast<int>(s));
+
+                      for (unsigned int k = 0; k < s; ++k)
+                      { first[k * stride] = line[k]; }
+                  }
+              }
+          }
+
+          return coeff;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET COEFFICIENTS
+      //! cached coefficient image of img; computed on first request
+      template<typename TImage>
+      [[nodiscard]] static std::shared_ptr<const coefficient_vector_type<TImage>> coefficients(const TImage& img)
+      { return img.template cached<coefficient_vector_type<TImage>>(CacheKey(), [](const TImage& i) { return prefilter(i); }); }
+      /// @}
+
+      /// @{ -------------------------------------------------- INTERPOLATE
+      template<typename TImage, typename TIndexAccessible>
+      auto operator()(const TImage& img, TIndexAccessible&& grid_pos) const
+      {
+          using IndexAccessible = std::decay_t<TIndexAccessible>;
+          static_assert(bk::has_index_operator_v<IndexAccessible>, "grid_pos must provide operator[]");
+
+          const auto coeff = coefficients(img);
+          return _interpolate_dispatch(img, grid_pos, coeff->data());
+      }
+
+      //! interpolation with coefficients fetched once via coefficients(img); avoids the (locked) cache lookup per call in parallel loops
+      template<typename TImage, typename TIndexAccessible, typename TCoefficient>
+      auto operator()(const TImage& img, TIndexAccessible&& grid_pos, const TCoefficient* coeff) const
+      {
+          using IndexAccessible = std::decay_t<TIndexAccessible>;
+          static_assert(bk::has_index_operator_v<IndexAccessible>, "grid_pos must provide operator[]");
+
+          return _interpolate_dispatch(img, grid_pos, coeff);
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- INTERPOLATE BATCH
+      //! out[i] = interpolation at grid_pos[i]; the coefficients are fetched once, positions are processed in parallel
+      template<typename TImage, typename TPos, typename TOut>
+      void operator()(const TImage& img, Span<TPos> grid_pos, Span<TOut> out) const
+      {
+          assert(grid_pos.size() == out.size() && "size mismatch");
+
+          const auto coeff = coefficients(img);
+          const auto* c = coeff->data();
+          const int n = static_cast<int>(grid_pos.size());
+
+          #pragma omp parallel for
+          for (int i = 0; i < n; ++i)
+          { out[i] = static_cast<TOut>(_interpolate_dispatch(img, grid_pos[i], c)); }
+      }
+      /// @}
+  };
+} // namespace bk
+
+#endif //BK_CUBICBSPLINEIMAGEINTERPOLATION_H
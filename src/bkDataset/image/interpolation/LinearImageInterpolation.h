@@ -28,10 +28,12 @@
 #define BK_LINEARIMAGEINTERPOLATION_H
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
 #include <type_traits>
 
-#include <bkMath/functions/list_grid_id_conversion.h>
+#include <bkTools/ndcontainer/Span.h>
 #include <bkTypeTraits/has_index_operator.h>
 
 #include <bkDataset/lib/bkDataset_export.h>
@@ -40,51 +42,114 @@ namespace bk
 {
   class BKDATASET_EXPORT LinearImageInterpolation
   {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
     public:
-      template<typename TImage, typename TIndexAccessible>
-      constexpr auto operator()(const TImage& img, TIndexAccessible&& grid_pos) const
+      //! upper limit for the number of dimensions of images with run-time dimensionality
+      static constexpr unsigned int MaxNumDimensions = 8;
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER: INTERPOLATE
+      /*
+       * - TDims > 0: dimensionality known at compile time; loops are unrolled
+       * - TDims == 0: run-time dimensionality
+       * - the 2^N corners of the cell are addressed as base + sum of the strides of the set bits;
+       *   dimensions of size 1 have stride 0, so no special handling is required
+       */
+      template<unsigned int TDims, typename TImage, typename TIndexAccessible>
+      [[nodiscard]] static auto _interpolate(const TImage& img, const TIndexAccessible& grid_pos)
       {
-          using IndexAccessible = std::decay_t<TIndexAccessible>;
-          static_assert(bk::has_index_operator_v<IndexAccessible>, "grid_pos must provide operator[]");
+          constexpr unsigned int N = TDims != 0 ? TDims : MaxNumDimensions;
+          const unsigned int nDims = TDims != 0 ? TDims : img.num_dimensions();
+          assert(nDims <= MaxNumDimensions && "too many dimensions");
 
-          const IndexAccessible grid_pos_clamped = img.clamp_to_size(std::forward<TIndexAccessible>(grid_pos));
+          std::array<double, N> frac{};
+          std::array<unsigned int, N> step{};
+          unsigned int base = 0;
+          unsigned int stride = 1;
 
-          IndexAccessible min_grid_pos = grid_pos_clamped;
-          unsigned int dimId = 0;
-          for (auto& x: min_grid_pos)
+          for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
           {
-              x = std::floor(x);
-              assert(!std::signbit(x) && "grid_pos must not be negative");
-
-              x = std::min(static_cast<int>(x), static_cast<int>(img.size(dimId++) - 2));
+              const int s = static_cast<int>(img.size(dimId));
+              const double x = std::clamp(static_cast<double>(grid_pos[dimId]), 0.0, static_cast<double>(s - 1));
+              const int x0 = std::min(static_cast<int>(x), std::max(s - 2, 0));
+
+              frac[dimId] = x - x0;
+              step[dimId] = s > 1 ? stride : 0;
+              base += static_cast<unsigned int>(x0) * stride;
+              stride *= static_cast<unsigned int>(s);
           }
 
-          IndexAccessible max_grid_pos = min_grid_pos;
-          for (auto& x: max_grid_pos)
-          { x += 1; }
-
-          const unsigned int nDims = img.num_dimensions();
-          const auto cell = img.topology().cell(min_grid_pos);
+          const auto* values = img.span().data();
           auto res = img.template allocate_value<double>();
 
-          for (unsigned int pointId = 0; pointId < cell.size(); ++pointId)
+          const unsigned int nCorners = 1U << nDims;
+          for (unsigned int c = 0; c < nCorners; ++c)
           {
-              const auto gid_of_cell_point = bk::list_to_grid_id(img.size(), cell[pointId]);
               double weight = 1.0;
+              unsigned int off = base;
 
-              for (unsigned int dimId2 = 0; dimId2 < nDims; ++dimId2)
+              for (unsigned int dimId = 0; dimId < nDims; ++dimId)
               {
-                  if (gid_of_cell_point[dimId2] == min_grid_pos[dimId2])
-                  { weight *= static_cast<double>(max_grid_pos[dimId2]) - static_cast<double>(grid_pos_clamped[dimId2]); }
+                  if ((c >> dimId) & 1U)
+                  {
+                      weight *= frac[dimId];
+                      off += step[dimId];
+                  }
                   else
-                  { weight *= static_cast<double>(grid_pos_clamped[dimId2]) - static_cast<double>(min_grid_pos[dimId2]); }
-              } // for dimId2
+                  { weight *= 1.0 - frac[dimId]; }
+              }
 
-              res += img[cell[pointId]] * weight;
-          } // for pointId
+              res += values[off] * weight;
+          }
 
           return res;
       }
+      /// @}
+
+    public:
+      /// @{ -------------------------------------------------- INTERPOLATE
+      template<typename TImage, typename TIndexAccessible>
+      auto operator()(const TImage& img, TIndexAccessible&& grid_pos) const
+      {
+          using IndexAccessible = std::decay_t<TIndexAccessible>;
+          static_assert(bk::has_index_operator_v<IndexAccessible>, "grid_pos must provide operator[]");
+
+          constexpr unsigned int nDims = TImage::NumDimensionsAtCompileTime();
+
+          if constexpr (nDims != 0)
+          { return _interpolate<nDims>(img, grid_pos); }
+          else
+          {
+              switch (img.num_dimensions())
+              {
+                  case 2: return _interpolate<2>(img, grid_pos);
+                  case 3: return _interpolate<3>(img, grid_pos);
+                  case 4: return _interpolate<4>(img, grid_pos);
+                  default: return _interpolate<0>(img, grid_pos);
+              }
+          }
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- INTERPOLATE BATCH
+      //! out[i] = interpolation at grid_pos[i]; parallelized over the positions
+      template<typename TImage, typename TPos, typename TOut>
+      void operator()(const TImage& img, Span<TPos> grid_pos, Span<TOut> out) const
+      {
+          assert(grid_pos.size() == out.size() && "size mismatch");
+
+          const int n = static_cast<int>(grid_pos.size());
+
+          #pragma omp parallel for
+          for (int i = 0; i < n; ++i)
+          { out[i] = static_cast<TOut>(operator()(img, grid_pos[i])); }
+      }
+      /// @}
   };
 } // namespace bk
 
@@ -28,11 +28,12 @@
 #define BK_NEARESTNEIGHBORIMAGEINTERPOLATION_H
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <type_traits>
 
+#include <bkTools/ndcontainer/Span.h>
 #include <bkTypeTraits/has_index_operator.h>
-#include <bkMath/functions/list_grid_id_conversion.h>
 
 #include <bkDataset/lib/bkDataset_export.h>
 
@@ -40,21 +41,57 @@ namespace bk
 {
   class BKDATASET_EXPORT NearestNeighborImageInterpolation
   {
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+    private:
+      /// @{ -------------------------------------------------- HELPER: LIST ID
+      //! list id of the rounded and clamped grid position (TDims == 0: run-time dimensionality)
+      template<unsigned int TDims, typename TImage, typename TIndexAccessible>
+      [[nodiscard]] static unsigned int _list_id(const TImage& img, const TIndexAccessible& grid_pos)
+      {
+          const unsigned int nDims = TDims != 0 ? TDims : img.num_dimensions();
+
+          unsigned int lid = 0;
+          unsigned int stride = 1;
+
+          for (int dimId = static_cast<int>(nDims) - 1; dimId >= 0; --dimId)
+          {
+              const int s = static_cast<int>(img.size(dimId));
+              lid += static_cast<unsigned int>(std::clamp(static_cast<int>(std::round(grid_pos[dimId])), 0, s - 1)) * stride;
+              stride *= static_cast<unsigned int>(s);
+          }
+
+          return lid;
+      }
+      /// @}
+
     public:
+      /// @{ -------------------------------------------------- INTERPOLATE
       template<typename TImage, typename TIndexAccessible>
-      constexpr auto operator()(const TImage& img, TIndexAccessible&& grid_pos) const
+      auto operator()(const TImage& img, TIndexAccessible&& grid_pos) const
       {
           using IndexAccessible = std::decay_t<TIndexAccessible>;
           static_assert(bk::has_index_operator_v<IndexAccessible>, "grid_pos must provide operator[]");
 
-          IndexAccessible grid_pos_rounded_and_clamped = std::forward<TIndexAccessible>(grid_pos);
+          return img[_list_id<TImage::NumDimensionsAtCompileTime()>(img, grid_pos)];
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- INTERPOLATE BATCH
+      //! out[i] = nearest value to grid_pos[i]; parallelized over the positions
+      template<typename TImage, typename TPos, typename TOut>
+      void operator()(const TImage& img, Span<TPos> grid_pos, Span<TOut> out) const
+      {
+          assert(grid_pos.size() == out.size() && "size mismatch");
 
-          unsigned int dimId = 0;
-          for (auto& x: grid_pos_rounded_and_clamped)
-          { x = std::clamp(static_cast<int>(std::round(x)), 0, static_cast<int>(img.size(dimId++) - 1)); }
+          const int n = static_cast<int>(grid_pos.size());
 
-          return img(grid_pos_rounded_and_clamped);
+          #pragma omp parallel for
+          for (int i = 0; i < n; ++i)
+          { out[i] = static_cast<TOut>(img[_list_id<TImage::NumDimensionsAtCompileTime()>(img, grid_pos[i])]); }
       }
+      /// @}
   };
 } // namespace bk
 
@@ -204,14 +204,7 @@ namespace bk
 
           #pragma omp parallel for
           for (unsigned int pointId = 0; pointId < nPoints; ++pointId)
-          {
-              point_lcs[pointId].normalize_cols_internal();
-
-              #ifdef BK_EMIT_PROGRESS
-              #pragma omp critical
-              { prog.increment(1); }
-              #endif
-          }
+          { point_lcs[pointId].normalize_cols_internal(); }
 
           #ifdef BK_EMIT_PROGRESS
           prog.set_finished();
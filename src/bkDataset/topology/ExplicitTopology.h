@@ -31,7 +31,6 @@
 #include <cassert>
 #include <cstdint>
 #include <fstream>
-#include <map>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -60,8 +59,8 @@ namespace bk
       //====================================================================================================
     private:
       std::vector<cell_type> _cells;
-      std::map<unsigned int, std::vector<unsigned int>> _neighbors_of_point;
-      std::map<unsigned int, std::vector<unsigned int>> _cells_of_point;
+      std::vector<std::vector<unsigned int>> _neighbors_of_point; // indexed by point id
+      std::vector<std::vector<unsigned int>> _cells_of_point; // indexed by point id
       bool _up2date;
 
       //====================================================================================================
@@ -228,6 +227,19 @@ namespace bk
       //====================================================================================================
       /// @{ -------------------------------------------------- HELPERS: UPDATE NEIGHBORS OF POINTS
     private:
+      [[nodiscard]] unsigned int num_referenced_points() const
+      {
+          unsigned int n = 0;
+
+          for (const cell_type& c: _cells)
+          {
+              for (unsigned int pointId: c)
+              { n = std::max(n, pointId + 1); }
+          }
+
+          return n;
+      }
+
       void add_point_neighbor_ids_of_all_cells()
       {
           for (unsigned int cellId = 0; cellId < num_cells(); ++cellId)
@@ -237,14 +249,14 @@ namespace bk
 
               for (unsigned int pointId = 0; pointId < numPointIdsInCell; ++pointId)
               {
-                  auto it = _neighbors_of_point.insert(std::make_pair(c[pointId], std::vector<unsigned int>())).first;
+                  std::vector<unsigned int>& neighbors = _neighbors_of_point[c[pointId]];
 
                   for (unsigned int otherPointId = 0; otherPointId < numPointIdsInCell; ++otherPointId)
                   {
                       if (pointId == otherPointId)
                       { continue; }
 
-                      it->second.push_back(c[otherPointId]);
+                      neighbors.push_back(c[otherPointId]);
                   }
               }
           }
@@ -252,19 +264,20 @@ namespace bk
 
       void remove_duplicate_neighbor_ids()
       {
-          for (auto& pair: _neighbors_of_point)
-          { pair.second.erase(std::unique(pair.second.begin(), pair.second.end()), pair.second.end()); }
+          for (std::vector<unsigned int>& neighbors: _neighbors_of_point)
+          { neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end()); }
       }
 
       void sort_neighbor_ids_by_index()
       {
-          for (auto& pair: _neighbors_of_point)
-          { std::sort(pair.second.begin(), pair.second.end()); }
+          for (std::vector<unsigned int>& neighbors: _neighbors_of_point)
+          { std::sort(neighbors.begin(), neighbors.end()); }
       }
 
       void init_neighbors_of_points()
       {
           _neighbors_of_point.clear();
+          _neighbors_of_point.resize(num_referenced_points());
           add_point_neighbor_ids_of_all_cells();
           remove_duplicate_neighbor_ids();
       }
@@ -277,11 +290,9 @@ namespace bk
       {
           assert(_up2date && "call init() first");
 
-          auto it = _neighbors_of_point.find(pointId);
-
-          assert(it != _neighbors_of_point.end() && "invalid pointId");
+          assert(pointId < _neighbors_of_point.size() && "invalid pointId");
 
-          return it->second;
+          return _neighbors_of_point[pointId];
       }
       /// @}
 
@@ -296,8 +307,7 @@ namespace bk
 
               for (unsigned int pointId = 0; pointId < numPointIdsInCell; ++pointId)
               {
-                  auto it = _cells_of_point.insert(std::make_pair(c[pointId], std::vector<unsigned int>())).first;
-                  it->second.push_back(cellId);
+                  _cells_of_point[c[pointId]].push_back(cellId);
               }
           }
       }
@@ -305,10 +315,8 @@ namespace bk
       void init_cells_of_points()
       {
           _cells_of_point.clear();
-          add_cell_ids_of_all_points();
-
-          for (auto& pair: _cells_of_point)
-          { std::sort(pair.second.begin(), pair.second.end()); }
+          _cells_of_point.resize(num_referenced_points());
+          add_cell_ids_of_all_points(); // cell ids are added in ascending order
       }
 
     public:
@@ -319,11 +327,9 @@ namespace bk
       {
           assert(_up2date && "call init() first");
 
-          auto it = _cells_of_point.find(pointId);
-
-          assert(it != _cells_of_point.end() && "invalid pointId");
+          assert(pointId < _cells_of_point.size() && "invalid pointId");
 
-          return it->second;
+          return _cells_of_point[pointId];
       }
       /// @}
 
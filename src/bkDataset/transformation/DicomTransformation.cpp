@@ -24,6 +24,8 @@
 
 #include <bkDataset/transformation/DicomTransformation.h>
 
+#include <cstdint>
+
 namespace bk
 {
   //====================================================================================================
@@ -202,6 +204,62 @@ namespace bk
   }
   /// @}
 
+  //====================================================================================================
+  //===== I/O
+  //====================================================================================================
+  /// @{ -------------------------------------------------- SAVE
+  bool DicomTransformation::save(std::ofstream& file) const
+  {
+      if (!file.is_open() || !file.good())
+      { return false; }
+
+      const std::int16_t imageType = static_cast<std::int16_t>(_image_type);
+      file.write(reinterpret_cast<const char*>(&imageType), sizeof(std::int16_t));
+
+      for (unsigned int r = 0; r < 5; ++r)
+      {
+          for (unsigned int c = 0; c < 5; ++c)
+          {
+              const double dtemp = _world_matrix(r, c);
+              file.write(reinterpret_cast<const char*>(&dtemp), sizeof(double));
+          }
+      }
+
+      return file.good();
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- LOAD
+  bool DicomTransformation::load(std::ifstream& file)
+  {
+      if (!file.is_open() || !file.good())
+      { return false; }
+
+      std::int16_t imageType = 0;
+      file.read(reinterpret_cast<char*>(&imageType), sizeof(std::int16_t));
+
+      Mat5d w;
+
+      for (unsigned int r = 0; r < 5; ++r)
+      {
+          for (unsigned int c = 0; c < 5; ++c)
+          {
+              double dtemp = 0;
+              file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
+              w(r, c) = dtemp;
+          }
+      }
+
+      if (!file.good())
+      { return false; }
+
+      set_dicom_image_type(static_cast<DicomImageType>(imageType));
+      set_world_matrix(w);
+
+      return true;
+  }
+  /// @}
+
   //====================================================================================================
   //===== FUNCTIONS
   //====================================================================================================
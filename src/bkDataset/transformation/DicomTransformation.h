@@ -28,6 +28,7 @@
 #define BKDATASET_DICOMTRANSFORMATIONBASE_H
 
 #include <array>
+#include <fstream>
 #include <initializer_list>
 #include <type_traits>
 #include <utility>
@@ -139,6 +140,17 @@ namespace bk
       void set_temporal_resolution(double dt);
       /// @}
 
+      //====================================================================================================
+      //===== I/O
+      //====================================================================================================
+      /// @{ -------------------------------------------------- SAVE
+      [[maybe_unused]] bool save(std::ofstream& file) const;
+      /// @}
+
+      /// @{ -------------------------------------------------- LOAD
+      [[maybe_unused]] bool load(std::ifstream& file);
+      /// @}
+
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
@@ -27,6 +27,8 @@
 #ifndef BK_NOTRANSFORMATION_H
 #define BK_NOTRANSFORMATION_H
 
+#include <fstream>
+
 #include <bkDataset/transformation/TransformationBase.h>
 
 namespace bk
@@ -68,6 +70,19 @@ namespace bk
       constexpr self_type& operator=(self_type&&) noexcept = default;
       /// @}
 
+      //====================================================================================================
+      //===== I/O
+      //====================================================================================================
+      /// @{ -------------------------------------------------- SAVE
+      [[maybe_unused]] bool save(std::ofstream& file) const
+      { return file.is_open() && file.good(); }
+      /// @}
+
+      /// @{ -------------------------------------------------- LOAD
+      [[maybe_unused]] bool load(std::ifstream& file)
+      { return file.is_open() && file.good(); }
+      /// @}
+
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
@@ -30,6 +30,8 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <fstream>
 #include <vector>
 #include <type_traits>
 
@@ -152,6 +154,53 @@ namespace bk
       }
       /// @}
 
+      //====================================================================================================
+      //===== I/O
+      //====================================================================================================
+      /// @{ -------------------------------------------------- SAVE
+      [[maybe_unused]] bool save(std::ofstream& file) const
+      {
+          if (!file.is_open() || !file.good())
+          { return false; }
+
+          const std::uint32_t numDimensions = num_dimensions();
+          file.write(reinterpret_cast<const char*>(&numDimensions), sizeof(std::uint32_t));
+
+          for (std::uint32_t dimId = 0; dimId < numDimensions; ++dimId)
+          {
+              const double dtemp = _translations[dimId];
+              file.write(reinterpret_cast<const char*>(&dtemp), sizeof(double));
+          }
+
+          return file.good();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- LOAD
+      [[maybe_unused]] bool load(std::ifstream& file)
+      {
+          if (!file.is_open() || !file.good())
+          { return false; }
+
+          std::uint32_t numDimensions = 0;
+          file.read(reinterpret_cast<char*>(&numDimensions), sizeof(std::uint32_t));
+
+          if constexpr (TDims == -1)
+          { _translations.resize(numDimensions); }
+          else if (numDimensions != TDims)
+          { return false; }
+
+          for (std::uint32_t dimId = 0; dimId < numDimensions; ++dimId)
+          {
+              double dtemp = 0;
+              file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
+              _translations[dimId] = dtemp;
+          }
+
+          return file.good();
+      }
+      /// @}
+
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
@@ -27,6 +27,9 @@
 #ifndef BK_WORLDMATRIXTRANSFORMATION_H
 #define BK_WORLDMATRIXTRANSFORMATION_H
 
+#include <cstdint>
+#include <fstream>
+
 #include <bk/Matrix>
 
 #include <bkDataset/transformation/TransformationBase.h>
@@ -143,6 +146,68 @@ namespace bk
       }
       /// @}
 
+      //====================================================================================================
+      //===== I/O
+      //====================================================================================================
+      /// @{ -------------------------------------------------- SAVE
+      [[maybe_unused]] bool save(std::ofstream& file) const
+      {
+          if (!file.is_open() || !file.good())
+          { return false; }
+
+          const std::uint32_t N = _world_matrix.num_rows();
+          file.write(reinterpret_cast<const char*>(&N), sizeof(std::uint32_t));
+
+          for (std::uint32_t r = 0; r < N; ++r)
+          {
+              for (std::uint32_t c = 0; c < N; ++c)
+              {
+                  const double dtemp = _world_matrix(r, c);
+                  file.write(reinterpret_cast<const char*>(&dtemp), sizeof(double));
+              }
+          }
+
+          return file.good();
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- LOAD
+      [[maybe_unused]] bool load(std::ifstream& file)
+      {
+          if (!file.is_open() || !file.good())
+          { return false; }
+
+          std::uint32_t N = 0;
+          file.read(reinterpret_cast<char*>(&N), sizeof(std::uint32_t));
+
+          if (N < 2 || (TDims != -1 && N != static_cast<std::uint32_t>(WorldMatrixRowsCols())))
+          { return false; }
+
+          auto w = MatrixFactory::create<value_type, WorldMatrixRowsCols(), WorldMatrixRowsCols()>(N, N);
+
+          for (std::uint32_t r = 0; r < N; ++r)
+          {
+              for (std::uint32_t c = 0; c < N; ++c)
+              {
+                  double dtemp = 0;
+                  file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
+                  w(r, c) = dtemp;
+              }
+          }
+
+          if constexpr (TDims == -1)
+          {
+              _scale.set_size(N - 1, 1);
+              _translation.set_size(N - 1, 1);
+              _rot_shear_matrix.set_size(N - 1, N - 1);
+          }
+
+          set_world_matrix(w);
+
+          return file.good();
+      }
+      /// @}
+
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
@@ -1443,6 +1443,21 @@ namespace bk
                   hasHighBit = imgInfo.HighBit != -1;
               }
 
+              if (ds.FindDataElement(gdcm::Keywords::PixelRepresentation::GetTag()))
+              { imgInfo.PixelRepresentation = bk::string_utils::to_int(sf.ToString(ds.GetDataElement(gdcm::Keywords::PixelRepresentation::GetTag()))); }
+
+              // Rescale ("output units = m*SV + b")
+              if (ds.FindDataElement(gdcm::Keywords::RescaleSlope::GetTag()))
+              {
+                  const double slope = bk::string_utils::to_double(bk::string_utils::trim(sf.ToString(ds.GetDataElement(gdcm::Keywords::RescaleSlope::GetTag()))));
+
+                  if (slope != 0)
+                  { imgInfo.RescaleSlope = slope; }
+              }
+
+              if (ds.FindDataElement(gdcm::Keywords::RescaleIntercept::GetTag()))
+              { imgInfo.RescaleIntercept = bk::string_utils::to_double(bk::string_utils::trim(sf.ToString(ds.GetDataElement(gdcm::Keywords::RescaleIntercept::GetTag())))); }
+
               // ImageOrientation ("specifies the direction cosines of the first row and the first column with respect to the patient. These Attributes shall be provide as a pair.")
               if (imgInfo.ImageOrientationPatientX.norm() == 0 && imgInfo.ImageOrientationPatientY.norm() == 0 && ds.FindDataElement(gdcm::Keywords::ImageOrientationPatient::GetTag()))
               {
@@ -2099,24 +2114,26 @@ namespace bk
       return std::tuple<int, bool, bool, bool, bool>(N, has_x, has_y, has_z, has_t);
   }
 
-  void DicomDirImporter::_setup_image(const DicomImageInfos& imgInfo, std::unique_ptr<DicomImage<double, -1>>& img, bool /*has_x*/, bool /*has_y*/, bool has_z, bool has_t) const
+  template<typename TValue>
+  void DicomDirImporter::_setup_image(const DicomImageInfos& imgInfo, DicomImage<TValue, -1>& img, bool /*has_x*/, bool /*has_y*/, bool has_z, bool has_t) const
   {
-      img->geometry().transformation().set_world_matrix(imgInfo.worldMatrix);
+      img.set_rescale(imgInfo.RescaleSlope, imgInfo.RescaleIntercept);
+      img.geometry().transformation().set_world_matrix(imgInfo.worldMatrix);
 
       if (has_z)
       {
           if (has_t)
           {
               // 3d+t image
-              img->set_size(imgInfo.Columns, imgInfo.Rows, imgInfo.Slices, imgInfo.TemporalPositions);
-              img->geometry().transformation().set_dicom_image_type_3dt();
-              img->geometry().transformation().set_temporal_resolution(imgInfo.TemporalResolution);
+              img.set_size(imgInfo.Columns, imgInfo.Rows, imgInfo.Slices, imgInfo.TemporalPositions);
+              img.geometry().transformation().set_dicom_image_type_3dt();
+              img.geometry().transformation().set_temporal_resolution(imgInfo.TemporalResolution);
           }
           else
           {
               // 3d image
-              img->set_size(imgInfo.Columns, imgInfo.Rows, imgInfo.Slices);
-              img->geometry().transformation().set_dicom_image_type_3d();
+              img.set_size(imgInfo.Columns, imgInfo.Rows, imgInfo.Slices);
+              img.geometry().transformation().set_dicom_image_type_3d();
           }
       }
       else
@@ -2124,66 +2141,67 @@ namespace bk
           if (has_t)
           {
               // 2d+t image
-              img->set_size(imgInfo.Columns, imgInfo.Rows, imgInfo.TemporalPositions);
-              img->geometry().transformation().set_dicom_image_type_2dt();
-              img->geometry().transformation().set_temporal_resolution(imgInfo.TemporalResolution);
+              img.set_size(imgInfo.Columns, imgInfo.Rows, imgInfo.TemporalPositions);
+              img.geometry().transformation().set_dicom_image_type_2dt();
+              img.geometry().transformation().set_temporal_resolution(imgInfo.TemporalResolution);
           }
           else
           {
               // 2d image
-              img->set_size(imgInfo.Columns, imgInfo.Rows);
-              img->geometry().transformation().set_dicom_image_type_2d();
+              img.set_size(imgInfo.Columns, imgInfo.Rows);
+              img.geometry().transformation().set_dicom_image_type_2d();
           }
       }
   }
 
-  void DicomDirImporter::_set_image_val(std::unique_ptr<DicomImage<double, -1>>& img, unsigned int val, unsigned int nDim, bool has_x, bool has_y, bool has_z, bool has_t, unsigned int rowid, unsigned int colid, unsigned int slicePos, unsigned int temporalPos) const
+  template<typename TValue>
+  void DicomDirImporter::_set_image_val(DicomImage<TValue, -1>& img, TValue val, unsigned int nDim, bool has_x, bool has_y, bool has_z, bool has_t, unsigned int rowid, unsigned int colid, unsigned int slicePos, unsigned int temporalPos) const
   {
       switch (nDim)
       {
           case 1:
           {
               if (has_x)
-              { img->operator[](rowid) = val; }
+              { img.operator[](rowid) = val; }
               else if (has_y)
-              { img->operator[](colid) = val; }
+              { img.operator[](colid) = val; }
               else if (has_z)
-              { img->operator[](slicePos) = val; }
+              { img.operator[](slicePos) = val; }
               else if (has_t)
-              { img->operator[](temporalPos) = val; }
+              { img.operator[](temporalPos) = val; }
               break;
           }
           case 2:
           {
               if (has_x && has_y)
-              { img->operator()(rowid, colid) = val; }
+              { img.operator()(rowid, colid) = val; }
               else if (has_x && has_z)
-              { img->operator()(rowid, slicePos) = val; }
+              { img.operator()(rowid, slicePos) = val; }
               else if (has_x && has_t)
-              { img->operator()(rowid, temporalPos) = val; }
+              { img.operator()(rowid, temporalPos) = val; }
               else if (has_y && has_z)
-              { img->operator()(colid, slicePos) = val; }
+              { img.operator()(colid, slicePos) = val; }
               else if (has_y && has_t)
-              { img->operator()(colid, temporalPos) = val; }
+              { img.operator()(colid, temporalPos) = val; }
               else if (has_z && has_t)
-              { img->operator()(slicePos, temporalPos) = val; }
+              { img.operator()(slicePos, temporalPos) = val; }
               break;
           }
           case 3:
           {
               if (has_x && has_y && has_z)
-              { img->operator()(rowid, colid, slicePos) = val; }
+              { img.operator()(rowid, colid, slicePos) = val; }
               else if (has_x && has_y && has_t)
-              { img->operator()(rowid, colid, temporalPos) = val; }
+              { img.operator()(rowid, colid, temporalPos) = val; }
               else if (has_x && has_z && has_t)
-              { img->operator()(rowid, slicePos, temporalPos) = val; }
+              { img.operator()(rowid, slicePos, temporalPos) = val; }
               else if (has_y && has_z && has_t)
-              { img->operator()(colid, slicePos, temporalPos) = val; }
+              { img.operator()(colid, slicePos, temporalPos) = val; }
               break;
           }
           case 4:
           {
-              img->operator()(rowid, colid, slicePos, temporalPos) = val;
+              img.operator()(rowid, colid, slicePos, temporalPos) = val;
               break;
           }
       }
@@ -2227,26 +2245,53 @@ namespace bk
 
       return val;
   }
+
+  long long DicomDirImporter::_get_stored_value(unsigned int raw, const DicomImageInfos& imgInfo)
+  {
+      if (imgInfo.PixelRepresentation != 1 || imgInfo.BitsStored <= 0 || imgInfo.BitsStored >= 32)
+      { return static_cast<long long>(raw); }
+
+      // two's complement with BitsStored bits -> sign extension
+      const unsigned int mask = (1u << imgInfo.BitsStored) - 1u;
+      const unsigned int signBit = 1u << (imgInfo.BitsStored - 1);
+      const unsigned int v = raw & mask;
+
+      return (v & signBit) != 0 ? static_cast<long long>(v) - static_cast<long long>(mask) - 1 : static_cast<long long>(v);
+  }
   /// @}
 
   /// @{ -------------------------------------------------- READ DICOM IMAGE
   std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_slice_of_4d_image(unsigned int image_id, unsigned int z_id, unsigned int t_id) const
+  { return read_slice_of_4d_image_as<double>(image_id, z_id, t_id); }
+
+  std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_image(unsigned int id) const
+  { return read_image_as<double>(id); }
+
+  std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_image_block(unsigned int id, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom, unsigned int zto, unsigned int tfrom, unsigned int tto) const
+  { return read_image_block_as<double>(id, xfrom, xto, yfrom, yto, zfrom, zto, tfrom, tto); }
+  /// @}
+
+  /// @{ -------------------------------------------------- READ DICOM IMAGE AS
+  template<typename TValue>
+  std::unique_ptr<DicomImage<TValue, -1>> DicomDirImporter::read_slice_of_4d_image_as(unsigned int image_id, unsigned int z_id, unsigned int t_id) const
   {
       assert(image_id < _pdata->info.size());
       const DicomImageInfos& imgInfo = _pdata->info[image_id];
-      return read_image_block(image_id, 0, imgInfo.Columns - 1, 0, imgInfo.Rows - 1, z_id, z_id, t_id, t_id);
+      return read_image_block_as<TValue>(image_id, 0, imgInfo.Columns - 1, 0, imgInfo.Rows - 1, z_id, z_id, t_id, t_id);
   }
 
-  std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_image(unsigned int id) const
+  template<typename TValue>
+  std::unique_ptr<DicomImage<TValue, -1>> DicomDirImporter::read_image_as(unsigned int id) const
   {
       assert(id < _pdata->info.size());
       const DicomImageInfos& imgInfo = _pdata->info[id];
-      return read_image_block(id, 0, imgInfo.Columns - 1, 0, imgInfo.Rows - 1, 0, imgInfo.Slices - 1, 0, imgInfo.TemporalPositions - 1);
+      return read_image_block_as<TValue>(id, 0, imgInfo.Columns - 1, 0, imgInfo.Rows - 1, 0, imgInfo.Slices - 1, 0, imgInfo.TemporalPositions - 1);
   }
 
-  std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_image_block(unsigned int id, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom, unsigned int zto, unsigned int tfrom, unsigned int tto) const
+  template<typename TValue>
+  std::unique_ptr<DicomImage<TValue, -1>> DicomDirImporter::read_image_block_as(unsigned int id, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom, unsigned int zto, unsigned int tfrom, unsigned int tto) const
   {
-      std::unique_ptr<DicomImage<double, -1 >> img = std::make_unique<DicomImage<double, -1 >>();
+      std::unique_ptr<DicomImage<TValue, -1 >> img = std::make_unique<DicomImage<TValue, -1 >>();
 
       if (id >= _pdata->info.size())
       { return img; }
@@ -2266,7 +2311,7 @@ namespace bk
 
       nDim = nDimExpected;
 
-      _setup_image(imgInfo, img, has_x, has_y, has_z, has_t);
+      _setup_image(imgInfo, *img, has_x, has_y, has_z, has_t);
 
       const int nPixelsPerSlice = imgInfo.Rows * imgInfo.Columns;
       const int nBytesPerPixel = imgInfo.BitsAllocated / 8; // bit to byte
@@ -2325,8 +2370,8 @@ namespace bk
                   if (rowid >= xfrom && rowid <= xto && colid >= yfrom && colid <= yto)
                   {
                       const char* valdata = std::addressof(buffer[k * nBytesPerPixel]);
-                      unsigned int val = _get_value_from_raw_data(valdata, nBytesPerPixel, littleEndian, imgInfo);
-                      _set_image_val(img, val, nDim, has_x, has_y, has_z, has_t, rowid, colid, slicePos, temporalPos);
+                      const TValue val = static_cast<TValue>(_get_stored_value(_get_value_from_raw_data(valdata, nBytesPerPixel, littleEndian, imgInfo), imgInfo));
+                      _set_image_val(*img, val, nDim, has_x, has_y, has_z, has_t, rowid, colid, slicePos, temporalPos);
                   }
 
                   //++xid;
@@ -2342,8 +2387,7 @@ namespace bk
           }
 
           #ifdef BK_EMIT_PROGRESS
-              #pragma omp critical
-          { prog.increment(1); }
+          prog.increment(1);
           #endif
       }
 
@@ -2450,15 +2494,23 @@ namespace bk
   }
 
   std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_image_from_bytes(unsigned int id, const std::vector<char>& imgbytes) const
+  { return read_image_from_bytes_as<double>(id, imgbytes); }
+
+  std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_image_block_from_bytes(unsigned int id, const std::vector<char>& imgbytes, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom, unsigned int zto, unsigned int tfrom, unsigned int tto) const
+  { return read_image_block_from_bytes_as<double>(id, imgbytes, xfrom, xto, yfrom, yto, zfrom, zto, tfrom, tto); }
+
+  template<typename TValue>
+  std::unique_ptr<DicomImage<TValue, -1>> DicomDirImporter::read_image_from_bytes_as(unsigned int id, const std::vector<char>& imgbytes) const
   {
       assert(id < _pdata->info.size());
       const DicomImageInfos& imgInfo = _pdata->info[id];
-      return read_image_block_from_bytes(id, imgbytes, 0, imgInfo.Columns - 1, 0, imgInfo.Rows - 1, 0, imgInfo.Slices - 1, 0, imgInfo.TemporalPositions - 1);
+      return read_image_block_from_bytes_as<TValue>(id, imgbytes, 0, imgInfo.Columns - 1, 0, imgInfo.Rows - 1, 0, imgInfo.Slices - 1, 0, imgInfo.TemporalPositions - 1);
   }
 
-  std::unique_ptr<DicomImage<double, -1>> DicomDirImporter::read_image_block_from_bytes(unsigned int id, const std::vector<char>& imgbytes, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom, unsigned int zto, unsigned int tfrom, unsigned int tto) const
+  template<typename TValue>
+  std::unique_ptr<DicomImage<TValue, -1>> DicomDirImporter::read_image_block_from_bytes_as(unsigned int id, const std::vector<char>& imgbytes, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom, unsigned int zto, unsigned int tfrom, unsigned int tto) const
   {
-      std::unique_ptr<DicomImage<double, -1 >> img = std::make_unique<DicomImage<double, -1 >>();
+      std::unique_ptr<DicomImage<TValue, -1 >> img = std::make_unique<DicomImage<TValue, -1 >>();
 
       if (id >= _pdata->info.size() || imgbytes.empty())
       { return img; }
@@ -2481,7 +2533,7 @@ namespace bk
 
       nDim = nDimExpected;
 
-      _setup_image(imgInfo, img, has_x, has_y, has_z, has_t);
+      _setup_image(imgInfo, *img, has_x, has_y, has_z, has_t);
 
       const int nPixelsPerSlice = imgInfo.Rows * imgInfo.Columns;
       const int nBytesPerPixel = imgInfo.BitsAllocated / 8; // bit to byte
@@ -2524,8 +2576,8 @@ namespace bk
                   if (rowid >= xfrom && rowid <= xto && colid >= yfrom && colid <= yto)
                   {
                       const char* valdata = std::addressof(imgbytes[off + k * nBytesPerPixel]);
-                      unsigned int val = _get_value_from_raw_data(valdata, nBytesPerPixel, littleEndian, imgInfo);
-                      _set_image_val(img, val, nDim, has_x, has_y, has_z, has_t, rowid, colid, slicePos, temporalPos);
+                      const TValue val = static_cast<TValue>(_get_stored_value(_get_value_from_raw_data(valdata, nBytesPerPixel, littleEndian, imgInfo), imgInfo));
+                      _set_image_val(*img, val, nDim, has_x, has_y, has_z, has_t, rowid, colid, slicePos, temporalPos);
                   }
 
                   //++xid;
@@ -2541,8 +2593,7 @@ namespace bk
           }
 
           #ifdef BK_EMIT_PROGRESS
-              #pragma omp critical
-          { prog.increment(1); }
+          prog.increment(1);
           #endif
       }
 
@@ -2878,4 +2929,22 @@ namespace bk
       return bytes;
   }
   /// @}
+
+  //====================================================================================================
+  //===== EXPLICIT INSTANTIATION
+  //====================================================================================================
+  #define BK_DICOMDIRIMPORTER_INSTANTIATE_READ(T)\
+  template std::unique_ptr<DicomImage<T, -1>> DicomDirImporter::read_slice_of_4d_image_as<T>(unsigned int, unsigned int, unsigned int) const;\
+  template std::unique_ptr<DicomImage<T, -1>> DicomDirImporter::read_image_as<T>(unsigned int) const;\
+  template std::unique_ptr<DicomImage<T, -1>> DicomDirImporter::read_image_block_as<T>(unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int) const;\
+  template std::unique_ptr<DicomImage<T, -1>> DicomDirImporter::read_image_from_bytes_as<T>(unsigned int, const std::vector<char>&) const;\
+  template std::unique_ptr<DicomImage<T, -1>> DicomDirImporter::read_image_block_from_bytes_as<T>(unsigned int, const std::vector<char>&, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int) const;
+
+  BK_DICOMDIRIMPORTER_INSTANTIATE_READ(double)
+  BK_DICOMDIRIMPORTER_INSTANTIATE_READ(float)
+  BK_DICOMDIRIMPORTER_INSTANTIATE_READ(std::int16_t)
+  BK_DICOMDIRIMPORTER_INSTANTIATE_READ(std::uint16_t)
+  BK_DICOMDIRIMPORTER_INSTANTIATE_READ(Half)
+
+  #undef BK_DICOMDIRIMPORTER_INSTANTIATE_READ
 } // namespace bk
\ No newline at end of file
@@ -28,6 +28,7 @@
 #define BKDICOM_DICOMDIRIMPORTER_H
 
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <string_view>
@@ -42,6 +43,7 @@
 #include <bkDicom/lib/bkDicom_export.h>
 #include <bk/Matrix>
 #include <bk/BitVector>
+#include <bkMath/numeric/Half.h>
 
 namespace bk
 {
@@ -205,23 +207,52 @@ namespace bk
       [[nodiscard]] int _count_image_dimensions(const DicomImageInfos& imgInfo) const;
       void _check_from_to_dimenson(unsigned int& xfrom, unsigned int& xto, unsigned int& yfrom, unsigned int& yto, unsigned int& zfrom, unsigned int& zto, unsigned int& tfrom, unsigned int& tto) const;
       [[nodiscard]] std::tuple<int,bool,bool,bool,bool> _count_expected_image_dimensions(unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom, unsigned int zto, unsigned int tfrom, unsigned int tto) const;
-      void _setup_image(const DicomImageInfos& imgInfo, std::unique_ptr<DicomImage<double, -1>>& img, bool /*has_x*/, bool /*has_y*/, bool has_z, bool has_t) const;
-      void _set_image_val(std::unique_ptr<DicomImage<double, -1>>& img, unsigned int val, unsigned int nDim, bool has_x, bool has_y, bool has_z, bool has_t, unsigned int rowid, unsigned int colid, unsigned int slicePos, unsigned int temporalPos) const;
+      template<typename TValue>
+      void _setup_image(const DicomImageInfos& imgInfo, DicomImage<TValue, -1>& img, bool /*has_x*/, bool /*has_y*/, bool has_z, bool has_t) const;
+      template<typename TValue>
+      void _set_image_val(DicomImage<TValue, -1>& img, TValue val, unsigned int nDim, bool has_x, bool has_y, bool has_z, bool has_t, unsigned int rowid, unsigned int colid, unsigned int slicePos, unsigned int temporalPos) const;
       [[nodiscard]] unsigned int _get_value_from_raw_data(const char* valdata, int nBytesPerPixel, bool littleEndian, const DicomImageInfos& imgInfo) const;
+      //! two's complement sign extension from BitsStored bits if PixelRepresentation is 1; raw value otherwise
+      [[nodiscard]] static long long _get_stored_value(unsigned int raw, const DicomImageInfos& imgInfo);
     public:
       /// @}
 
       /// @{ -------------------------------------------------- READ DICOM IMAGE
+      /*!
+       * Same as read_*_as<double>. Signed pixel data (PixelRepresentation 1) is sign-extended
+       * from BitsStored bits, e.g., a CT value of -1000 is read as -1000 and no longer as the
+       * unsigned bit pattern 64536. Image infos loaded from files saved without the pixel
+       * representation (see DicomImageInfos::load) are treated as unsigned.
+       */
       [[nodiscard]] std::unique_ptr <DicomImage<double, -1>> read_slice_of_4d_image(unsigned int image_id, unsigned int z_id, unsigned int t_id) const;
       [[nodiscard]] std::unique_ptr <DicomImage<double, -1>> read_image(unsigned int id) const;
       [[nodiscard]] std::unique_ptr <DicomImage<double, -1>> read_image_block(unsigned int id, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom = 0, unsigned int zto = 0, unsigned int tfrom = 0, unsigned int tto = 0) const;
       /// @}
 
+      /// @{ -------------------------------------------------- READ DICOM IMAGE AS
+      //! TValue: double, float, std::int16_t, std::uint16_t or Half
+      /*!
+       * The stored values are kept (signed if PixelRepresentation is 1). The DICOM rescale
+       * slope/intercept is attached as meta data (see Image::rescale_slope()), so compact
+       * types such as std::int16_t need 2 bytes per voxel instead of 8.
+       */
+      template<typename TValue>
+      [[nodiscard]] std::unique_ptr <DicomImage<TValue, -1>> read_slice_of_4d_image_as(unsigned int image_id, unsigned int z_id, unsigned int t_id) const;
+      template<typename TValue>
+      [[nodiscard]] std::unique_ptr <DicomImage<TValue, -1>> read_image_as(unsigned int id) const;
+      template<typename TValue>
+      [[nodiscard]] std::unique_ptr <DicomImage<TValue, -1>> read_image_block_as(unsigned int id, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom = 0, unsigned int zto = 0, unsigned int tfrom = 0, unsigned int tto = 0) const;
+      /// @}
+
       /// @{ -------------------------------------------------- READ DICOM IMAGE BYTES
       [[nodiscard]] std::vector<char> read_image_bytes(unsigned int id) const;
       [[nodiscard]] std::vector<char> read_image_block_bytes(unsigned int id, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom = 0, unsigned int zto = 0, unsigned int tfrom = 0, unsigned int tto = 0) const;
       [[nodiscard]] std::unique_ptr <DicomImage<double, -1>> read_image_from_bytes(unsigned int id, const std::vector<char>& imgbytes) const;
       [[nodiscard]] std::unique_ptr <DicomImage<double, -1>> read_image_block_from_bytes(unsigned int id, const std::vector<char>& imgbytes, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom = 0, unsigned int zto = 0, unsigned int tfrom = 0, unsigned int tto = 0) const;
+      template<typename TValue>
+      [[nodiscard]] std::unique_ptr <DicomImage<TValue, -1>> read_image_from_bytes_as(unsigned int id, const std::vector<char>& imgbytes) const;
+      template<typename TValue>
+      [[nodiscard]] std::unique_ptr <DicomImage<TValue, -1>> read_image_block_from_bytes_as(unsigned int id, const std::vector<char>& imgbytes, unsigned int xfrom, unsigned int xto, unsigned int yfrom, unsigned int yto, unsigned int zfrom = 0, unsigned int zto = 0, unsigned int tfrom = 0, unsigned int tto = 0) const;
       /// @}
 
       //====================================================================================================
@@ -31,6 +31,20 @@
 
 namespace bk
 {
+  namespace
+  {
+    /*
+     * saved blocks start with tag, magic and format version; blocks without this header were written
+     * before the format was versioned (version 0). An old block cannot start with tag and magic,
+     * because id_file_end is never below id_file_start (and file ids are < 0xFFFF)
+     *
+     * version 1: + PixelRepresentation, RescaleSlope, RescaleIntercept
+     */
+    constexpr std::uint16_t DicomImageInfosTag = 0xFFFF;
+    constexpr std::uint16_t DicomImageInfosMagic = 0xD1CF;
+    constexpr std::uint16_t DicomImageInfosVersion = 1;
+  } // anonymous namespace
+
   //====================================================================================================
   //===== CONSTRUCTORS & DESTRUCTOR
   //====================================================================================================
@@ -68,6 +82,9 @@ namespace bk
         BitsAllocated(0),
         BitsStored(0),
         HighBit(-1),
+        PixelRepresentation(0),
+        RescaleSlope(1),
+        RescaleIntercept(0),
         AcquisitionDate(""),
         InstitutionName(""),
         ImageOrientationPatientX(MatrixFactory::Zero_Vec_3D<double>()),
@@ -119,6 +136,9 @@ namespace bk
           file.write(reinterpret_cast<const char*>(&ui16temp), sizeof(std::uint16_t));
       };
 
+      _save_ui16(DicomImageInfosTag);
+      _save_ui16(DicomImageInfosMagic);
+      _save_ui16(DicomImageInfosVersion);
       _save_ui16(id_file_start);
       _save_ui16(id_file_end);
       _save_ui16(nDimensions);
@@ -159,6 +179,9 @@ namespace bk
       { file.write(reinterpret_cast<const char*>(&ImageOrientationPatientY[i]), sizeof(double)); }
       for (unsigned int i = 0; i < 16; ++i)
       { file.write(reinterpret_cast<const char*>(&worldMatrix[i]), sizeof(double)); }
+      _save_ui16(PixelRepresentation);
+      file.write(reinterpret_cast<const char*>(&RescaleSlope), sizeof(double));
+      file.write(reinterpret_cast<const char*>(&RescaleIntercept), sizeof(double));
   }
   /// @}
 
@@ -187,8 +210,17 @@ namespace bk
           return static_cast<int>(ui16temp);
       };
 
+      int version = 0;
       id_file_start = _load_ui16();
       id_file_end = _load_ui16();
+
+      if (id_file_start == DicomImageInfosTag && id_file_end == DicomImageInfosMagic)
+      {
+          version = _load_ui16();
+          id_file_start = _load_ui16();
+          id_file_end = _load_ui16();
+      }
+
       nDimensions = _load_ui16();
       Rows = _load_ui16();
       Columns = _load_ui16();
@@ -227,6 +259,19 @@ namespace bk
       { file.read(reinterpret_cast<char*>(&ImageOrientationPatientY[i]), sizeof(double)); }
       for (unsigned int i = 0; i < 16; ++i)
       { file.read(reinterpret_cast<char*>(&worldMatrix[i]), sizeof(double)); }
+
+      if (version >= 1)
+      {
+          PixelRepresentation = _load_ui16();
+          file.read(reinterpret_cast<char*>(&RescaleSlope), sizeof(double));
+          file.read(reinterpret_cast<char*>(&RescaleIntercept), sizeof(double));
+      }
+      else
+      {
+          PixelRepresentation = 0;
+          RescaleSlope = 1;
+          RescaleIntercept = 0;
+      }
   }
   /// @}
 } // namespace bk
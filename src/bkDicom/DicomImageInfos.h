@@ -77,6 +77,9 @@ namespace bk
       int BitsAllocated;
       int BitsStored;
       int HighBit;
+      int PixelRepresentation; // 0: unsigned, 1: signed (two's complement)
+      double RescaleSlope; // stored value -> output units: v * RescaleSlope + RescaleIntercept
+      double RescaleIntercept;
       std::string AcquisitionDate;
       std::string InstitutionName;
       Vec3d ImageOrientationPatientX;
@@ -113,6 +116,7 @@ namespace bk
       /// @}
 
       /// @{ -------------------------------------------------- LOAD
+      //! blocks saved before the format was versioned get the default pixel representation (unsigned) and rescale (1, 0)
       [[maybe_unused]] bool load(const std::string& filepath);
       void load(std::ifstream& file);
       /// @}
@@ -31,6 +31,8 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 #include <bkTypeTraits/has_num_elements_at_compile_time.h>
@@ -52,54 +54,41 @@ namespace bk
    */
   namespace
   {
-    template<typename TIndexAccessible0, typename TIndexAccessible1, typename TIndexAccessible2>
-    constexpr TIndexAccessible2 _list_to_grid_id(const TIndexAccessible0& size, unsigned int nDims, TIndexAccessible1&& temp, TIndexAccessible2&& gid, unsigned int lid)
+    //! no temporaries: the last dimension has stride 1, so the coordinates are the remainders of successive divisions
+    template<typename TIndexAccessible0, typename TIndexAccessible1>
+    constexpr TIndexAccessible1 _list_to_grid_id(const TIndexAccessible0& size, unsigned int nDims, TIndexAccessible1&& gid, unsigned int lid)
     {
         assert(nDims != 0);
 
-        for (unsigned int i = 0; i < nDims - 1; ++i)
-        {
-            temp[i] = 1;
-
-            for (unsigned int k = i + 1; k < nDims; ++k)
-            { temp[i] *= size[k]; }
-        }
-
-        for (unsigned int i = 0; i < nDims - 1; ++i)
+        for (unsigned int i = nDims - 1; i > 0; --i)
         {
-            gid[i] = lid;
-
-            for (unsigned int k = 0; k < i; ++k)
-            { gid[i] -= temp[k] * gid[k]; }
-
-            gid[i] /= temp[i] != 0 ? temp[i] : 1;
+            const unsigned int s = size[i] != 0 ? static_cast<unsigned int>(size[i]) : 1U;
+            gid[i] = lid % s;
+            lid /= s;
         }
 
-        gid[nDims - 1] = lid;
-        for (unsigned int i = 0; i < nDims - 1; ++i)
-        { gid[nDims - 1] -= temp[i] * gid[i]; }
+        gid[0] = lid;
 
-        return std::forward<TIndexAccessible2>(gid);
+        return std::forward<TIndexAccessible1>(gid);
     }
   } // anonymous namespace
 
   template<typename TRandomAccessIterator>
   constexpr auto list_to_grid_id(TRandomAccessIterator sizeIteratorFirst, TRandomAccessIterator sizeIteratorLast, unsigned int lid)
   {
-      const std::vector<unsigned int> size(sizeIteratorFirst, sizeIteratorLast);
-      const unsigned int nDims = size.size();
-      return _list_to_grid_id(size, nDims, std::vector<unsigned int>(nDims), std::vector<unsigned int>(nDims), lid);
+      const unsigned int nDims = static_cast<unsigned int>(std::distance(sizeIteratorFirst, sizeIteratorLast));
+      return _list_to_grid_id(sizeIteratorFirst, nDims, std::vector<unsigned int>(nDims), lid);
   }
 
   template<std::size_t N, typename T>
   constexpr std::array<unsigned int, N> list_to_grid_id(const std::array<T, N>& size, unsigned int lid)
-  { return _list_to_grid_id(size, N, std::array<unsigned int, N>(), std::array<unsigned int, N>(), lid); }
+  { return _list_to_grid_id(size, N, std::array<unsigned int, N>(), lid); }
 
   template<typename T>
   std::vector<unsigned int> list_to_grid_id(const std::vector<T>& size, unsigned int lid)
   {
       const unsigned int N = size.size();
-      return _list_to_grid_id(size, N, std::vector<unsigned int>(N), std::vector<unsigned int>(N), lid);
+      return _list_to_grid_id(size, N, std::vector<unsigned int>(N), lid);
   }
 
   template<typename T>
@@ -108,11 +97,16 @@ namespace bk
       if constexpr (has_num_elements_at_compile_time_v<T>)
       {
           constexpr int N = T::NumElementsAtCompileTime();
-          return _list_to_grid_id(size, N, std::array<unsigned int, N>(), std::array<unsigned int, N>(), lid);
+          return _list_to_grid_id(size, N, std::array<unsigned int, N>(), lid);
       }
       else
       { return list_to_grid_id(size.begin(), size.end(), lid); }
   }
+
+  //! writes into gid (e.g. a bk::InlineVector or std::array), which must have num_dimensions elements; does not allocate
+  template<typename TIndexAccessible0, typename TIndexAccessible1>
+  constexpr void list_to_grid_id_into(const TIndexAccessible0& size, unsigned int numDimensions, unsigned int lid, TIndexAccessible1& gid)
+  { _list_to_grid_id(size, numDimensions, gid, lid); }
   /// @}
 
   /// @{ -------------------------------------------------- GRID COORDINATES TO LIST ID
@@ -0,0 +1,245 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKMATH_HALF_H
+#define BKMATH_HALF_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace bk
+{
+  /*
+   * IEEE 754 binary16 ("half") storage type
+   *
+   * - 2 bytes per value; arithmetic is performed in float (implicit conversion)
+   * - float -> half rounds to nearest even; overflow becomes infinity
+   * - intended as compact value type of large images, e.g. Image<Half, 4>
+   */
+  class Half
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = Half;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      std::uint16_t _bits;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CONSTRUCTORS
+      constexpr Half() noexcept
+          : _bits(0)
+      { /* do nothing */ }
+
+      constexpr Half(const self_type&) noexcept = default;
+
+      template<typename T, std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+      Half(T x) noexcept
+          : _bits(float_to_bits(static_cast<float>(x)))
+      { /* do nothing */ }
+      /// @}
+
+      /// @{ -------------------------------------------------- DESTRUCTOR
+      ~Half() = default;
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET BITS
+      [[nodiscard]] constexpr std::uint16_t bits() const noexcept
+      { return _bits; }
+      /// @}
+
+      /// @{ -------------------------------------------------- CONVERSION
+      operator float() const noexcept
+      { return bits_to_float(_bits); }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] constexpr self_type& operator=(const self_type&) noexcept = default;
+      /// @}
+
+      /// @{ -------------------------------------------------- SET BITS
+      [[nodiscard]] static constexpr self_type from_bits(std::uint16_t bits) noexcept
+      {
+          self_type h;
+          h._bits = bits;
+          return h;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- MATH OPERATORS
+      [[maybe_unused]] self_type& operator+=(float x) noexcept
+      { return *this = self_type(static_cast<float>(*this) + x); }
+
+      [[maybe_unused]] self_type& operator-=(float x) noexcept
+      { return *this = self_type(static_cast<float>(*this) - x); }
+
+      [[maybe_unused]] self_type& operator*=(float x) noexcept
+      { return *this = self_type(static_cast<float>(*this) * x); }
+
+      [[maybe_unused]] self_type& operator/=(float x) noexcept
+      { return *this = self_type(static_cast<float>(*this) / x); }
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- CONVERSION HELPERS
+      [[nodiscard]] static std::uint16_t float_to_bits(float x) noexcept
+      {
+          std::uint32_t f = 0;
+          std::memcpy(&f, &x, sizeof(float));
+
+          const std::uint32_t sign = (f >> 16) & 0x8000u;
+          const std::uint32_t absf = f & 0x7FFFFFFFu;
+
+          if (absf >= 0x7F800000u) // inf or nan
+          { return static_cast<std::uint16_t>(sign | 0x7C00u | (absf > 0x7F800000u ? 0x0200u : 0u)); }
+
+          if (absf >= 0x477FF000u) // rounds to >= 65520 -> overflow
+          { return static_cast<std::uint16_t>(sign | 0x7C00u); }
+
+          if (absf < 0x38800000u) // subnormal half (or zero)
+          {
+              if (absf < 0x33000000u) // < 2^-25 -> zero
+              { return static_cast<std::uint16_t>(sign); }
+
+              const std::uint32_t e = absf >> 23;
+              const std::uint32_t m = (absf & 0x007FFFFFu) | 0x00800000u;
+              const std::uint32_t shift = 126u - e; // 14..24
+              std::uint32_t h = m >> shift;
+              const std::uint32_t rem = m & ((1u << shift) - 1u);
+              const std::uint32_t halfway = 1u << (shift - 1u);
+
+              if (rem > halfway || (rem == halfway && (h & 1u)))
+              { ++h; }
+
+              return static_cast<std::uint16_t>(sign | h);
+          }
+
+          // normal: rebias exponent (127 -> 15) and round mantissa to 10 bits (nearest even)
+          std::uint32_t h = ((absf - 0x38000000u) >> 13);
+          const std::uint32_t rem = absf & 0x1FFFu;
+
+          if (rem > 0x1000u || (rem == 0x1000u && (h & 1u)))
+          { ++h; }
+
+          return static_cast<std::uint16_t>(sign | h);
+      }
+
+      [[nodiscard]] static float bits_to_float(std::uint16_t h) noexcept
+      {
+          const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+          const std::uint32_t e = (h >> 10) & 0x1Fu;
+          std::uint32_t m = h & 0x3FFu;
+          std::uint32_t f = 0;
+
+          if (e == 0)
+          {
+              if (m == 0)
+              { f = sign; }
+              else // subnormal -> normalize
+              {
+                  std::uint32_t ef = 113; // 127 - 15 + 1
+
+                  while ((m & 0x400u) == 0)
+                  {
+                      m <<= 1;
+                      --ef;
+                  }
+
+                  f = sign | (ef << 23) | ((m & 0x3FFu) << 13);
+              }
+          }
+          else if (e == 0x1F)
+          { f = sign | 0x7F800000u | (m << 13); }
+          else
+          { f = sign | ((e + 112u) << 23) | (m << 13); }
+
+          float x = 0;
+          std::memcpy(&x, &f, sizeof(float));
+          return x;
+      }
+      /// @}
+  }; // class Half
+} // namespace bk
+
+namespace std
+{
+  template<> class numeric_limits<bk::Half> : public numeric_limits<float>
+  {
+    public:
+      static constexpr int digits = 11;
+      static constexpr int digits10 = 3;
+      static constexpr int max_digits10 = 5;
+      static constexpr int min_exponent = -13;
+      static constexpr int min_exponent10 = -4;
+      static constexpr int max_exponent = 16;
+      static constexpr int max_exponent10 = 4;
+
+      static constexpr bk::Half min() noexcept
+      { return bk::Half::from_bits(0x0400); }
+
+      static constexpr bk::Half lowest() noexcept
+      { return bk::Half::from_bits(0xFBFF); }
+
+      static constexpr bk::Half max() noexcept
+      { return bk::Half::from_bits(0x7BFF); }
+
+      static constexpr bk::Half epsilon() noexcept
+      { return bk::Half::from_bits(0x1400); }
+
+      static constexpr bk::Half round_error() noexcept
+      { return bk::Half::from_bits(0x3800); }
+
+      static constexpr bk::Half infinity() noexcept
+      { return bk::Half::from_bits(0x7C00); }
+
+      static constexpr bk::Half quiet_NaN() noexcept
+      { return bk::Half::from_bits(0x7E00); }
+
+      static constexpr bk::Half signaling_NaN() noexcept
+      { return bk::Half::from_bits(0x7D00); }
+
+      static constexpr bk::Half denorm_min() noexcept
+      { return bk::Half::from_bits(0x0001); }
+  };
+} // namespace std
+
+#endif //BKMATH_HALF_H
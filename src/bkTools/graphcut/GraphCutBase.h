@@ -412,8 +412,7 @@ namespace bk::gc_details
               _init_from_intensity_image<1>(img, img_scale, function_pixel_at, id, fn_scale, weight_function_tolerance);
 
               #ifdef BK_EMIT_PROGRESS
-              #pragma omp critical(gc_init_from_intensity_image)
-              { prog.increment(1); }
+              prog.increment(1);
               #endif
           }
 
@@ -472,8 +471,7 @@ namespace bk::gc_details
               _init_from_weight_image<1>(img, function_weight_at, id);
 
               #ifdef BK_EMIT_PROGRESS
-              #pragma omp critical(gc_init_from_weight_image)
-              { prog.increment(1); }
+              prog.increment(1);
               #endif
           }
 
@@ -594,8 +592,7 @@ namespace bk::gc_details
               _create_narrow_band<0>(_connected_to_source[i], band_radius, p);
 
               #ifdef BK_EMIT_PROGRESS
-                  #pragma omp critical
-              { prog.increment(1); }
+              prog.increment(1);
               #endif
           }
 
@@ -607,8 +604,7 @@ namespace bk::gc_details
               _sink_from_narrow_band<1>(p);
 
               #ifdef BK_EMIT_PROGRESS
-                  #pragma omp critical
-              { prog.increment(1); }
+              prog.increment(1);
               #endif
           }
 
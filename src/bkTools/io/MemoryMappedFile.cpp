@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bkTools/io/MemoryMappedFile.h>
+
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+    #define BK_MEMORYMAPPEDFILE_USE_MMAP
+
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+#endif
+
+namespace bk
+{
+  //====================================================================================================
+  //===== CONSTRUCTORS & DESTRUCTOR
+  //====================================================================================================
+  /// @{ -------------------------------------------------- CTOR
+  MemoryMappedFile::MemoryMappedFile()
+      : _filepath(""),
+        _data(nullptr),
+        _num_bytes(0),
+        _is_mapped(false)
+  { /* do nothing */ }
+
+  MemoryMappedFile::MemoryMappedFile(self_type&& other) noexcept
+      : _filepath(std::move(other._filepath)),
+        _data(other._data),
+        _num_bytes(other._num_bytes),
+        _is_mapped(other._is_mapped),
+        _buffer(std::move(other._buffer))
+  {
+      other._data = nullptr;
+      other._num_bytes = 0;
+      other._is_mapped = false;
+  }
+
+  MemoryMappedFile::MemoryMappedFile(std::string_view filepath)
+      : MemoryMappedFile()
+  { open(filepath); }
+  /// @}
+
+  /// @{ -------------------------------------------------- DTOR
+  MemoryMappedFile::~MemoryMappedFile()
+  { close(); }
+  /// @}
+
+  //====================================================================================================
+  //===== GETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- GET FILEPATH
+  const std::string& MemoryMappedFile::filepath() const
+  { return _filepath; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET DATA
+  const char* MemoryMappedFile::data() const
+  { return _data; }
+  /// @}
+
+  /// @{ -------------------------------------------------- GET SIZE
+  std::size_t MemoryMappedFile::size() const
+  { return _num_bytes; }
+  /// @}
+
+  /// @{ -------------------------------------------------- IS OPEN
+  bool MemoryMappedFile::is_open() const
+  { return _data != nullptr; }
+  /// @}
+
+  //====================================================================================================
+  //===== SETTER
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPERATOR =
+  auto MemoryMappedFile::operator=(self_type&& other) noexcept -> self_type&
+  {
+      if (this != &other)
+      {
+          close();
+
+          _filepath = std::move(other._filepath);
+          _data = other._data;
+          _num_bytes = other._num_bytes;
+          _is_mapped = other._is_mapped;
+          _buffer = std::move(other._buffer);
+
+          other._data = nullptr;
+          other._num_bytes = 0;
+          other._is_mapped = false;
+      }
+
+      return *this;
+  }
+  /// @}
+
+  //====================================================================================================
+  //===== FUNCTIONS
+  //====================================================================================================
+  /// @{ -------------------------------------------------- OPEN
+  bool MemoryMappedFile::open(std::string_view filepath)
+  {
+      close();
+
+      _filepath = filepath;
+
+      #ifdef BK_MEMORYMAPPEDFILE_USE_MMAP
+      const int fd = ::open(_filepath.c_str(), O_RDONLY);
+
+      if (fd == -1)
+      { return false; }
+
+      struct stat st;
+
+      if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+      {
+          ::close(fd);
+          return false;
+      }
+
+      void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd); // the mapping stays valid
+
+      if (p == MAP_FAILED)
+      { return false; }
+
+      _data = static_cast<const char*>(p);
+      _num_bytes = static_cast<std::size_t>(st.st_size);
+      _is_mapped = true;
+      #else
+      std::ifstream file(_filepath, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+
+      if (!file.is_open() || !file.good())
+      { return false; }
+
+      const std::streamsize n = file.tellg();
+
+      if (n <= 0)
+      { return false; }
+
+      _buffer.resize(static_cast<std::size_t>(n));
+      file.seekg(0, std::ios_base::beg);
+      file.read(_buffer.data(), n);
+
+      if (!file.good())
+      {
+          _buffer.clear();
+          return false;
+      }
+
+      _data = _buffer.data();
+      _num_bytes = _buffer.size();
+      #endif
+
+      return true;
+  }
+  /// @}
+
+  /// @{ -------------------------------------------------- CLOSE
+  void MemoryMappedFile::close()
+  {
+      #ifdef BK_MEMORYMAPPEDFILE_USE_MMAP
+      if (_is_mapped && _data != nullptr)
+      { ::munmap(const_cast<char*>(_data), _num_bytes); }
+      #endif
+
+      _data = nullptr;
+      _num_bytes = 0;
+      _is_mapped = false;
+      _buffer.clear();
+      _buffer.shrink_to_fit();
+  }
+  /// @}
+} // namespace bk
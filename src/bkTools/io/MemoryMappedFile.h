@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKTOOLS_MEMORYMAPPEDFILE_H
+#define BKTOOLS_MEMORYMAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <bkTools/lib/bkTools_export.h>
+
+namespace bk
+{
+  //! read-only memory mapping of a whole file
+  /*!
+   * - uses mmap on POSIX systems; the file contents are paged in lazily by the OS
+   * - on other systems the file is read into an internal buffer
+   */
+  class BKTOOLS_EXPORT MemoryMappedFile
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = MemoryMappedFile;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      std::string _filepath;
+      const char* _data;
+      std::size_t _num_bytes;
+      bool _is_mapped;
+      std::vector<char> _buffer; // fallback if mmap is not available
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      MemoryMappedFile();
+      MemoryMappedFile(const self_type&) = delete;
+      MemoryMappedFile(self_type&& other) noexcept;
+      explicit MemoryMappedFile(std::string_view filepath);
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~MemoryMappedFile();
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET FILEPATH
+      [[nodiscard]] const std::string& filepath() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET DATA
+      [[nodiscard]] const char* data() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SIZE
+      //! file size in bytes
+      [[nodiscard]] std::size_t size() const;
+      /// @}
+
+      /// @{ -------------------------------------------------- IS OPEN
+      [[nodiscard]] bool is_open() const;
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] auto operator=(const self_type&) -> self_type& = delete;
+      [[maybe_unused]] auto operator=(self_type&& other) noexcept -> self_type&;
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPEN
+      [[maybe_unused]] bool open(std::string_view filepath);
+      /// @}
+
+      /// @{ -------------------------------------------------- CLOSE
+      void close();
+      /// @}
+  }; // class MemoryMappedFile
+} // namespace bk
+
+#endif //BKTOOLS_MEMORYMAPPEDFILE_H
@@ -0,0 +1,155 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKTOOLS_ALLOCATIONCOUNTER_H
+#define BKTOOLS_ALLOCATIONCOUNTER_H
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace bk
+{
+  //! counts heap allocations of the program (e.g. to verify allocation-free per-voxel loops)
+  /*!
+   * Counting requires the replacement of the global operator new (all plain, array, nothrow and aligned
+   * overloads) and the matching operator delete. Since they must be defined exactly once per program,
+   * it is opt-in: place
+   *
+   *         BK_DEFINE_ALLOCATION_COUNTING_OPERATOR_NEW
+   *
+   * in a single translation unit of the executable (global scope). Without it, num_allocations() stays 0.
+   *
+   * Usage:
+   *         bk::AllocationCounter::reset();
+   *         // ... code under test ...
+   *         const auto n = bk::AllocationCounter::num_allocations();
+   */
+  class AllocationCounter
+  {
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+      [[nodiscard]] static std::atomic<unsigned long long>& _counter() noexcept
+      {
+          static std::atomic<unsigned long long> c{0};
+          return c;
+      }
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      AllocationCounter() = delete;
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET NUM ALLOCATIONS
+      //! since program start or the last reset()
+      [[nodiscard]] static unsigned long long num_allocations() noexcept
+      { return _counter().load(std::memory_order_relaxed); }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- RESET
+      static void reset() noexcept
+      { _counter().store(0, std::memory_order_relaxed); }
+      /// @}
+
+      //====================================================================================================
+      //===== FUNCTIONS
+      //====================================================================================================
+      /// @{ -------------------------------------------------- COUNT
+      //! called by the replaced operator new
+      static void count() noexcept
+      { _counter().fetch_add(1, std::memory_order_relaxed); }
+      /// @}
+  }; // class AllocationCounter
+} // namespace bk
+
+// operator delete calls std::free() on memory from the replaced operator new, which gcc cannot match
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+    #define BK_ALLOCATION_COUNTER_DIAGNOSTIC_PUSH _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wmismatched-new-delete\"")
+    #define BK_ALLOCATION_COUNTER_DIAGNOSTIC_POP _Pragma("GCC diagnostic pop")
+#else
+    #define BK_ALLOCATION_COUNTER_DIAGNOSTIC_PUSH
+    #define BK_ALLOCATION_COUNTER_DIAGNOSTIC_POP
+#endif
+
+namespace bk::details
+{
+  //! malloc/aligned_alloc for the replaced operator new; nullptr on failure
+  [[nodiscard]] inline void* counted_malloc(std::size_t n, std::size_t alignment = 0) noexcept
+  {
+      AllocationCounter::count();
+
+      if (n == 0)
+      { n = 1; }
+
+      if (alignment == 0)
+      { return std::malloc(n); }
+
+      // aligned_alloc requires a multiple of the alignment
+      return std::aligned_alloc(alignment, (n + alignment - 1) / alignment * alignment);
+  }
+
+  [[nodiscard]] inline void* counted_malloc_or_throw(std::size_t n, std::size_t alignment = 0)
+  {
+      if (void* p = counted_malloc(n, alignment))
+      { return p; }
+
+      throw std::bad_alloc();
+  }
+} // namespace bk::details
+
+#define BK_DEFINE_ALLOCATION_COUNTING_OPERATOR_NEW \
+    BK_ALLOCATION_COUNTER_DIAGNOSTIC_PUSH \
+    void* operator new(std::size_t n) { return bk::details::counted_malloc_or_throw(n); } \
+    void* operator new[](std::size_t n) { return bk::details::counted_malloc_or_throw(n); } \
+    void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return bk::details::counted_malloc(n); } \
+    void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return bk::details::counted_malloc(n); } \
+    void* operator new(std::size_t n, std::align_val_t a) { return bk::details::counted_malloc_or_throw(n, static_cast<std::size_t>(a)); } \
+    void* operator new[](std::size_t n, std::align_val_t a) { return bk::details::counted_malloc_or_throw(n, static_cast<std::size_t>(a)); } \
+    void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { return bk::details::counted_malloc(n, static_cast<std::size_t>(a)); } \
+    void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { return bk::details::counted_malloc(n, static_cast<std::size_t>(a)); } \
+    void operator delete(void* p) noexcept { std::free(p); } \
+    void operator delete[](void* p) noexcept { std::free(p); } \
+    void operator delete(void* p, std::size_t) noexcept { std::free(p); } \
+    void operator delete[](void* p, std::size_t) noexcept { std::free(p); } \
+    void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); } \
+    void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); } \
+    void operator delete(void* p, std::align_val_t) noexcept { std::free(p); } \
+    void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); } \
+    void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); } \
+    void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); } \
+    void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); } \
+    void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); } \
+    BK_ALLOCATION_COUNTER_DIAGNOSTIC_POP
+
+#endif //BKTOOLS_ALLOCATIONCOUNTER_H
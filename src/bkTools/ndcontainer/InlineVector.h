@@ -0,0 +1,209 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKTOOLS_INLINEVECTOR_H
+#define BKTOOLS_INLINEVECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <initializer_list>
+
+namespace bk
+{
+  //! vector with fixed capacity and run-time size that never allocates
+  /*!
+   * - storage is a std::array member (stack / inline in the owning object)
+   * - intended for small index vectors, e.g. grid coordinates of images with
+   *   run-time dimensionality, in per-voxel loops
+   */
+  template<typename TValue, unsigned int TCapacity = 8> class InlineVector
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = InlineVector<TValue, TCapacity>;
+    public:
+      using value_type = TValue;
+      using size_type = unsigned int;
+      using reference = TValue&;
+      using const_reference = const TValue&;
+      using iterator = TValue*;
+      using const_iterator = const TValue*;
+
+      [[nodiscard]] static constexpr unsigned int Capacity() noexcept
+      { return TCapacity; }
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      std::array<TValue, TCapacity> _data;
+      size_type _size;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      constexpr InlineVector() noexcept
+          : _data(),
+            _size(0)
+      { /* do nothing */ }
+
+      constexpr InlineVector(const self_type&) = default;
+      constexpr InlineVector(self_type&&) noexcept = default;
+
+      explicit constexpr InlineVector(size_type n, const value_type& x = value_type())
+          : _data(),
+            _size(n)
+      {
+          assert(n <= TCapacity && "capacity exceeded");
+          std::fill_n(_data.begin(), n, x);
+      }
+
+      constexpr InlineVector(std::initializer_list<value_type> values)
+          : _data(),
+            _size(static_cast<size_type>(values.size()))
+      {
+          assert(values.size() <= TCapacity && "capacity exceeded");
+          std::copy(values.begin(), values.end(), _data.begin());
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~InlineVector() = default;
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET SIZE
+      [[nodiscard]] constexpr size_type size() const noexcept
+      { return _size; }
+
+      [[nodiscard]] constexpr bool empty() const noexcept
+      { return _size == 0; }
+
+      [[nodiscard]] static constexpr size_type capacity() noexcept
+      { return TCapacity; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET DATA
+      [[nodiscard]] constexpr TValue* data() noexcept
+      { return _data.data(); }
+
+      [[nodiscard]] constexpr const TValue* data() const noexcept
+      { return _data.data(); }
+      /// @}
+
+      /// @{ -------------------------------------------------- OPERATOR[]
+      [[nodiscard]] constexpr reference operator[](size_type i)
+      {
+          assert(i < _size && "id out of bounds");
+          return _data[i];
+      }
+
+      [[nodiscard]] constexpr const_reference operator[](size_type i) const
+      {
+          assert(i < _size && "id out of bounds");
+          return _data[i];
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET FRONT / BACK
+      [[nodiscard]] constexpr reference front()
+      { return operator[](0); }
+
+      [[nodiscard]] constexpr const_reference front() const
+      { return operator[](0); }
+
+      [[nodiscard]] constexpr reference back()
+      { return operator[](_size - 1); }
+
+      [[nodiscard]] constexpr const_reference back() const
+      { return operator[](_size - 1); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET ITERATORS
+      [[nodiscard]] constexpr iterator begin() noexcept
+      { return _data.data(); }
+
+      [[nodiscard]] constexpr const_iterator begin() const noexcept
+      { return _data.data(); }
+
+      [[nodiscard]] constexpr iterator end() noexcept
+      { return _data.data() + _size; }
+
+      [[nodiscard]] constexpr const_iterator end() const noexcept
+      { return _data.data() + _size; }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] constexpr self_type& operator=(const self_type&) = default;
+      [[maybe_unused]] constexpr self_type& operator=(self_type&&) noexcept = default;
+      /// @}
+
+      /// @{ -------------------------------------------------- RESIZE
+      constexpr void resize(size_type n, const value_type& x = value_type())
+      {
+          assert(n <= TCapacity && "capacity exceeded");
+
+          if (n > _size)
+          { std::fill(_data.begin() + _size, _data.begin() + n, x); }
+
+          _size = n;
+      }
+
+      constexpr void clear() noexcept
+      { _size = 0; }
+      /// @}
+
+      /// @{ -------------------------------------------------- PUSH / POP
+      constexpr void push_back(const value_type& x)
+      {
+          assert(_size < TCapacity && "capacity exceeded");
+          _data[_size++] = x;
+      }
+
+      constexpr void pop_back()
+      {
+          assert(_size != 0 && "vector is empty");
+          --_size;
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- FILL
+      constexpr void fill(const value_type& x)
+      { std::fill(begin(), end(), x); }
+      /// @}
+  }; // class InlineVector
+} // namespace bk
+
+#endif //BKTOOLS_INLINEVECTOR_H
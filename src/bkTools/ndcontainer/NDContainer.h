@@ -29,8 +29,10 @@
 
 #include <type_traits>
 
+#include <bkTools/ndcontainer/InlineVector.h>
 #include <bkTools/ndcontainer/NDArray.h>
 #include <bkTools/ndcontainer/NDVector.h>
+#include <bkTools/ndcontainer/Span.h>
 
 namespace bk
 {
@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef BKTOOLS_SPAN_H
+#define BKTOOLS_SPAN_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace bk
+{
+  //! non-owning view on a contiguous block of values
+  /*!
+   * - lightweight stand-in for std::span (C++20)
+   * - the viewed memory must outlive the span
+   */
+  template<typename TValue> class Span
+  {
+      //====================================================================================================
+      //===== DEFINITIONS
+      //====================================================================================================
+      using self_type = Span<TValue>;
+    public:
+      using value_type = std::remove_cv_t<TValue>;
+      using element_type = TValue;
+      using size_type = std::size_t;
+      using reference = TValue&;
+      using pointer = TValue*;
+      using iterator = TValue*;
+
+      //====================================================================================================
+      //===== MEMBERS
+      //====================================================================================================
+    private:
+      pointer _data;
+      size_type _size;
+
+      //====================================================================================================
+      //===== CONSTRUCTORS & DESTRUCTOR
+      //====================================================================================================
+    public:
+      /// @{ -------------------------------------------------- CTOR
+      constexpr Span() noexcept
+          : Span(nullptr, 0)
+      { /* do nothing */ }
+
+      constexpr Span(const self_type&) noexcept = default;
+      constexpr Span(self_type&&) noexcept = default;
+
+      constexpr Span(pointer first, size_type count) noexcept
+          : _data(first),
+            _size(count)
+      { /* do nothing */ }
+
+      //! allow implicit Span<T> -> Span<const T>
+      template<typename TValue_, std::enable_if_t<std::is_convertible_v<TValue_(*)[], TValue(*)[]>>* = nullptr>
+      constexpr Span(const Span<TValue_>& other) noexcept
+          : _data(other.data()),
+            _size(other.size())
+      { /* do nothing */ }
+      /// @}
+
+      /// @{ -------------------------------------------------- DTOR
+      ~Span() = default;
+      /// @}
+
+      //====================================================================================================
+      //===== GETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- GET DATA
+      [[nodiscard]] constexpr pointer data() const noexcept
+      { return _data; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SIZE
+      [[nodiscard]] constexpr size_type size() const noexcept
+      { return _size; }
+
+      [[nodiscard]] constexpr bool empty() const noexcept
+      { return _size == 0; }
+      /// @}
+
+      /// @{ -------------------------------------------------- OPERATOR[]
+      [[nodiscard]] constexpr reference operator[](size_type i) const
+      {
+          assert(i < _size && "id out of bounds");
+          return _data[i];
+      }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET FRONT / BACK
+      [[nodiscard]] constexpr reference front() const
+      { return operator[](0); }
+
+      [[nodiscard]] constexpr reference back() const
+      { return operator[](_size - 1); }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET ITERATORS
+      [[nodiscard]] constexpr iterator begin() const noexcept
+      { return _data; }
+
+      [[nodiscard]] constexpr iterator end() const noexcept
+      { return _data + _size; }
+      /// @}
+
+      /// @{ -------------------------------------------------- GET SUBSPAN
+      [[nodiscard]] constexpr self_type subspan(size_type offset, size_type count) const
+      {
+          assert(offset + count <= _size && "subspan exceeds span");
+          return self_type(_data + offset, count);
+      }
+      /// @}
+
+      //====================================================================================================
+      //===== SETTER
+      //====================================================================================================
+      /// @{ -------------------------------------------------- OPERATOR =
+      [[maybe_unused]] constexpr self_type& operator=(const self_type&) noexcept = default;
+      [[maybe_unused]] constexpr self_type& operator=(self_type&&) noexcept = default;
+      /// @}
+  }; // class Span
+} // namespace bk
+
+#endif //BKTOOLS_SPAN_H
@@ -25,7 +25,11 @@
 #include <bkTools/progress/Progress.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
 
 #include <bk/Signal>
 
@@ -44,28 +48,98 @@ namespace bk
       }
 
     public:
+      //! increments are accumulated in per-thread slots (threads are hashed to slots) before they are added to current
+      static constexpr unsigned int NumPendingSlots = 16;
+
+      struct alignas(64) PendingSlot
+      { std::atomic<double> value{0.0}; };
+
+      [[nodiscard]] static long long now_ms() noexcept
+      { return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
       unsigned int id;
       std::string description;
       double max;
-      double current;
+      std::atomic<double> current;
+      std::array<PendingSlot, NumPendingSlots> pending;
       Signal<std::string> s_description_changed;
       Signal<double> s_max_changed;
       Signal<double> s_current_changed;
       Signal<unsigned int> s_finished;
+      // rate limit of s_current_changed for increments
+      double min_step;
+      unsigned int min_interval_ms;
+      std::atomic<double> last_emitted_current;
+      std::atomic<long long> last_emitted_time_ms;
+      // only one thread emits signals at a time
+      std::atomic_flag emitting = ATOMIC_FLAG_INIT;
+      std::atomic<bool> finished_emitted;
 
       Impl()
-          : id(_unique_id()),
-            description(""),
-            max(100),
-            current(0.0)
+          : Impl(100, "")
       { /* do nothing */ }
 
       Impl(double max_, std::string_view description_)
           : id(_unique_id()),
             description(description_),
             max(max_),
-            current(0.0)
+            current(0.0),
+            min_step(0.01),
+            min_interval_ms(40),
+            last_emitted_current(0.0),
+            last_emitted_time_ms(0),
+            finished_emitted(false)
       { /* do nothing */ }
+
+      void lock_emission() noexcept
+      {
+          while (emitting.test_and_set(std::memory_order_acquire))
+          { std::this_thread::yield(); }
+      }
+
+      [[nodiscard]] bool try_lock_emission() noexcept
+      { return !emitting.test_and_set(std::memory_order_acquire); }
+
+      void unlock_emission() noexcept
+      { emitting.clear(std::memory_order_release); }
+
+      [[nodiscard]] static double add(std::atomic<double>& x, double step) noexcept
+      {
+          // lock-free atomic add (std::atomic<double>::fetch_add requires C++20)
+          double c = x.load(std::memory_order_relaxed);
+          while (!x.compare_exchange_weak(c, c + step))
+          { /* retry; c was updated */ }
+
+          return c + step;
+      }
+
+      [[nodiscard]] PendingSlot& pending_slot_of_this_thread() noexcept
+      {
+          thread_local const unsigned int slotId = static_cast<unsigned int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % NumPendingSlots);
+          return pending[slotId];
+      }
+
+      [[nodiscard]] double sum_pending() const noexcept
+      {
+          double sum = 0;
+          for (const PendingSlot& p: pending)
+          { sum += p.value.load(std::memory_order_relaxed); }
+          return sum;
+      }
+
+      [[nodiscard]] double take_pending() noexcept
+      {
+          double sum = 0;
+          for (PendingSlot& p: pending)
+          { sum += p.value.exchange(0.0); }
+          return sum;
+      }
+
+      void discard_pending() noexcept
+      {
+          for (PendingSlot& p: pending)
+          { p.value.store(0.0); }
+      }
   };
 
   //====================================================================================================
@@ -109,7 +183,7 @@ namespace bk
 
   /// @{ -------------------------------------------------- GET CURRENT
   double Progress::current() const
-  { return _pdata->current; }
+  { return _pdata->current.load(std::memory_order_relaxed) + _pdata->sum_pending(); }
 
   Signal<double>& Progress::signal_current_changed()
   { return _pdata->s_current_changed; }
@@ -117,12 +191,20 @@ namespace bk
 
   /// @{ -------------------------------------------------- IS FINISHED
   bool Progress::finished() const
-  { return _pdata->current >= _pdata->max; }
+  { return current() >= _pdata->max; }
 
   Signal<unsigned int>& Progress::signal_finished()
   { return _pdata->s_finished; }
   /// @}
 
+  /// @{ -------------------------------------------------- GET SIGNAL RATE LIMIT
+  double Progress::signal_min_step() const
+  { return _pdata->min_step; }
+
+  unsigned int Progress::signal_min_interval_ms() const
+  { return _pdata->min_interval_ms; }
+  /// @}
+
   //====================================================================================================
   //===== SETTER
   //====================================================================================================
@@ -137,7 +219,9 @@ namespace bk
       _pdata->s_max_changed.emit_signal(_pdata->max);
 
       if (finished())
-      { _pdata->s_finished.emit_signal(_pdata->id); }
+      { _emit_current_and_finished(); }
+      else
+      { _pdata->finished_emitted.store(false); }
   }
   /// @}
 
@@ -146,11 +230,18 @@ namespace bk
   {
       if (!finished()) // already finished
       {
-          _pdata->current = c;
-          _pdata->s_current_changed.emit_signal(_pdata->current);
+          _pdata->discard_pending();
+          _pdata->current.store(c);
 
           if (finished())
-          { _pdata->s_finished.emit_signal(_pdata->id); }
+          { _emit_current_and_finished(); }
+          else
+          {
+              _pdata->lock_emission();
+              _pdata->last_emitted_current.store(c, std::memory_order_relaxed);
+              _pdata->s_current_changed.emit_signal(c);
+              _pdata->unlock_emission();
+          }
       }
   }
   /// @}
@@ -160,14 +251,21 @@ namespace bk
   {
       if (!finished())
       {
-          _pdata->current = _pdata->max;
-
-          _pdata->s_current_changed.emit_signal(_pdata->current);
-          _pdata->s_finished.emit_signal(_pdata->id);
+          _pdata->discard_pending();
+          _pdata->current.store(_pdata->max);
+          _emit_current_and_finished();
       }
   }
   /// @}
 
+  /// @{ -------------------------------------------------- SET SIGNAL RATE LIMIT
+  void Progress::set_signal_rate_limit(double minStep, unsigned int minIntervalMs)
+  {
+      _pdata->min_step = std::max(minStep, 0.0);
+      _pdata->min_interval_ms = minIntervalMs;
+  }
+  /// @}
+
   /// @{ -------------------------------------------------- ENABLE SIGNALS
   void Progress::set_signals_enabled(bool enable)
   {
@@ -188,9 +286,87 @@ namespace bk
   //====================================================================================================
   //===== FUNCTIONS
   //====================================================================================================
+  /// @{ -------------------------------------------------- HELPERS: EMIT SIGNALS
+  void Progress::_emit_current_rate_limited(double c)
+  {
+      if (c - _pdata->last_emitted_current.load(std::memory_order_relaxed) < _pdata->min_step * _pdata->max)
+      { return; }
+
+      // another thread is emitting -> skip; the next increment will catch up
+      if (!_pdata->try_lock_emission())
+      { return; }
+
+      const long long t = Impl::now_ms();
+
+      if (t - _pdata->last_emitted_time_ms.load(std::memory_order_relaxed) >= static_cast<long long>(_pdata->min_interval_ms))
+      {
+          _pdata->last_emitted_time_ms.store(t, std::memory_order_relaxed);
+          _pdata->last_emitted_current.store(c, std::memory_order_relaxed);
+          _pdata->s_current_changed.emit_signal(c);
+      }
+
+      _pdata->unlock_emission();
+  }
+
+  void Progress::_emit_current_and_finished()
+  {
+      // exactly once, even if several threads reach max concurrently
+      if (_pdata->finished_emitted.exchange(true))
+      { return; }
+
+      _pdata->lock_emission();
+      _pdata->last_emitted_current.store(_pdata->max, std::memory_order_relaxed);
+      _pdata->s_current_changed.emit_signal(_pdata->max);
+      _pdata->s_finished.emit_signal(_pdata->id);
+      _pdata->unlock_emission();
+  }
+  /// @}
+
   /// @{ -------------------------------------------------- INCREMENT
   void Progress::increment(double step)
-  { set_current(current() + step); }
+  {
+      /*
+       * - the shared counter is updated once per batch of a slot (batchSize), so that concurrent
+       *   increments do not contend on one atomic; the signals are not affected, since all
+       *   pending increments together are < min_step * max
+       * - near the end (maxPending to max), the pending increments of all slots are added
+       *   directly, so that reaching max is detected exactly
+       */
+      const double batchSize = _pdata->min_step * _pdata->max / Impl::NumPendingSlots;
+      const double maxPending = batchSize * Impl::NumPendingSlots;
+
+      if (_pdata->current.load(std::memory_order_relaxed) + maxPending < _pdata->max)
+      {
+          Impl::PendingSlot& slot = _pdata->pending_slot_of_this_thread();
+
+          if (Impl::add(slot.value, step) >= batchSize)
+          { step = slot.value.exchange(0.0); }
+          else if (_pdata->current.load() + maxPending < _pdata->max)
+          { return; }
+          else // another thread reached the end meanwhile; it may have missed this slot
+          { step = _pdata->take_pending(); }
+      }
+      else
+      { step += _pdata->take_pending(); }
+
+      const double c = Impl::add(_pdata->current, step);
+
+      if (c >= _pdata->max)
+      { _emit_current_and_finished(); }
+      else
+      { _emit_current_rate_limited(c); }
+  }
+
+  void Progress::increment_batched(double& accumulator, double step, double batchSize)
+  {
+      accumulator += step;
+
+      if (accumulator >= batchSize)
+      {
+          increment(accumulator);
+          accumulator = 0;
+      }
+  }
   /// @}
 
   /// @{ -------------------------------------------------- CLEAR SLOTS
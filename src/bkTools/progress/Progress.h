@@ -39,6 +39,15 @@ namespace bk
   template<typename... Args> class Signal;
   // -------------------- forward declaration END
 
+  //! progress of a task; current/finished signals are emitted to registered slots
+  /*!
+   * - increment() and increment_batched() are lock-free and may be called concurrently,
+   *   e.g. from within parallel loops (no omp critical required); increments are batched per
+   *   thread internally, so per-element increments do not contend on a shared counter
+   * - signal_current_changed() is rate-limited for increments: it is emitted at most once per
+   *   signal_min_step() (fraction of max; default 1%) and once per signal_min_interval_ms()
+   *   (default 40 ms); set_current(), set_finished() and reaching max always emit
+   */
   class BKTOOLS_EXPORT Progress
   {
       //====================================================================================================
@@ -94,6 +103,13 @@ namespace bk
       [[nodiscard]] Signal<unsigned int>& signal_finished();
       /// @}
 
+      /// @{ -------------------------------------------------- GET SIGNAL RATE LIMIT
+      //! minimum progress (fraction of max) between two emissions of signal_current_changed() by increments
+      [[nodiscard]] double signal_min_step() const;
+      //! minimum time between two emissions of signal_current_changed() by increments
+      [[nodiscard]] unsigned int signal_min_interval_ms() const;
+      /// @}
+
       //====================================================================================================
       //===== SETTER
       //====================================================================================================
@@ -114,6 +130,10 @@ namespace bk
       void set_finished();
       /// @}
 
+      /// @{ -------------------------------------------------- SET SIGNAL RATE LIMIT
+      void set_signal_rate_limit(double minStep, unsigned int minIntervalMs);
+      /// @}
+
       /// @{ -------------------------------------------------- ENABLE SIGNALS
       //! if disabled, no signals will be sent
       void set_signals_enabled(bool enable);
@@ -124,8 +144,25 @@ namespace bk
       //====================================================================================================
       //===== FUNCTIONS
       //====================================================================================================
+      /// @{ -------------------------------------------------- HELPERS: EMIT SIGNALS
+    private:
+      void _emit_current_rate_limited(double c);
+      void _emit_current_and_finished();
+    public:
+      /// @}
+
       /// @{ -------------------------------------------------- INCREMENT
+      //! thread-safe; batched per thread (pending increments are included in current())
       void increment(double step);
+
+      //! adds step to a thread-local accumulator; calls increment() once it reaches batchSize
+      /*!
+       * Use a local accumulator per thread (e.g. declared inside the omp parallel region)
+       * and flush the remainder via increment(accumulator) or set_finished() at the end.
+       * Not required for performance since increment() batches internally; saves the
+       * function call in very tight loops.
+       */
+      void increment_batched(double& accumulator, double step, double batchSize);
       /// @}
 
       /// @{ -------------------------------------------------- CLEAR SLOTS